@@ -0,0 +1,2254 @@
+#define GLFW_INCLUDE_VULKAN
+#define VK_NO_PROTOTYPES
+#include "config.h"
+#include <GLFW/glfw3.h>
+#include <vulkan/vulkan.h>
+#include <vulkan/vulkan.hpp>
+
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <optional>
+#include <set>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+// note
+#include <array>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <functional>
+#include <chrono>
+#include <unordered_map>
+
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback2(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer2: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+
+inline auto findExtensionProperties(const std::vector<VkExtensionProperties>& extensionProps, const char* name) {
+	for (auto& extensionProp : extensionProps) {
+		if (strcmp(extensionProp.extensionName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findLayerProperties(const std::vector<VkLayerProperties>& layerProps, const char* name) {
+	for (auto& layerProp : layerProps) {
+		if (strcmp(layerProp.layerName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findQueueFamilyIndices(const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			indices.push_back(i);
+		}
+	}
+	return indices;
+}
+inline auto findQueueFamilyIndices(
+	VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR,
+	const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			if (!surface) {
+				indices.push_back(i);
+			}
+			else {
+				VkBool32 presentSupport = false;
+				vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+				if (presentSupport) {
+					indices.push_back(i);
+				}
+			}
+		}
+	}
+	return indices;
+}
+
+struct SwapChainSupportDetails {
+	VkSurfaceCapabilitiesKHR        capabilities;
+	std::vector<VkSurfaceFormatKHR> formats;
+	std::vector<VkPresentModeKHR>   presentModes;
+};
+
+struct QueueFamilyIndices {
+	std::optional<uint32_t> graphicsFamily;
+	std::optional<uint32_t> presentFamily;
+
+	bool isComplete()
+	{
+		return graphicsFamily.has_value() && presentFamily.has_value();
+	}
+};
+
+// note
+// How a pass touches an image, stage and access masks use the 64-bit synchronization2 flags.
+struct RenderGraphAccess {
+	VkPipelineStageFlags2 stageMask;
+	VkAccessFlags2       accessMask;
+	VkImageLayout            layout;
+	bool                      write;
+};
+
+inline RenderGraphAccess colorAttachmentWrite() {
+	return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true };
+}
+inline RenderGraphAccess transferRead() {
+	return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, false };
+}
+inline RenderGraphAccess transferWrite() {
+	return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true };
+}
+
+// note
+// Transient images are owned by the graph and may share memory, imported images (the swap chain image)
+// are owned by the caller and bound again before every execution.
+struct RenderGraphImage {
+	std::string                          name;
+	VkFormat                           format = VK_FORMAT_UNDEFINED;
+	VkExtent2D                         extent = {};
+	VkImageUsageFlags                   usage = 0;
+	bool                             imported = false;
+	// imported only: the stage an external semaphore wait synchronizes with, and the layout handed back at the end
+	VkPipelineStageFlags2    importStageMask = VK_PIPELINE_STAGE_2_NONE;
+	VkImageLayout                 finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	VkImage                             image = nullptr;
+	VkImageView                          view = nullptr;
+	// filled in by compile
+	uint32_t                        firstPass = UINT32_MAX;
+	uint32_t                         lastPass = 0;
+	uint32_t                       memorySlot = UINT32_MAX;
+	VkMemoryRequirements    memoryRequirements = {};
+};
+
+struct RenderGraphBarrier {
+	uint32_t                imageIndex;
+	VkImageMemoryBarrier2      barrier;
+};
+
+struct RenderGraphPass {
+	std::string                                             name;
+	std::vector<std::pair<uint32_t, RenderGraphAccess>> accesses;
+	std::function<void(VkCommandBuffer)>                  record;
+	// filled in by compile, issued as one vkCmdPipelineBarrier2 in front of the pass
+	std::vector<RenderGraphBarrier>                     barriers;
+};
+
+// note
+// Transient images whose lifetimes never overlap are placed into the same slot, every image of a slot is bound at offset 0.
+struct RenderGraphMemorySlot {
+	VkDeviceSize               size = 0;
+	uint32_t         memoryTypeBits = ~0u;
+	std::vector<uint32_t>    images;
+	VkDeviceMemory           memory = nullptr;
+};
+
+// note
+// The frame is declared once: images first, then passes in execution order with the images they read and write.
+// compile derives lifetimes, memory aliasing and the barriers, execute only patches imported image handles.
+class RenderGraph {
+public:
+	std::vector<RenderGraphImage>          images;
+	std::vector<RenderGraphPass>           passes;
+	std::vector<RenderGraphMemorySlot> memorySlots;
+	std::vector<RenderGraphBarrier>  finalBarriers;
+
+	uint32_t createImage(const std::string& name, VkFormat format, VkExtent2D extent, VkImageUsageFlags usage) {
+		RenderGraphImage image;
+		image.name = name;
+		image.format = format;
+		image.extent = extent;
+		image.usage = usage;
+		images.push_back(image);
+		return static_cast<uint32_t>(images.size() - 1);
+	}
+
+	uint32_t importImage(const std::string& name, VkFormat format, VkExtent2D extent, VkPipelineStageFlags2 importStageMask, VkImageLayout finalLayout) {
+		RenderGraphImage image;
+		image.name = name;
+		image.format = format;
+		image.extent = extent;
+		image.imported = true;
+		image.importStageMask = importStageMask;
+		image.finalLayout = finalLayout;
+		images.push_back(image);
+		return static_cast<uint32_t>(images.size() - 1);
+	}
+
+	void addPass(const std::string& name, std::vector<std::pair<uint32_t, RenderGraphAccess>> accesses, std::function<void(VkCommandBuffer)> record) {
+		RenderGraphPass pass;
+		pass.name = name;
+		pass.accesses = std::move(accesses);
+		pass.record = std::move(record);
+		passes.push_back(std::move(pass));
+	}
+
+	void computeLifetimes() {
+		for (uint32_t passIndex = 0; passIndex < passes.size(); passIndex++) {
+			for (auto& [imageIndex, access] : passes[passIndex].accesses) {
+				images[imageIndex].firstPass = std::min(images[imageIndex].firstPass, passIndex);
+				images[imageIndex].lastPass = std::max(images[imageIndex].lastPass, passIndex);
+			}
+		}
+	}
+
+	// Greedy placement, largest images first. Needs lifetimes and memory requirements of the transient images.
+	void assignMemorySlots() {
+		std::vector<uint32_t> order;
+		for (uint32_t i = 0; i < images.size(); i++) {
+			if (!images[i].imported && images[i].firstPass != UINT32_MAX) {
+				order.push_back(i);
+			}
+		}
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			return images[a].memoryRequirements.size > images[b].memoryRequirements.size;
+		});
+
+		for (auto imageIndex : order) {
+			auto& image = images[imageIndex];
+			uint32_t bestSlot = UINT32_MAX;
+			VkDeviceSize bestGrowth = std::numeric_limits<VkDeviceSize>::max();
+			for (uint32_t slotIndex = 0; slotIndex < memorySlots.size(); slotIndex++) {
+				auto& slot = memorySlots[slotIndex];
+				if ((slot.memoryTypeBits & image.memoryRequirements.memoryTypeBits) == 0) {
+					continue;
+				}
+				bool overlaps = std::any_of(slot.images.begin(), slot.images.end(), [&](uint32_t other) {
+					return images[other].firstPass <= image.lastPass && image.firstPass <= images[other].lastPass;
+				});
+				if (overlaps) {
+					continue;
+				}
+				auto growth = image.memoryRequirements.size > slot.size ? image.memoryRequirements.size - slot.size : 0;
+				if (growth < bestGrowth) {
+					bestSlot = slotIndex;
+					bestGrowth = growth;
+				}
+			}
+			if (bestSlot == UINT32_MAX) {
+				memorySlots.emplace_back();
+				bestSlot = static_cast<uint32_t>(memorySlots.size() - 1);
+			}
+
+			auto& slot = memorySlots[bestSlot];
+			slot.size = std::max(slot.size, image.memoryRequirements.size);
+			slot.memoryTypeBits &= image.memoryRequirements.memoryTypeBits;
+			slot.images.push_back(imageIndex);
+			image.memorySlot = bestSlot;
+		}
+	}
+
+	// Walks every image through its accesses and emits a barrier only where a hazard or a layout change exists.
+	// The frame repeats on the same queue, so the first access of a transient image synchronizes with the last
+	// access to its memory, which is either the previous image in its slot or the previous frame.
+	void compileBarriers() {
+		struct ImageState {
+			VkImageLayout                 layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkPipelineStageFlags2     writeStage = VK_PIPELINE_STAGE_2_NONE;
+			VkAccessFlags2           writeAccess = VK_ACCESS_2_NONE;
+			// readers since the last write, and what the last write has been made visible to
+			VkPipelineStageFlags2     readStages = VK_PIPELINE_STAGE_2_NONE;
+			VkPipelineStageFlags2  visibleStages = VK_PIPELINE_STAGE_2_NONE;
+			VkAccessFlags2         visibleAccess = VK_ACCESS_2_NONE;
+		};
+		std::vector<ImageState> states(images.size());
+
+		for (auto& pass : passes) {
+			pass.barriers.clear();
+		}
+		finalBarriers.clear();
+
+		for (uint32_t passIndex = 0; passIndex < passes.size(); passIndex++) {
+			for (auto& [imageIndex, access] : passes[passIndex].accesses) {
+				auto& state = states[imageIndex];
+				if (passIndex == images[imageIndex].firstPass) {
+					// filled in below, once the last accesses of every image are known
+					state.layout = access.layout;
+				}
+				else {
+					VkImageMemoryBarrier2 barrier = makeBarrier(imageIndex);
+					bool needed = false;
+					if (state.layout != access.layout) {
+						// a layout transition is a read-modify-write, wait for everything since the last write
+						barrier.srcStageMask = state.writeStage | state.readStages;
+						barrier.srcAccessMask = state.writeAccess;
+						barrier.oldLayout = state.layout;
+						needed = true;
+					}
+					else if (access.write) {
+						// write after read only needs an execution dependency, write after write a memory dependency
+						barrier.srcStageMask = state.readStages != VK_PIPELINE_STAGE_2_NONE ? state.readStages : state.writeStage;
+						barrier.srcAccessMask = state.readStages != VK_PIPELINE_STAGE_2_NONE ? VK_ACCESS_2_NONE : state.writeAccess;
+						barrier.oldLayout = state.layout;
+						needed = true;
+					}
+					else if ((access.stageMask & ~state.visibleStages) != 0 || (access.accessMask & ~state.visibleAccess) != 0) {
+						barrier.srcStageMask = state.writeStage;
+						barrier.srcAccessMask = state.writeAccess;
+						barrier.oldLayout = state.layout;
+						needed = true;
+					}
+					if (needed) {
+						barrier.dstStageMask = access.stageMask;
+						barrier.dstAccessMask = access.accessMask;
+						barrier.newLayout = access.layout;
+						passes[passIndex].barriers.push_back({ imageIndex, barrier });
+						if (state.layout != access.layout) {
+							state.visibleStages = VK_PIPELINE_STAGE_2_NONE;
+							state.visibleAccess = VK_ACCESS_2_NONE;
+						}
+						state.visibleStages |= access.stageMask;
+						state.visibleAccess |= access.accessMask;
+					}
+					state.layout = access.layout;
+				}
+
+				if (access.write) {
+					state.writeStage = access.stageMask;
+					state.writeAccess = access.accessMask;
+					state.readStages = VK_PIPELINE_STAGE_2_NONE;
+					state.visibleStages = VK_PIPELINE_STAGE_2_NONE;
+					state.visibleAccess = VK_ACCESS_2_NONE;
+				}
+				else {
+					state.readStages |= access.stageMask;
+				}
+			}
+		}
+
+		for (uint32_t imageIndex = 0; imageIndex < images.size(); imageIndex++) {
+			auto& image = images[imageIndex];
+			if (image.firstPass == UINT32_MAX) {
+				continue;
+			}
+			const auto& firstAccess = findAccess(image.firstPass, imageIndex);
+
+			// previous contents are never needed, UNDEFINED lets the driver skip the transition
+			VkImageMemoryBarrier2 barrier = makeBarrier(imageIndex);
+			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			barrier.newLayout = firstAccess.layout;
+			barrier.dstStageMask = firstAccess.stageMask;
+			barrier.dstAccessMask = firstAccess.accessMask;
+			if (image.imported) {
+				// chains with the semaphore wait of the submission
+				barrier.srcStageMask = image.importStageMask;
+				barrier.srcAccessMask = VK_ACCESS_2_NONE;
+			}
+			else {
+				auto& previousState = states[previousOccupant(imageIndex)];
+				barrier.srcStageMask = previousState.writeStage | previousState.readStages;
+				barrier.srcAccessMask = previousState.writeAccess;
+			}
+			auto& barriers = passes[image.firstPass].barriers;
+			barriers.insert(barriers.begin(), RenderGraphBarrier{ imageIndex, barrier });
+
+			if (image.imported && image.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
+				auto& state = states[imageIndex];
+				VkImageMemoryBarrier2 finalBarrier = makeBarrier(imageIndex);
+				finalBarrier.srcStageMask = state.writeStage | state.readStages;
+				finalBarrier.srcAccessMask = state.writeAccess;
+				finalBarrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+				finalBarrier.dstAccessMask = VK_ACCESS_2_NONE;
+				finalBarrier.oldLayout = state.layout;
+				finalBarrier.newLayout = image.finalLayout;
+				finalBarriers.push_back({ imageIndex, finalBarrier });
+			}
+		}
+	}
+
+	size_t barrierCount() const {
+		size_t count = finalBarriers.size();
+		for (auto& pass : passes) {
+			count += pass.barriers.size();
+		}
+		return count;
+	}
+
+private:
+	VkImageMemoryBarrier2 makeBarrier(uint32_t imageIndex) const {
+		VkImageMemoryBarrier2 barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = images[imageIndex].image;
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+		return barrier;
+	}
+
+	const RenderGraphAccess& findAccess(uint32_t passIndex, uint32_t imageIndex) const {
+		for (auto& [index, access] : passes[passIndex].accesses) {
+			if (index == imageIndex) {
+				return access;
+			}
+		}
+		throw std::runtime_error("render graph image is not accessed by the pass");
+	}
+
+	// The image that last touched the memory before imageIndex: the slot neighbour ending right before it,
+	// or the one ending last when imageIndex is the first of its slot in the frame (this includes itself).
+	uint32_t previousOccupant(uint32_t imageIndex) const {
+		auto& slot = memorySlots[images[imageIndex].memorySlot];
+		uint32_t previous = UINT32_MAX;
+		uint32_t last = imageIndex;
+		for (auto other : slot.images) {
+			if (images[other].lastPass < images[imageIndex].firstPass &&
+				(previous == UINT32_MAX || images[other].lastPass > images[previous].lastPass)) {
+				previous = other;
+			}
+			if (images[other].lastPass > images[last].lastPass) {
+				last = other;
+			}
+		}
+		return previous != UINT32_MAX ? previous : last;
+	}
+};
+
+// note
+inline void hashCombine(size_t& seed, size_t value) {
+	seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+struct RenderPassAttachmentKey {
+	VkFormat                   format = VK_FORMAT_UNDEFINED;
+	VkSampleCountFlagBits     samples = VK_SAMPLE_COUNT_1_BIT;
+	VkAttachmentLoadOp         loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	VkAttachmentStoreOp       storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	VkAttachmentLoadOp  stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	VkAttachmentStoreOp stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	VkImageLayout       initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	VkImageLayout         finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	bool operator==(const RenderPassAttachmentKey&) const = default;
+};
+
+// Single subpass render passes: color attachments first, then the optional depth attachment.
+// A depth format of VK_FORMAT_UNDEFINED means no depth attachment.
+struct RenderPassKey {
+	std::vector<RenderPassAttachmentKey> colorAttachments;
+	RenderPassAttachmentKey               depthAttachment;
+
+	bool operator==(const RenderPassKey&) const = default;
+};
+
+struct RenderPassKeyHash {
+	size_t operator()(const RenderPassKey& key) const {
+		size_t seed = 0;
+		auto hashAttachment = [&](const RenderPassAttachmentKey& attachment) {
+			hashCombine(seed, std::hash<uint32_t>()(attachment.format));
+			hashCombine(seed, std::hash<uint32_t>()(attachment.samples));
+			hashCombine(seed, std::hash<uint32_t>()((attachment.loadOp << 16) | attachment.storeOp));
+			hashCombine(seed, std::hash<uint32_t>()((attachment.stencilLoadOp << 16) | attachment.stencilStoreOp));
+			hashCombine(seed, std::hash<uint32_t>()(attachment.initialLayout));
+			hashCombine(seed, std::hash<uint32_t>()(attachment.finalLayout));
+		};
+		for (auto& attachment : key.colorAttachments) {
+			hashAttachment(attachment);
+		}
+		hashAttachment(key.depthAttachment);
+		return seed;
+	}
+};
+
+// note
+// Imageless framebuffers are keyed on what the attachments look like, the views are supplied at vkCmdBeginRenderPass.
+// Otherwise the views themselves are part of the key and attachmentInfos stays empty.
+struct FramebufferAttachmentKey {
+	VkImageUsageFlags usage = 0;
+	VkFormat         format = VK_FORMAT_UNDEFINED;
+
+	bool operator==(const FramebufferAttachmentKey&) const = default;
+};
+
+struct FramebufferKey {
+	VkRenderPass                               renderPass = nullptr;
+	uint32_t                                        width = 0;
+	uint32_t                                       height = 0;
+	std::vector<VkImageView>                    attachments;
+	std::vector<FramebufferAttachmentKey>   attachmentInfos;
+
+	bool operator==(const FramebufferKey&) const = default;
+};
+
+struct FramebufferKeyHash {
+	size_t operator()(const FramebufferKey& key) const {
+		size_t seed = std::hash<VkRenderPass>()(key.renderPass);
+		hashCombine(seed, std::hash<uint64_t>()((uint64_t(key.width) << 32) | key.height));
+		for (auto view : key.attachments) {
+			hashCombine(seed, std::hash<VkImageView>()(view));
+		}
+		for (auto& info : key.attachmentInfos) {
+			hashCombine(seed, std::hash<uint64_t>()((uint64_t(info.usage) << 32) | info.format));
+		}
+		return seed;
+	}
+};
+
+struct ObjectCacheStats {
+	uint64_t   hits = 0;
+	uint64_t misses = 0;
+};
+
+const uint32_t WIDTH = 800;
+const uint32_t HEIGHT = 600;
+// note
+const int MAX_FRAMES_IN_FLIGHT = 2;
+
+// note
+enum class RenderingPath {
+	RenderPass,
+	DynamicRendering
+};
+
+// The path used for drawing, falls back to RenderPass when the device has no dynamic rendering.
+const RenderingPath PREFERRED_RENDERING_PATH = RenderingPath::DynamicRendering;
+const uint32_t PIPELINE_BENCHMARK_ITERATIONS = 64;
+const uint32_t RECORDING_BENCHMARK_ITERATIONS = 10000;
+
+class HelloTriangleApplication {
+public:
+	void run() {
+		initWindow();
+		initVulkan();
+		mainLoop();
+		cleanup();
+	}
+
+private:
+	GLFWwindow* window = nullptr;
+	VkInstance                             instance = nullptr;
+	VkPhysicalDevice                 physicalDevice = nullptr;
+	VkDevice                                 device = nullptr;
+	VkSurfaceKHR                            surface = nullptr;
+	VkQueue                           graphicsQueue = nullptr;
+	VkQueue                            presentQueue = nullptr;
+	VkSwapchainKHR                        swapChain = nullptr;
+	std::vector<VkImage>            swapChainImages;
+	VkFormat                   swapChainImageFormat;
+	VkExtent2D                      swapChainExtent;
+	std::vector<VkImageView>    swapChainImageViews;
+
+	VkShaderModule                 vertShaderModule = nullptr;
+	VkShaderModule                 fragShaderModule = nullptr;
+
+	VkPipelineLayout                 pipelineLayout = nullptr;
+
+	PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = nullptr;
+	PFN_vkGetDeviceProcAddr     vkGetDeviceProcAddr = nullptr;
+	PFN_vkDestroyInstance         vkDestroyInstance = nullptr;
+	PFN_vkDestroyDevice             vkDestroyDevice = nullptr;
+	PFN_vkDestroySurfaceKHR	    vkDestroySurfaceKHR = nullptr;
+	PFN_vkDestroySwapchainKHR vkDestroySwapchainKHR = nullptr;
+	PFN_vkDestroyImageView	     vkDestroyImageView = nullptr;
+	PFN_vkDestroyShaderModule vkDestroyShaderModule = nullptr;
+	PFN_vkDestroyPipelineLayout vkDestroyPipelineLayout;
+
+	// note
+	VkRenderPass                         renderPass = nullptr;
+	PFN_vkDestroyRenderPass     vkDestroyRenderPass;
+	VkPipeline                     graphicsPipeline = nullptr;
+	PFN_vkDestroyPipeline         vkDestroyPipeline;
+
+	// note
+	QueueFamilyIndices           queueFamilyIndices;
+	RenderGraph                         renderGraph;
+	uint32_t                     sceneColorImage = 0;
+	uint32_t                     backbufferImage = 0;
+	VkCommandPool                       commandPool = nullptr;
+	std::vector<VkCommandBuffer>       commandBuffers;
+	std::vector<VkSemaphore> imageAvailableSemaphores;
+	std::vector<VkSemaphore> renderFinishedSemaphores;
+	std::vector<VkFence>               inFlightFences;
+	uint32_t                           currentFrame = 0;
+
+	PFN_vkDestroyFramebuffer     vkDestroyFramebuffer = nullptr;
+	PFN_vkDestroyCommandPool     vkDestroyCommandPool = nullptr;
+	PFN_vkDestroySemaphore         vkDestroySemaphore = nullptr;
+	PFN_vkDestroyFence                 vkDestroyFence = nullptr;
+	PFN_vkDestroyImage                 vkDestroyImage = nullptr;
+	PFN_vkFreeMemory                     vkFreeMemory = nullptr;
+	PFN_vkDeviceWaitIdle             vkDeviceWaitIdle = nullptr;
+	PFN_vkWaitForFences               vkWaitForFences = nullptr;
+	PFN_vkResetFences                   vkResetFences = nullptr;
+	PFN_vkAcquireNextImageKHR   vkAcquireNextImageKHR = nullptr;
+	PFN_vkQueueSubmit                   vkQueueSubmit = nullptr;
+	PFN_vkQueuePresentKHR           vkQueuePresentKHR = nullptr;
+	PFN_vkBeginCommandBuffer     vkBeginCommandBuffer = nullptr;
+	PFN_vkEndCommandBuffer         vkEndCommandBuffer = nullptr;
+	PFN_vkResetCommandBuffer     vkResetCommandBuffer = nullptr;
+	PFN_vkCmdBeginRenderPass     vkCmdBeginRenderPass = nullptr;
+	PFN_vkCmdEndRenderPass         vkCmdEndRenderPass = nullptr;
+	PFN_vkCmdBindPipeline           vkCmdBindPipeline = nullptr;
+	PFN_vkCmdDraw                           vkCmdDraw = nullptr;
+	PFN_vkCmdBlitImage                 vkCmdBlitImage = nullptr;
+	PFN_vkCmdPipelineBarrier2   vkCmdPipelineBarrier2 = nullptr;
+
+	// note
+	RenderingPath                     renderingPath = RenderingPath::RenderPass;
+	bool                    dynamicRenderingSupported = false;
+	PFN_vkCmdBeginRendering       vkCmdBeginRendering = nullptr;
+	PFN_vkCmdEndRendering           vkCmdEndRendering = nullptr;
+
+	// note
+	std::unordered_map<RenderPassKey, VkRenderPass, RenderPassKeyHash>     renderPassCache;
+	std::unordered_map<FramebufferKey, VkFramebuffer, FramebufferKeyHash> framebufferCache;
+	ObjectCacheStats                  renderPassCacheStats;
+	ObjectCacheStats                 framebufferCacheStats;
+	bool                    imagelessFramebufferSupported = false;
+	bool                               framebufferResized = false;
+	PFN_vkCmdSetViewport                 vkCmdSetViewport = nullptr;
+	PFN_vkCmdSetScissor                   vkCmdSetScissor = nullptr;
+
+#ifndef NDEBUG
+	VkDebugUtilsMessengerEXT         debugMessenger = nullptr;
+	PFN_vkDestroyDebugUtilsMessengerEXT vkDestroyDebugUtilsMessengerEXT = nullptr;
+#endif
+
+	void initWindow() {
+		glfwInit();
+
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		// note
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+		window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan", nullptr, nullptr);
+		glfwSetWindowUserPointer(window, this);
+		glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+	}
+
+	static void framebufferResizeCallback(GLFWwindow* window, int width, int height) {
+		auto app = reinterpret_cast<HelloTriangleApplication*>(glfwGetWindowUserPointer(window));
+		app->framebufferResized = true;
+	}
+
+	void initVulkan() {
+		initInstance();
+		createSurface();
+		selectPhysicalDevice();
+		initDevice();
+		createSwapChain();
+		createImageViews();
+		// note
+		createRenderPass();
+		createGraphicsPipeline();
+		// note
+		buildRenderGraph();
+		createRenderGraphResources();
+		createCommandPool();
+		createCommandBuffers();
+		createSyncObjects();
+		// note
+		benchmarkRenderingPaths();
+		reportObjectCaches("startup");
+	}
+
+	void mainLoop() {
+		while (!glfwWindowShouldClose(window)) {
+			glfwPollEvents();
+			drawFrame();
+		}
+
+		vkDeviceWaitIdle(device);
+	}
+
+	void cleanup() {
+
+		// note
+		for (auto semaphore : imageAvailableSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto semaphore : renderFinishedSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto fence : inFlightFences) {
+			vkDestroyFence(device, fence, nullptr);
+		}
+		if (vkDestroyCommandPool) {
+			vkDestroyCommandPool(device, commandPool, nullptr);
+		}
+		for (auto& [key, framebuffer] : framebufferCache) {
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+		}
+		framebufferCache.clear();
+		destroyRenderGraphResources();
+
+		// note
+		if (vkDestroyPipeline) {
+			vkDestroyPipeline(device, graphicsPipeline, nullptr);
+		}
+
+		if (vkDestroyPipelineLayout) {
+			vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+		}
+
+		// note
+		// renderPass is owned by the cache
+		for (auto& [key, cachedRenderPass] : renderPassCache) {
+			vkDestroyRenderPass(device, cachedRenderPass, nullptr);
+		}
+		renderPassCache.clear();
+
+		if (vkDestroyShaderModule) {
+			vkDestroyShaderModule(device, vertShaderModule, nullptr);
+			vkDestroyShaderModule(device, fragShaderModule, nullptr);
+		}
+
+		cleanupSwapChain();
+		if (vkDestroyDevice) {
+			vkDestroyDevice(device, nullptr);
+
+		}
+#ifndef NDEBUG
+		if (vkDestroyDebugUtilsMessengerEXT) {
+			vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+		}
+#endif
+		if (vkDestroyInstance) {
+			vkDestroySurfaceKHR(instance, surface, nullptr);
+			vkDestroyInstance(instance, nullptr);
+		}
+		glfwDestroyWindow(window);
+
+		glfwTerminate();
+	}
+
+	void initInstance() {
+		vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)glfwGetInstanceProcAddress(nullptr, "vkGetInstanceProcAddr");
+		auto vkEnumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+		auto vkEnumerateInstanceExtensionProperties = (PFN_vkEnumerateInstanceExtensionProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceExtensionProperties");
+		auto vkEnumerateInstanceLayerProperties = (PFN_vkEnumerateInstanceLayerProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceLayerProperties");
+		auto vkCreateInstance = (PFN_vkCreateInstance)vkGetInstanceProcAddr(nullptr, "vkCreateInstance");
+
+		uint32_t supportedVersion = 0u;
+		VkResult result = vkEnumerateInstanceVersion(&supportedVersion);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Version: " << VK_VERSION_MAJOR(supportedVersion) << "." << VK_VERSION_MINOR(supportedVersion) << "." << VK_VERSION_PATCH(supportedVersion) << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to enumerate instance version");
+		}
+
+		auto requestInstanceVersion = 0u;
+		if (supportedVersion >= VK_API_VERSION_1_3) {
+			requestInstanceVersion = VK_API_VERSION_1_3;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_2) {
+			requestInstanceVersion = VK_API_VERSION_1_2;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_1) {
+			requestInstanceVersion = VK_API_VERSION_1_1;
+		}
+		else {
+			requestInstanceVersion = VK_API_VERSION_1_0;
+		}
+
+		VkApplicationInfo  appInfo = {};
+		appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+		appInfo.pApplicationName = "Hello Triangle";
+		appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.pEngineName = "No Engine";
+		appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.apiVersion = requestInstanceVersion;
+		appInfo.pNext = nullptr;
+
+		uint32_t        extensionCount = 0;
+		auto ppExtensioNames = glfwGetRequiredInstanceExtensions(&extensionCount);
+
+		std::vector<const char*> requestedInstanceExtensions = std::vector<const char*>(ppExtensioNames, ppExtensioNames + extensionCount);
+#ifndef NDEBUG
+		requestedInstanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+#endif
+		std::vector<const char*> requestedInstanceLayers = {
+			//	"VK_LAYER_LUNARG_api_dump"
+		};
+#ifndef NDEBUG
+		requestedInstanceLayers.push_back("VK_LAYER_KHRONOS_validation");
+#endif		
+
+		std::vector<const char*> enabledInstanceExtensions;
+		std::vector<const char*> enabledInstanceLayers;
+
+		auto instanceExtensionPropCount = 0u;
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(instanceExtensionPropCount);
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, extensionProps.data());
+
+		auto instanceLayerPropCount = 0u;
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, nullptr);
+		std::vector<VkLayerProperties> layerProps(instanceLayerPropCount);
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, layerProps.data());
+
+		for (auto& requestedInstanceExtension : requestedInstanceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedInstanceExtension)) {
+				throw std::runtime_error("failed to find instance extension: " + std::string(requestedInstanceExtension));
+			}
+		}
+		for (auto& requestedInstanceLayer : requestedInstanceLayers) {
+			if (!findLayerProperties(layerProps, requestedInstanceLayer)) {
+				throw std::runtime_error("failed to find instance layer: " + std::string(requestedInstanceLayer));
+			}
+		}
+
+		enabledInstanceExtensions = requestedInstanceExtensions;
+		enabledInstanceLayers = requestedInstanceLayers;
+
+		VkInstanceCreateInfo createInfo = {};
+		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+		createInfo.pApplicationInfo = &appInfo;
+		createInfo.enabledExtensionCount = enabledInstanceExtensions.size();
+		createInfo.ppEnabledExtensionNames = enabledInstanceExtensions.data();
+		createInfo.enabledLayerCount = enabledInstanceLayers.size();
+		createInfo.ppEnabledLayerNames = enabledInstanceLayers.data();
+
+		result = vkCreateInstance(&createInfo, nullptr, &instance);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Instance created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create instance");
+		}
+		vkDestroyInstance = (PFN_vkDestroyInstance)vkGetInstanceProcAddr(instance, "vkDestroyInstance");
+
+#ifndef NDEBUG
+		auto vkCreateDebugUtilsMessengerEXT = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
+		VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = {};
+		debugCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+		debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+		debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+		debugCreateInfo.pfnUserCallback = debugCallback;
+		result = vkCreateDebugUtilsMessengerEXT(instance, &debugCreateInfo, nullptr, &debugMessenger);
+		if (result == VK_SUCCESS) {
+			std::cout << "Debug Messenger created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create debug messenger");
+		}
+		vkDestroyDebugUtilsMessengerEXT = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+#endif
+	}
+
+	void createSurface()
+	{
+		vkDestroySurfaceKHR = (PFN_vkDestroySurfaceKHR)vkGetInstanceProcAddr(instance, "vkDestroySurfaceKHR");
+		if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create window surface!");
+		}
+	}
+
+	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails details;
+		auto vkGetPhysicalDeviceSurfaceCapabilitiesKHR = (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"); // notice that instance, not device
+		auto vkGetPhysicalDeviceSurfaceFormatsKHR = (PFN_vkGetPhysicalDeviceSurfaceFormatsKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+		auto vkGetPhysicalDeviceSurfacePresentModesKHR = (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
+
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physDev, surface, &details.capabilities);
+
+		uint32_t formatCount = 0;
+		vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, nullptr);
+		if (formatCount != 0) {
+			details.formats.resize(formatCount);
+			vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, details.formats.data());
+		}
+
+		uint32_t presentModeCount = 0;
+		vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, nullptr);
+		if (presentModeCount != 0) {
+			details.presentModes.resize(presentModeCount);
+			vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, details.presentModes.data());
+		}
+
+		return details;
+	}
+
+	bool isDeviceSuitable(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physDev);
+		if (!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty()) {
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	void selectPhysicalDevice() {
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		auto physicalDeviceCount = 0u;
+		auto result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, nullptr);
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+		std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+		result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, physicalDevices.data());
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+
+		for (auto& physDev : physicalDevices) {
+			VkPhysicalDeviceProperties physicalDeviceProperties;
+			vkGetPhysicalDeviceProperties(physDev, &physicalDeviceProperties);
+			std::cout << "Physical Device: " << physicalDeviceProperties.deviceName << std::endl;
+			std::cout << "API Version: " << VK_VERSION_MAJOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_MINOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_PATCH(physicalDeviceProperties.apiVersion) << std::endl;
+			std::cout << "Driver Version: " << physicalDeviceProperties.driverVersion << std::endl;
+			std::cout << "Vendor ID: " << physicalDeviceProperties.vendorID << std::endl;
+			std::cout << "Device ID: " << physicalDeviceProperties.deviceID << std::endl;
+			VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+			vkGetPhysicalDeviceFeatures(physDev, &physicalDeviceFeatures);
+			std::cout << "GeometryShader    : " << physicalDeviceFeatures.geometryShader << std::endl;
+			std::cout << "TessellationShader: " << physicalDeviceFeatures.tessellationShader << std::endl;
+			std::uint32_t extensionCount;
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, nullptr);
+			std::vector<VkExtensionProperties> extensionProps(extensionCount);
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, extensionProps.data());
+			std::cout << "ExtensionCount: " << extensionProps.size() << std::endl;
+			size_t index = 0;
+			for (auto& extensionProp : extensionProps) {
+				std::cout << "Extensions[" << index << "]: " << extensionProp.extensionName << std::endl;
+				index++;
+			}
+			if (vkGetPhysicalDeviceFeatures2) {
+				// Query Vulkan Features
+				VkPhysicalDeviceFeatures2        physicalDeviceFeatures2 = {};
+				VkPhysicalDeviceVulkan11Features physicalDeviceVulkan11Features = {};
+				VkPhysicalDeviceVulkan12Features physicalDeviceVulkan12Features = {};
+				VkPhysicalDeviceVulkan13Features physicalDeviceVulkan13Features = {};
+				physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				physicalDeviceVulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+				physicalDeviceVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				physicalDeviceVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+				physicalDeviceFeatures2.pNext = &physicalDeviceVulkan11Features;
+				physicalDeviceVulkan11Features.pNext = &physicalDeviceVulkan12Features;
+				physicalDeviceVulkan12Features.pNext = &physicalDeviceVulkan13Features;
+				physicalDeviceVulkan13Features.pNext = nullptr;
+				vkGetPhysicalDeviceFeatures2(physDev, &physicalDeviceFeatures2);
+				std::cout << "BufferDeviceAddress: " << physicalDeviceVulkan12Features.bufferDeviceAddress << std::endl;
+				std::cout << "DynamicRendering   : " << physicalDeviceVulkan13Features.dynamicRendering << std::endl;
+			}
+			auto queueFamilyCount = 0u;
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+			std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilyProps.data());
+			std::cout << "QueueFamilyCount: " << queueFamilyProps.size() << std::endl;
+			for (auto& queueFamilyProp : queueFamilyProps) {
+				std::cout << "QueueFlags: ";
+				if (queueFamilyProp.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+					std::cout << "GRAPHICS |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_COMPUTE_BIT) {
+					std::cout << "COMPUTE |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_TRANSFER_BIT) {
+					std::cout << "TRANSFER |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) {
+					std::cout << "SPARSE_BINDING |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_PROTECTED_BIT) {
+					std::cout << "PROTECTED |";
+				}
+				std::cout << std::endl;
+				std::cout << "QueueCount: " << queueFamilyProp.queueCount << std::endl;
+				std::cout << "TimestampValidBits: " << queueFamilyProp.timestampValidBits << std::endl;
+			}
+		}
+
+		if (physicalDevices.size() > 0 && isDeviceSuitable(physicalDevices[0])) {
+			physicalDevice = physicalDevices[0];
+		}
+		else {
+			throw std::runtime_error("failed to find a physical device with Vulkan support");
+		}
+
+
+	}
+
+	QueueFamilyIndices findQueueFamilies(VkPhysicalDevice physDev)
+	{
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+
+		QueueFamilyIndices indices;
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilies.data());
+
+		int i = 0;
+		for (const auto& queueFamily : queueFamilies) {
+			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+				indices.graphicsFamily = i;
+			}
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physDev, i, surface, &presentSupport);
+
+			if (presentSupport) {
+				indices.presentFamily = i;
+			}
+
+			if (indices.isComplete()) {
+				break;
+			}
+			i++;
+		}
+
+		return indices;
+	}
+
+	void initDevice() {
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		std::uint32_t extensionCount;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(extensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensionProps.data());
+
+		std::vector<const char*> requestedDeviceExtensions = std::vector<const char*>{
+			VK_KHR_SWAPCHAIN_EXTENSION_NAME
+		};
+		// note
+		// synchronization2 is core in Vulkan 1.3, older devices need the KHR extension
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+		if (physicalDeviceProperties.apiVersion < VK_API_VERSION_1_3) {
+			requestedDeviceExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+		}
+		// note
+		// dynamic rendering is core in Vulkan 1.3, the KHR extension builds on 1.2
+		bool dynamicRenderingAvailable = physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_3;
+		if (!dynamicRenderingAvailable && physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2 &&
+			findExtensionProperties(extensionProps, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)) {
+			requestedDeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+			dynamicRenderingAvailable = true;
+		}
+		std::vector<const char*> enabledDeviceExtensions;
+		for (auto& requestedDeviceExtension : requestedDeviceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedDeviceExtension)) {
+				throw std::runtime_error("failed to find device extension: " + std::string(requestedDeviceExtension));
+			}
+		}
+
+		enabledDeviceExtensions = requestedDeviceExtensions;
+
+		VkDeviceCreateInfo deviceCreateInfo = {};
+		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		deviceCreateInfo.enabledExtensionCount = requestedDeviceExtensions.size();
+		deviceCreateInfo.ppEnabledExtensionNames = requestedDeviceExtensions.data();
+
+		VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &physicalDeviceFeatures);
+		deviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
+
+		// note
+		VkPhysicalDeviceSynchronization2Features synchronization2Features = {};
+		synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+		VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures = {};
+		dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+		synchronization2Features.pNext = &dynamicRenderingFeatures;
+		if (vkGetPhysicalDeviceFeatures2) {
+			VkPhysicalDeviceFeatures2 physicalDeviceFeatures2 = {};
+			physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			physicalDeviceFeatures2.pNext = &synchronization2Features;
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+		}
+		if (!synchronization2Features.synchronization2) {
+			throw std::runtime_error("failed to find synchronization2 support");
+		}
+		// note
+		// imageless framebuffers are core in Vulkan 1.2, with the KHR extension before that
+		VkPhysicalDeviceImagelessFramebufferFeatures imagelessFramebufferFeatures = {};
+		imagelessFramebufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGELESS_FRAMEBUFFER_FEATURES;
+		if (vkGetPhysicalDeviceFeatures2) {
+			VkPhysicalDeviceFeatures2 physicalDeviceFeatures2 = {};
+			physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			physicalDeviceFeatures2.pNext = &imagelessFramebufferFeatures;
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+		}
+		imagelessFramebufferSupported = imagelessFramebufferFeatures.imagelessFramebuffer &&
+			(physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2 || findExtensionProperties(extensionProps, VK_KHR_IMAGELESS_FRAMEBUFFER_EXTENSION_NAME));
+		if (imagelessFramebufferSupported && physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2) {
+			requestedDeviceExtensions.push_back(VK_KHR_IMAGELESS_FRAMEBUFFER_EXTENSION_NAME);
+		}
+		std::cout << "Imageless framebuffers: " << (imagelessFramebufferSupported ? "yes" : "no") << std::endl;
+
+		dynamicRenderingSupported = dynamicRenderingAvailable && dynamicRenderingFeatures.dynamicRendering;
+		if (!dynamicRenderingSupported) {
+			// keep the extension list in sync with the feature chain
+			requestedDeviceExtensions.erase(std::remove_if(requestedDeviceExtensions.begin(), requestedDeviceExtensions.end(), [](const char* name) {
+				return strcmp(name, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) == 0;
+			}), requestedDeviceExtensions.end());
+			synchronization2Features.pNext = nullptr;
+		}
+		else {
+			dynamicRenderingFeatures.pNext = nullptr;
+		}
+		if (imagelessFramebufferSupported) {
+			imagelessFramebufferFeatures.pNext = synchronization2Features.pNext;
+			synchronization2Features.pNext = &imagelessFramebufferFeatures;
+		}
+		deviceCreateInfo.enabledExtensionCount = requestedDeviceExtensions.size();
+		deviceCreateInfo.ppEnabledExtensionNames = requestedDeviceExtensions.data();
+		deviceCreateInfo.pNext = &synchronization2Features;
+		renderingPath = dynamicRenderingSupported ? PREFERRED_RENDERING_PATH : RenderingPath::RenderPass;
+		std::cout << "Rendering path: " << (renderingPath == RenderingPath::DynamicRendering ? "dynamic rendering" : "render pass") << std::endl;
+
+		auto queueFamilyCount = 0u;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProps.data());
+
+		// note
+		queueFamilyIndices = findQueueFamilies(physicalDevice);
+		std::set<uint32_t> uniqueQueueFamilyIndices = { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value() };
+
+		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+		float queuePriority = 1.0f;
+		for (uint32_t uniqueQueueFamilyindex : uniqueQueueFamilyIndices) {
+			VkDeviceQueueCreateInfo queueCreateInfo = {};
+			queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queueCreateInfo.queueFamilyIndex = uniqueQueueFamilyindex;
+			queueCreateInfo.queueCount = 1;
+			queueCreateInfo.pQueuePriorities = &queuePriority;
+			queueCreateInfos.push_back(queueCreateInfo);
+		}
+
+		deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
+		deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+
+		auto vkCreateDevice = (PFN_vkCreateDevice)vkGetInstanceProcAddr(instance, "vkCreateDevice");
+		auto result = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Device created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create device");
+		}
+
+		vkGetDeviceProcAddr = (PFN_vkGetDeviceProcAddr)vkGetInstanceProcAddr(instance, "vkGetDeviceProcAddr");
+		auto vkGetDeviceQueue = (PFN_vkGetDeviceQueue)vkGetDeviceProcAddr(device, "vkGetDeviceQueue");
+		vkDestroyDevice = (PFN_vkDestroyDevice)vkGetDeviceProcAddr(device, "vkDestroyDevice");
+
+		vkGetDeviceQueue(device, queueFamilyIndices.graphicsFamily.value(), 0, &graphicsQueue);
+		vkGetDeviceQueue(device, queueFamilyIndices.presentFamily.value(), 0, &presentQueue);
+	}
+
+	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
+	{
+		for (const auto& availableFormat : availableFormats) {
+			if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+				return availableFormat;
+			}
+		}
+
+		return availableFormats[0];
+	}
+
+	VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
+	{
+		for (const auto& availablePresentMode : availablePresentModes) {
+			if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+				return availablePresentMode;
+			}
+		}
+
+		return VK_PRESENT_MODE_FIFO_KHR;
+	}
+
+	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
+	{
+		if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+			return capabilities.currentExtent;
+		}
+		else {
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+
+			VkExtent2D actualExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+
+			actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+			actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+
+			return actualExtent;
+		}
+	}
+
+	void createSwapChain()
+	{
+		auto vkCreateSwapchainKHR = (PFN_vkCreateSwapchainKHR)vkGetDeviceProcAddr(device, "vkCreateSwapchainKHR");
+		auto vkGetSwapchainImagesKHR = (PFN_vkGetSwapchainImagesKHR)vkGetDeviceProcAddr(device, "vkGetSwapchainImagesKHR");
+
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
+
+		VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
+		VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+		VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
+
+		uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+
+		if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
+			imageCount = swapChainSupport.capabilities.maxImageCount;
+		}
+
+		VkSwapchainCreateInfoKHR createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+		createInfo.surface = surface;
+		createInfo.minImageCount = imageCount;
+		createInfo.imageFormat = surfaceFormat.format;
+		createInfo.imageColorSpace = surfaceFormat.colorSpace;
+		createInfo.imageExtent = extent;
+		createInfo.imageArrayLayers = 1;
+		// note
+		// the render graph copies its result into the swap chain image
+		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+		QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
+		uint32_t sharedQueueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+
+		if (indices.graphicsFamily != indices.presentFamily) {
+			createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+			createInfo.queueFamilyIndexCount = 2;
+			createInfo.pQueueFamilyIndices = sharedQueueFamilyIndices;
+		}
+		else {
+			createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			/*createInfo.queueFamilyIndexCount = 0;
+			createInfo.pQueueFamilyIndices = nullptr;*/
+		}
+
+		createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
+		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+		createInfo.presentMode = presentMode;
+		createInfo.clipped = VK_TRUE;
+
+		createInfo.oldSwapchain = VK_NULL_HANDLE;
+
+		if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create swap chain!");
+		}
+
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);
+		swapChainImages.resize(imageCount);
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImages.data());
+
+		swapChainImageFormat = surfaceFormat.format;
+		swapChainExtent = extent;
+
+		vkDestroySwapchainKHR = (PFN_vkDestroySwapchainKHR)vkGetDeviceProcAddr(device, "vkDestroySwapchainKHR");
+	}
+
+	// note
+	void cleanupSwapChain() {
+		for (auto imageView : swapChainImageViews) {
+			vkDestroyImageView(device, imageView, nullptr);
+		}
+		swapChainImageViews.clear();
+
+		vkDestroySwapchainKHR(device, swapChain, nullptr);
+		swapChain = nullptr;
+	}
+
+	// Render passes only depend on formats, so they all survive. Transient images follow the new extent,
+	// framebuffers that referenced old views or the old extent are dropped and recreated on first use.
+	void recreateSwapChain() {
+		int width = 0, height = 0;
+		glfwGetFramebufferSize(window, &width, &height);
+		while (width == 0 || height == 0) {
+			glfwGetFramebufferSize(window, &width, &height);
+			glfwWaitEvents();
+		}
+
+		vkDeviceWaitIdle(device);
+
+		auto oldImageCount = swapChainImages.size();
+		auto oldFormat = swapChainImageFormat;
+		std::vector<VkImageView> retiredViews = swapChainImageViews;
+		for (auto& image : renderGraph.images) {
+			if (!image.imported) {
+				retiredViews.push_back(image.view);
+			}
+		}
+		evictFramebuffers(retiredViews, swapChainExtent);
+
+		destroyRenderGraphResources();
+		cleanupSwapChain();
+
+		createSwapChain();
+		// imageless framebuffers of the old extent
+		evictFramebuffers({}, swapChainExtent);
+		createImageViews();
+		if (swapChainImageFormat != oldFormat) {
+			throw std::runtime_error("swap chain format changed during recreation");
+		}
+		buildRenderGraph();
+		createRenderGraphResources();
+		if (swapChainImages.size() != oldImageCount) {
+			for (auto semaphore : renderFinishedSemaphores) {
+				vkDestroySemaphore(device, semaphore, nullptr);
+			}
+			createRenderFinishedSemaphores();
+		}
+
+		reportObjectCaches("swap chain recreation");
+	}
+
+	void createImageViews()
+	{
+		auto vkCreateImageView = (PFN_vkCreateImageView)vkGetDeviceProcAddr(device, "vkCreateImageView");
+
+		swapChainImageViews.resize(swapChainImages.size());
+
+		for (size_t i = 0; i < swapChainImages.size(); i++) {
+			VkImageViewCreateInfo createInfo{};
+			createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			createInfo.image = swapChainImages[i];
+			createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			createInfo.format = swapChainImageFormat;
+			createInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+			createInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+			createInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+			createInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+			createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			createInfo.subresourceRange.baseMipLevel = 0;
+			createInfo.subresourceRange.levelCount = 1;
+			createInfo.subresourceRange.baseArrayLayer = 0;
+			createInfo.subresourceRange.layerCount = 1;
+
+			if (vkCreateImageView(device, &createInfo, nullptr, &swapChainImageViews[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create image views!");
+			}
+		}
+
+		vkDestroyImageView = (PFN_vkDestroyImageView)vkGetDeviceProcAddr(device, "vkDestroyImageView");
+	}
+
+	// note
+	// Dynamic rendering needs neither a render pass nor a framebuffer.
+	void createRenderPass() {
+		vkDestroyRenderPass = (PFN_vkDestroyRenderPass)vkGetDeviceProcAddr(device, "vkDestroyRenderPass");
+		if (renderingPath == RenderingPath::RenderPass) {
+			renderPass = acquireRenderPass(sceneRenderPassKey());
+		}
+	}
+
+	RenderPassKey sceneRenderPassKey() const {
+		RenderPassAttachmentKey colorAttachment;
+		colorAttachment.format = swapChainImageFormat;
+		colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		RenderPassKey key;
+		key.colorAttachments.push_back(colorAttachment);
+		return key;
+	}
+
+	// Returns the shared render pass for the key, callers never destroy it.
+	VkRenderPass acquireRenderPass(const RenderPassKey& key) {
+		auto cached = renderPassCache.find(key);
+		if (cached != renderPassCache.end()) {
+			renderPassCacheStats.hits++;
+			return cached->second;
+		}
+		renderPassCacheStats.misses++;
+		auto created = createRenderPass(key);
+		renderPassCache.emplace(key, created);
+		return created;
+	}
+
+	// The render graph moves images into and out of the attachment layouts with its own barriers,
+	// so the render pass neither transitions nor needs external subpass dependencies.
+	VkRenderPass createRenderPass(const RenderPassKey& key) {
+		std::vector<VkAttachmentDescription> attachments;
+		std::vector<VkAttachmentReference> colorAttachmentRefs;
+		auto describe = [&](const RenderPassAttachmentKey& attachmentKey) {
+			VkAttachmentDescription attachment{};
+			attachment.format = attachmentKey.format;
+			attachment.samples = attachmentKey.samples;
+			attachment.loadOp = attachmentKey.loadOp;
+			attachment.storeOp = attachmentKey.storeOp;
+			attachment.stencilLoadOp = attachmentKey.stencilLoadOp;
+			attachment.stencilStoreOp = attachmentKey.stencilStoreOp;
+			attachment.initialLayout = attachmentKey.initialLayout;
+			attachment.finalLayout = attachmentKey.finalLayout;
+			attachments.push_back(attachment);
+		};
+		for (auto& colorAttachment : key.colorAttachments) {
+			colorAttachmentRefs.push_back({ static_cast<uint32_t>(attachments.size()), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+			describe(colorAttachment);
+		}
+		VkAttachmentReference depthAttachmentRef{};
+		bool hasDepth = key.depthAttachment.format != VK_FORMAT_UNDEFINED;
+		if (hasDepth) {
+			depthAttachmentRef = { static_cast<uint32_t>(attachments.size()), VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+			describe(key.depthAttachment);
+		}
+
+		VkSubpassDescription subpass{};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentRefs.size());
+		subpass.pColorAttachments = colorAttachmentRefs.data();
+		subpass.pDepthStencilAttachment = hasDepth ? &depthAttachmentRef : nullptr;
+
+		VkRenderPassCreateInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+		renderPassInfo.pAttachments = attachments.data();
+		renderPassInfo.subpassCount = 1;
+		renderPassInfo.pSubpasses = &subpass;
+
+		auto vkCreateRenderPass = (PFN_vkCreateRenderPass)vkGetInstanceProcAddr(instance, "vkCreateRenderPass");
+		VkRenderPass sceneRenderPass = nullptr;
+		if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &sceneRenderPass) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create render pass");
+		}
+		return sceneRenderPass;
+	}
+
+	void createGraphicsPipeline() {
+		auto vertShaderCode = readFile(SHADER_ROOT_DIR"/shader.vert.spv");
+		auto fragShaderCode = readFile(SHADER_ROOT_DIR"/shader.frag.spv");
+
+		vertShaderModule = createShaderModule(vertShaderCode);
+		fragShaderModule = createShaderModule(fragShaderCode);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 0;
+		pipelineLayoutInfo.pSetLayouts = nullptr;
+		pipelineLayoutInfo.pushConstantRangeCount = 0;
+		pipelineLayoutInfo.pPushConstantRanges = nullptr;
+
+		auto vkCreatePipelineLayout = (PFN_vkCreatePipelineLayout)vkGetInstanceProcAddr(instance, "vkCreatePipelineLayout");
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create pipeline layout");
+		}
+
+		// note
+		graphicsPipeline = createScenePipeline(renderingPath == RenderingPath::RenderPass ? renderPass : nullptr);
+
+		vkDestroyPipeline = (PFN_vkDestroyPipeline)vkGetDeviceProcAddr(device, "vkDestroyPipeline");
+
+		vkDestroyPipelineLayout = (PFN_vkDestroyPipelineLayout)vkGetDeviceProcAddr(device, "vkDestroyPipelineLayout");
+		vkDestroyShaderModule = (PFN_vkDestroyShaderModule)vkGetDeviceProcAddr(device, "vkDestroyShaderModule");
+	}
+
+	// Without a render pass the attachment formats are declared through VkPipelineRenderingCreateInfo,
+	// the pipeline is then usable inside any vkCmdBeginRendering with matching formats.
+	VkPipeline createScenePipeline(VkRenderPass compatibleRenderPass) {
+		VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+		vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+		vertShaderStageInfo.module = vertShaderModule;
+		vertShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+		fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fragShaderStageInfo.module = fragShaderModule;
+		fragShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
+
+		// note
+		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vertexInputInfo.vertexBindingDescriptionCount = 0;
+		vertexInputInfo.vertexAttributeDescriptionCount = 0;
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)swapChainExtent.width;
+		viewport.height = (float)swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = swapChainExtent;
+
+		VkPipelineViewportStateCreateInfo viewportState{};
+		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewportState.viewportCount = 1;
+		viewportState.pViewports = &viewport;
+		viewportState.scissorCount = 1;
+		viewportState.pScissors = &scissor;
+
+		// note
+		// the pipeline outlives swap chain recreation, so the extent is set at record time
+		std::array<VkDynamicState, 2> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+		VkPipelineDynamicStateCreateInfo dynamicState{};
+		dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+		dynamicState.pDynamicStates = dynamicStates.data();
+
+		VkPipelineRasterizationStateCreateInfo rasterizer{};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.0f;
+		rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+		rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+		rasterizer.depthBiasEnable = VK_FALSE;
+
+		VkPipelineMultisampleStateCreateInfo multisampling{};
+		multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisampling.sampleShadingEnable = VK_FALSE;
+		multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.blendEnable = VK_FALSE;
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD; // Optional
+		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD; // Optional
+
+		VkPipelineColorBlendStateCreateInfo colorBlending{};
+		colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlending.logicOpEnable = VK_FALSE;
+		colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
+		colorBlending.attachmentCount = 1;
+		colorBlending.pAttachments = &colorBlendAttachment;
+		colorBlending.blendConstants[0] = 0.0f; // Optional
+		colorBlending.blendConstants[1] = 0.0f; // Optional
+		colorBlending.blendConstants[2] = 0.0f; // Optional
+		colorBlending.blendConstants[3] = 0.0f; // Optional
+
+		VkPipelineRenderingCreateInfo renderingInfo{};
+		renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		renderingInfo.colorAttachmentCount = 1;
+		renderingInfo.pColorAttachmentFormats = &swapChainImageFormat;
+
+		VkGraphicsPipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipelineInfo.stageCount = 2;
+		pipelineInfo.pStages = shaderStages;
+		pipelineInfo.pVertexInputState = &vertexInputInfo;
+		pipelineInfo.pInputAssemblyState = &inputAssembly;
+		pipelineInfo.pViewportState = &viewportState;
+		pipelineInfo.pRasterizationState = &rasterizer;
+		pipelineInfo.pMultisampleState = &multisampling;
+		pipelineInfo.pDepthStencilState = nullptr;
+		pipelineInfo.pColorBlendState = &colorBlending;
+		pipelineInfo.pDynamicState = &dynamicState;
+		pipelineInfo.layout = pipelineLayout;
+		pipelineInfo.renderPass = compatibleRenderPass;
+		pipelineInfo.subpass = 0;
+		if (!compatibleRenderPass) {
+			pipelineInfo.pNext = &renderingInfo;
+		}
+
+		auto vkCreateGraphicsPipelines = (PFN_vkCreateGraphicsPipelines)vkGetInstanceProcAddr(instance, "vkCreateGraphicsPipelines");
+		VkPipeline pipeline = nullptr;
+		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create graphics pipeline");
+		}
+		return pipeline;
+	}
+
+	// note
+	// scene -> half resolution -> full resolution -> swap chain. sceneColor is dead once downsampled,
+	// so upscaledColor reuses its memory.
+	void buildRenderGraph() {
+		renderGraph = RenderGraph();
+		VkExtent2D halfExtent = { std::max(swapChainExtent.width / 2, 1u), std::max(swapChainExtent.height / 2, 1u) };
+
+		sceneColorImage = renderGraph.createImage("sceneColor", swapChainImageFormat, swapChainExtent,
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+		auto sceneColor = sceneColorImage;
+		auto halfColor = renderGraph.createImage("halfColor", swapChainImageFormat, halfExtent,
+			VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+		auto upscaledColor = renderGraph.createImage("upscaledColor", swapChainImageFormat, swapChainExtent,
+			VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+		backbufferImage = renderGraph.importImage("backbuffer", swapChainImageFormat, swapChainExtent,
+			VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+		renderGraph.addPass("scene", { { sceneColor, colorAttachmentWrite() } }, [this](VkCommandBuffer commandBuffer) {
+			// note
+			recordScenePass(commandBuffer, renderingPath, graphicsPipeline, renderPass);
+		});
+		renderGraph.addPass("downsample", { { sceneColor, transferRead() }, { halfColor, transferWrite() } }, [this, sceneColor, halfColor](VkCommandBuffer commandBuffer) {
+			recordBlit(commandBuffer, sceneColor, halfColor);
+		});
+		renderGraph.addPass("upsample", { { halfColor, transferRead() }, { upscaledColor, transferWrite() } }, [this, halfColor, upscaledColor](VkCommandBuffer commandBuffer) {
+			recordBlit(commandBuffer, halfColor, upscaledColor);
+		});
+		renderGraph.addPass("present", { { upscaledColor, transferRead() }, { backbufferImage, transferWrite() } }, [this, upscaledColor](VkCommandBuffer commandBuffer) {
+			recordBlit(commandBuffer, upscaledColor, backbufferImage);
+		});
+
+		renderGraph.computeLifetimes();
+	}
+
+	void recordScenePass(VkCommandBuffer commandBuffer, RenderingPath path, VkPipeline pipeline, VkRenderPass scenePass) {
+		VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)swapChainExtent.width;
+		viewport.height = (float)swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = swapChainExtent;
+
+		if (path == RenderingPath::DynamicRendering) {
+			// the render graph already put the image into COLOR_ATTACHMENT_OPTIMAL
+			VkRenderingAttachmentInfo colorAttachment{};
+			colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+			colorAttachment.imageView = renderGraph.images[sceneColorImage].view;
+			colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+			colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			colorAttachment.clearValue = clearColor;
+
+			VkRenderingInfo renderingInfo{};
+			renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+			renderingInfo.renderArea.offset = { 0, 0 };
+			renderingInfo.renderArea.extent = swapChainExtent;
+			renderingInfo.layerCount = 1;
+			renderingInfo.colorAttachmentCount = 1;
+			renderingInfo.pColorAttachments = &colorAttachment;
+
+			vkCmdBeginRendering(commandBuffer, &renderingInfo);
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+			vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+			vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+			vkCmdEndRendering(commandBuffer);
+			return;
+		}
+
+		// note
+		auto& sceneColor = renderGraph.images[sceneColorImage];
+		std::vector<VkImageView> views = { sceneColor.view };
+		auto framebufferKey = makeFramebufferKey(scenePass, swapChainExtent, views, { sceneColor });
+
+		VkRenderPassAttachmentBeginInfo attachmentBeginInfo{};
+		attachmentBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_ATTACHMENT_BEGIN_INFO;
+		attachmentBeginInfo.attachmentCount = static_cast<uint32_t>(views.size());
+		attachmentBeginInfo.pAttachments = views.data();
+
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.pNext = imagelessFramebufferSupported ? &attachmentBeginInfo : nullptr;
+		renderPassInfo.renderPass = scenePass;
+		renderPassInfo.framebuffer = acquireFramebuffer(framebufferKey);
+		renderPassInfo.renderArea.offset = { 0, 0 };
+		renderPassInfo.renderArea.extent = swapChainExtent;
+		renderPassInfo.clearValueCount = 1;
+		renderPassInfo.pClearValues = &clearColor;
+
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+		vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+		vkCmdEndRenderPass(commandBuffer);
+	}
+
+	void recordBlit(VkCommandBuffer commandBuffer, uint32_t srcImageIndex, uint32_t dstImageIndex) {
+		auto& src = renderGraph.images[srcImageIndex];
+		auto& dst = renderGraph.images[dstImageIndex];
+
+		VkImageBlit blit{};
+		blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		blit.srcOffsets[1] = { static_cast<int32_t>(src.extent.width), static_cast<int32_t>(src.extent.height), 1 };
+		blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		blit.dstOffsets[1] = { static_cast<int32_t>(dst.extent.width), static_cast<int32_t>(dst.extent.height), 1 };
+		vkCmdBlitImage(commandBuffer, src.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			1, &blit, VK_FILTER_LINEAR);
+	}
+
+	uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+		auto vkGetPhysicalDeviceMemoryProperties = (PFN_vkGetPhysicalDeviceMemoryProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties");
+
+		VkPhysicalDeviceMemoryProperties memProperties;
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+			if ((typeFilter & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+
+		throw std::runtime_error("failed to find suitable memory type");
+	}
+
+	// Creates the transient images, places them into shared memory slots and compiles the barriers,
+	// which reference the final image handles.
+	void createRenderGraphResources() {
+		auto vkCreateImage = (PFN_vkCreateImage)vkGetDeviceProcAddr(device, "vkCreateImage");
+		auto vkGetImageMemoryRequirements = (PFN_vkGetImageMemoryRequirements)vkGetDeviceProcAddr(device, "vkGetImageMemoryRequirements");
+		auto vkAllocateMemory = (PFN_vkAllocateMemory)vkGetDeviceProcAddr(device, "vkAllocateMemory");
+		auto vkBindImageMemory = (PFN_vkBindImageMemory)vkGetDeviceProcAddr(device, "vkBindImageMemory");
+		auto vkCreateImageView = (PFN_vkCreateImageView)vkGetDeviceProcAddr(device, "vkCreateImageView");
+		vkDestroyImage = (PFN_vkDestroyImage)vkGetDeviceProcAddr(device, "vkDestroyImage");
+		vkFreeMemory = (PFN_vkFreeMemory)vkGetDeviceProcAddr(device, "vkFreeMemory");
+
+		VkDeviceSize unaliasedSize = 0;
+		for (auto& image : renderGraph.images) {
+			if (image.imported) {
+				continue;
+			}
+
+			VkImageCreateInfo imageInfo{};
+			imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageInfo.format = image.format;
+			imageInfo.extent = { image.extent.width, image.extent.height, 1 };
+			imageInfo.mipLevels = 1;
+			imageInfo.arrayLayers = 1;
+			imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageInfo.usage = image.usage;
+			imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			if (vkCreateImage(device, &imageInfo, nullptr, &image.image) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create render graph image: " + image.name);
+			}
+			vkGetImageMemoryRequirements(device, image.image, &image.memoryRequirements);
+			unaliasedSize += image.memoryRequirements.size;
+		}
+
+		renderGraph.assignMemorySlots();
+
+		VkDeviceSize aliasedSize = 0;
+		for (auto& slot : renderGraph.memorySlots) {
+			VkMemoryAllocateInfo allocInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			allocInfo.allocationSize = slot.size;
+			allocInfo.memoryTypeIndex = findMemoryType(slot.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			if (vkAllocateMemory(device, &allocInfo, nullptr, &slot.memory) != VK_SUCCESS) {
+				throw std::runtime_error("failed to allocate render graph memory");
+			}
+			for (auto imageIndex : slot.images) {
+				vkBindImageMemory(device, renderGraph.images[imageIndex].image, slot.memory, 0);
+			}
+			aliasedSize += slot.size;
+		}
+
+		for (auto& image : renderGraph.images) {
+			if (image.imported) {
+				continue;
+			}
+
+			VkImageViewCreateInfo viewInfo{};
+			viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			viewInfo.image = image.image;
+			viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			viewInfo.format = image.format;
+			viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			viewInfo.subresourceRange.baseMipLevel = 0;
+			viewInfo.subresourceRange.levelCount = 1;
+			viewInfo.subresourceRange.baseArrayLayer = 0;
+			viewInfo.subresourceRange.layerCount = 1;
+			if (vkCreateImageView(device, &viewInfo, nullptr, &image.view) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create render graph image view: " + image.name);
+			}
+		}
+
+		renderGraph.compileBarriers();
+
+		std::cout << "Render graph: " << renderGraph.passes.size() << " passes, " << renderGraph.barrierCount() << " image barriers" << std::endl;
+		for (auto& image : renderGraph.images) {
+			std::cout << "  " << image.name << ": passes [" << image.firstPass << ", " << image.lastPass << "]";
+			if (!image.imported) {
+				std::cout << ", memory slot " << image.memorySlot;
+			}
+			std::cout << std::endl;
+		}
+		std::cout << "  transient memory: " << aliasedSize / 1024 << " KB aliased, " << unaliasedSize / 1024 << " KB without aliasing" << std::endl;
+	}
+
+	void destroyRenderGraphResources() {
+		for (auto& image : renderGraph.images) {
+			if (!image.imported) {
+				vkDestroyImageView(device, image.view, nullptr);
+				vkDestroyImage(device, image.image, nullptr);
+			}
+		}
+		for (auto& slot : renderGraph.memorySlots) {
+			vkFreeMemory(device, slot.memory, nullptr);
+		}
+		renderGraph.memorySlots.clear();
+	}
+
+	// note
+	FramebufferKey makeFramebufferKey(VkRenderPass compatibleRenderPass, VkExtent2D extent, const std::vector<VkImageView>& views, const std::vector<RenderGraphImage>& images) const {
+		FramebufferKey key;
+		key.renderPass = compatibleRenderPass;
+		key.width = extent.width;
+		key.height = extent.height;
+		if (imagelessFramebufferSupported) {
+			for (auto& image : images) {
+				key.attachmentInfos.push_back({ image.usage, image.format });
+			}
+		}
+		else {
+			key.attachments = views;
+		}
+		return key;
+	}
+
+	VkFramebuffer acquireFramebuffer(const FramebufferKey& key) {
+		auto cached = framebufferCache.find(key);
+		if (cached != framebufferCache.end()) {
+			framebufferCacheStats.hits++;
+			return cached->second;
+		}
+		framebufferCacheStats.misses++;
+		auto created = createFramebuffer(key);
+		framebufferCache.emplace(key, created);
+		return created;
+	}
+
+	// Drops every framebuffer that references one of the views, they are about to be destroyed, every framebuffer
+	// of another extent and every one whose render pass is no longer cached. Imageless framebuffers reference no
+	// views, the extent is what retires them.
+	void evictFramebuffers(const std::vector<VkImageView>& retiredViews, VkExtent2D extent) {
+		for (auto it = framebufferCache.begin(); it != framebufferCache.end();) {
+			bool retired = std::any_of(it->first.attachments.begin(), it->first.attachments.end(), [&](VkImageView view) {
+				return std::find(retiredViews.begin(), retiredViews.end(), view) != retiredViews.end();
+			});
+			retired |= it->first.width != extent.width || it->first.height != extent.height;
+			retired |= std::none_of(renderPassCache.begin(), renderPassCache.end(), [&](auto& cachedRenderPass) {
+				return cachedRenderPass.second == it->first.renderPass;
+			});
+			if (retired) {
+				vkDestroyFramebuffer(device, it->second, nullptr);
+				it = framebufferCache.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+	}
+
+	VkFramebuffer createFramebuffer(const FramebufferKey& key) {
+		auto vkCreateFramebuffer = (PFN_vkCreateFramebuffer)vkGetDeviceProcAddr(device, "vkCreateFramebuffer");
+		vkDestroyFramebuffer = (PFN_vkDestroyFramebuffer)vkGetDeviceProcAddr(device, "vkDestroyFramebuffer");
+
+		std::vector<VkFramebufferAttachmentImageInfo> attachmentImageInfos;
+		for (auto& info : key.attachmentInfos) {
+			VkFramebufferAttachmentImageInfo imageInfo{};
+			imageInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENT_IMAGE_INFO;
+			imageInfo.usage = info.usage;
+			imageInfo.width = key.width;
+			imageInfo.height = key.height;
+			imageInfo.layerCount = 1;
+			imageInfo.viewFormatCount = 1;
+			imageInfo.pViewFormats = &info.format;
+			attachmentImageInfos.push_back(imageInfo);
+		}
+		VkFramebufferAttachmentsCreateInfo attachmentsInfo{};
+		attachmentsInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_ATTACHMENTS_CREATE_INFO;
+		attachmentsInfo.attachmentImageInfoCount = static_cast<uint32_t>(attachmentImageInfos.size());
+		attachmentsInfo.pAttachmentImageInfos = attachmentImageInfos.data();
+
+		VkFramebufferCreateInfo framebufferInfo{};
+		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferInfo.renderPass = key.renderPass;
+		if (!key.attachmentInfos.empty()) {
+			framebufferInfo.pNext = &attachmentsInfo;
+			framebufferInfo.flags = VK_FRAMEBUFFER_CREATE_IMAGELESS_BIT;
+			framebufferInfo.attachmentCount = static_cast<uint32_t>(attachmentImageInfos.size());
+		}
+		else {
+			framebufferInfo.attachmentCount = static_cast<uint32_t>(key.attachments.size());
+			framebufferInfo.pAttachments = key.attachments.data();
+		}
+		framebufferInfo.width = key.width;
+		framebufferInfo.height = key.height;
+		framebufferInfo.layers = 1;
+
+		VkFramebuffer framebuffer = nullptr;
+		if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &framebuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create framebuffer");
+		}
+		return framebuffer;
+	}
+
+	void createCommandPool() {
+		auto vkCreateCommandPool = (PFN_vkCreateCommandPool)vkGetDeviceProcAddr(device, "vkCreateCommandPool");
+
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create command pool");
+		}
+
+		vkDestroyCommandPool = (PFN_vkDestroyCommandPool)vkGetDeviceProcAddr(device, "vkDestroyCommandPool");
+	}
+
+	void createCommandBuffers() {
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+
+		commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+		if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate command buffers");
+		}
+
+		vkBeginCommandBuffer = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(device, "vkBeginCommandBuffer");
+		vkEndCommandBuffer = (PFN_vkEndCommandBuffer)vkGetDeviceProcAddr(device, "vkEndCommandBuffer");
+		vkResetCommandBuffer = (PFN_vkResetCommandBuffer)vkGetDeviceProcAddr(device, "vkResetCommandBuffer");
+		vkCmdBeginRenderPass = (PFN_vkCmdBeginRenderPass)vkGetDeviceProcAddr(device, "vkCmdBeginRenderPass");
+		vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass)vkGetDeviceProcAddr(device, "vkCmdEndRenderPass");
+		vkCmdBindPipeline = (PFN_vkCmdBindPipeline)vkGetDeviceProcAddr(device, "vkCmdBindPipeline");
+		vkCmdDraw = (PFN_vkCmdDraw)vkGetDeviceProcAddr(device, "vkCmdDraw");
+		vkCmdBlitImage = (PFN_vkCmdBlitImage)vkGetDeviceProcAddr(device, "vkCmdBlitImage");
+		vkCmdPipelineBarrier2 = (PFN_vkCmdPipelineBarrier2)vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2");
+		vkCmdSetViewport = (PFN_vkCmdSetViewport)vkGetDeviceProcAddr(device, "vkCmdSetViewport");
+		vkCmdSetScissor = (PFN_vkCmdSetScissor)vkGetDeviceProcAddr(device, "vkCmdSetScissor");
+		if (!vkCmdPipelineBarrier2) {
+			vkCmdPipelineBarrier2 = (PFN_vkCmdPipelineBarrier2)vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2KHR");
+		}
+		// note
+		if (dynamicRenderingSupported) {
+			vkCmdBeginRendering = (PFN_vkCmdBeginRendering)vkGetDeviceProcAddr(device, "vkCmdBeginRendering");
+			vkCmdEndRendering = (PFN_vkCmdEndRendering)vkGetDeviceProcAddr(device, "vkCmdEndRendering");
+			if (!vkCmdBeginRendering) {
+				vkCmdBeginRendering = (PFN_vkCmdBeginRendering)vkGetDeviceProcAddr(device, "vkCmdBeginRenderingKHR");
+				vkCmdEndRendering = (PFN_vkCmdEndRendering)vkGetDeviceProcAddr(device, "vkCmdEndRenderingKHR");
+			}
+		}
+	}
+
+	void createSyncObjects() {
+		auto vkCreateSemaphore = (PFN_vkCreateSemaphore)vkGetDeviceProcAddr(device, "vkCreateSemaphore");
+		auto vkCreateFence = (PFN_vkCreateFence)vkGetDeviceProcAddr(device, "vkCreateFence");
+
+		imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+		inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
+				vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a frame");
+			}
+		}
+		createRenderFinishedSemaphores();
+
+		vkDestroySemaphore = (PFN_vkDestroySemaphore)vkGetDeviceProcAddr(device, "vkDestroySemaphore");
+		vkDestroyFence = (PFN_vkDestroyFence)vkGetDeviceProcAddr(device, "vkDestroyFence");
+		vkWaitForFences = (PFN_vkWaitForFences)vkGetDeviceProcAddr(device, "vkWaitForFences");
+		vkResetFences = (PFN_vkResetFences)vkGetDeviceProcAddr(device, "vkResetFences");
+		vkAcquireNextImageKHR = (PFN_vkAcquireNextImageKHR)vkGetDeviceProcAddr(device, "vkAcquireNextImageKHR");
+		vkQueueSubmit = (PFN_vkQueueSubmit)vkGetDeviceProcAddr(device, "vkQueueSubmit");
+		vkQueuePresentKHR = (PFN_vkQueuePresentKHR)vkGetDeviceProcAddr(device, "vkQueuePresentKHR");
+		vkDeviceWaitIdle = (PFN_vkDeviceWaitIdle)vkGetDeviceProcAddr(device, "vkDeviceWaitIdle");
+	}
+
+	// note
+	// Measures the CPU side only: pipeline creation, and recording the scene pass into a command buffer that
+	// is never submitted. The render pass path includes the cache lookups of its render pass and framebuffer.
+	void benchmarkRenderingPaths() {
+		if (!dynamicRenderingSupported) {
+			std::cout << "Rendering path benchmark skipped: dynamic rendering not supported" << std::endl;
+			return;
+		}
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+		auto vkFreeCommandBuffers = (PFN_vkFreeCommandBuffers)vkGetDeviceProcAddr(device, "vkFreeCommandBuffers");
+
+		auto benchmarkRenderPass = acquireRenderPass(sceneRenderPassKey());
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+		VkCommandBuffer commandBuffer = nullptr;
+		if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate benchmark command buffer");
+		}
+
+		struct PathResult {
+			double pipelineMicroseconds = 0.0;
+			double recordNanoseconds = 0.0;
+		};
+		auto measure = [&](RenderingPath path, VkRenderPass scenePass) {
+			PathResult pathResult;
+
+			std::vector<VkPipeline> pipelines(PIPELINE_BENCHMARK_ITERATIONS);
+			auto start = std::chrono::steady_clock::now();
+			for (auto& pipeline : pipelines) {
+				pipeline = createScenePipeline(scenePass);
+			}
+			auto end = std::chrono::steady_clock::now();
+			pathResult.pipelineMicroseconds = std::chrono::duration<double, std::micro>(end - start).count() / PIPELINE_BENCHMARK_ITERATIONS;
+
+			VkCommandBufferBeginInfo beginInfo{};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			vkResetCommandBuffer(commandBuffer, 0);
+			if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+				throw std::runtime_error("failed to begin recording benchmark command buffer");
+			}
+			start = std::chrono::steady_clock::now();
+			for (uint32_t i = 0; i < RECORDING_BENCHMARK_ITERATIONS; i++) {
+				recordScenePass(commandBuffer, path, pipelines[i % pipelines.size()], scenePass);
+			}
+			end = std::chrono::steady_clock::now();
+			vkEndCommandBuffer(commandBuffer);
+			pathResult.recordNanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / RECORDING_BENCHMARK_ITERATIONS;
+
+			for (auto pipeline : pipelines) {
+				vkDestroyPipeline(device, pipeline, nullptr);
+			}
+			return pathResult;
+		};
+
+		auto renderPassResult = measure(RenderingPath::RenderPass, benchmarkRenderPass);
+		auto dynamicResult = measure(RenderingPath::DynamicRendering, nullptr);
+
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+
+		std::cout << "Rendering path benchmark (" << PIPELINE_BENCHMARK_ITERATIONS << " pipelines, " << RECORDING_BENCHMARK_ITERATIONS << " recorded passes):" << std::endl;
+		std::cout << "  render pass      : pipeline creation " << renderPassResult.pipelineMicroseconds << " us, recording " << renderPassResult.recordNanoseconds << " ns/pass" << std::endl;
+		std::cout << "  dynamic rendering: pipeline creation " << dynamicResult.pipelineMicroseconds << " us, recording " << dynamicResult.recordNanoseconds << " ns/pass" << std::endl;
+	}
+
+	void createRenderFinishedSemaphores() {
+		auto vkCreateSemaphore = (PFN_vkCreateSemaphore)vkGetDeviceProcAddr(device, "vkCreateSemaphore");
+
+		// presentation may hold on to the semaphore until the image is reacquired, so one per image
+		renderFinishedSemaphores.resize(swapChainImages.size());
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		for (size_t i = 0; i < renderFinishedSemaphores.size(); i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a swap chain image");
+			}
+		}
+	}
+
+	// note
+	void reportObjectCaches(const char* reason) {
+		std::cout << "Object caches after " << reason << ": "
+			<< renderPassCache.size() << " render passes (" << renderPassCacheStats.hits << " hits, " << renderPassCacheStats.misses << " misses), "
+			<< framebufferCache.size() << " framebuffers (" << framebufferCacheStats.hits << " hits, " << framebufferCacheStats.misses << " misses)" << std::endl;
+	}
+
+	void issueBarriers(VkCommandBuffer commandBuffer, std::vector<RenderGraphBarrier>& barriers) {
+		if (barriers.empty()) {
+			return;
+		}
+		std::vector<VkImageMemoryBarrier2> imageBarriers;
+		imageBarriers.reserve(barriers.size());
+		for (auto& barrier : barriers) {
+			imageBarriers.push_back(barrier.barrier);
+			imageBarriers.back().image = renderGraph.images[barrier.imageIndex].image;
+		}
+
+		VkDependencyInfo dependencyInfo{};
+		dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+		dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size());
+		dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+		vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+	}
+
+	void executeRenderGraph(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+		renderGraph.images[backbufferImage].image = swapChainImages[imageIndex];
+		renderGraph.images[backbufferImage].view = swapChainImageViews[imageIndex];
+
+		for (auto& pass : renderGraph.passes) {
+			issueBarriers(commandBuffer, pass.barriers);
+			pass.record(commandBuffer);
+		}
+		issueBarriers(commandBuffer, renderGraph.finalBarriers);
+	}
+
+	void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording command buffer");
+		}
+
+		executeRenderGraph(commandBuffer, imageIndex);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record command buffer");
+		}
+	}
+
+	void drawFrame() {
+		vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+
+		uint32_t imageIndex = 0;
+		auto result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		// note
+		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+			recreateSwapChain();
+			return;
+		}
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to acquire swap chain image");
+		}
+		vkResetFences(device, 1, &inFlightFences[currentFrame]);
+
+		vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+		recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+
+		// the first barrier on the backbuffer uses the same stage, TRANSFER has the same bit in both flag types
+		VkPipelineStageFlags waitStage = static_cast<VkPipelineStageFlags>(renderGraph.images[backbufferImage].importStageMask);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &imageAvailableSemaphores[currentFrame];
+		submitInfo.pWaitDstStageMask = &waitStage;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &renderFinishedSemaphores[imageIndex];
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit draw command buffer");
+		}
+
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinishedSemaphores[imageIndex];
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &swapChain;
+		presentInfo.pImageIndices = &imageIndex;
+		result = vkQueuePresentKHR(presentQueue, &presentInfo);
+		// note
+		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) {
+			framebufferResized = false;
+			recreateSwapChain();
+		}
+		else if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to present swap chain image");
+		}
+
+		currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	}
+
+
+	VkShaderModule createShaderModule(const std::vector<char>& code) {
+		VkShaderModuleCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = code.size();
+		createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+		auto vkCreateShaderModule = (PFN_vkCreateShaderModule)vkGetInstanceProcAddr(instance, "vkCreateShaderModule");
+		VkShaderModule shaderModule;
+		if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create shader module");
+		}
+
+		return shaderModule;
+	}
+
+
+	static std::vector<char> readFile(const std::string& filename) {
+		std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to open file");
+		}
+
+		size_t fileSize = (size_t)file.tellg();
+		std::vector<char> buffer(fileSize);
+
+		file.seekg(0);
+		file.read(buffer.data(), fileSize);
+
+		file.close();
+		return buffer;
+	}
+
+
+};
+
+int main() {
+	HelloTriangleApplication app;
+
+	try {
+		app.run();
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,2271 @@
+#define GLFW_INCLUDE_VULKAN
+#define VK_NO_PROTOTYPES
+#include "config.h"
+#include <GLFW/glfw3.h>
+#include <vulkan/vulkan.h>
+#include <vulkan/vulkan.hpp>
+// note
+#include <glm/glm.hpp>
+
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <optional>
+#include <set>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+// note
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstddef>
+// note
+#include <functional>
+
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback2(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer2: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+
+inline auto findExtensionProperties(const std::vector<VkExtensionProperties>& extensionProps, const char* name) {
+	for (auto& extensionProp : extensionProps) {
+		if (strcmp(extensionProp.extensionName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findLayerProperties(const std::vector<VkLayerProperties>& layerProps, const char* name) {
+	for (auto& layerProp : layerProps) {
+		if (strcmp(layerProp.layerName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findQueueFamilyIndices(const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			indices.push_back(i);
+		}
+	}
+	return indices;
+}
+inline auto findQueueFamilyIndices(
+	VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR,
+	const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			if (!surface) {
+				indices.push_back(i);
+			}
+			else {
+				VkBool32 presentSupport = false;
+				vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+				if (presentSupport) {
+					indices.push_back(i);
+				}
+			}
+		}
+	}
+	return indices;
+}
+
+struct SwapChainSupportDetails {
+	VkSurfaceCapabilitiesKHR        capabilities;
+	std::vector<VkSurfaceFormatKHR> formats;
+	std::vector<VkPresentModeKHR>   presentModes;
+};
+
+struct QueueFamilyIndices {
+	std::optional<uint32_t> graphicsFamily;
+	std::optional<uint32_t> presentFamily;
+	// note
+	std::optional<uint32_t> transferFamily;
+	// note
+	std::optional<uint32_t> computeFamily;
+
+	bool isComplete()
+	{
+		return graphicsFamily.has_value() && presentFamily.has_value();
+	}
+	// note
+	bool hasDedicatedTransfer() const
+	{
+		return transferFamily.has_value() && transferFamily != graphicsFamily;
+	}
+	// note
+	bool hasDedicatedCompute() const
+	{
+		return computeFamily.has_value() && computeFamily != graphicsFamily;
+	}
+};
+
+// note
+struct Vertex {
+	glm::vec2 pos;
+	glm::vec3 color;
+
+	static VkVertexInputBindingDescription getBindingDescription() {
+		VkVertexInputBindingDescription bindingDescription{};
+		bindingDescription.binding = 0;
+		bindingDescription.stride = sizeof(Vertex);
+		bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+		return bindingDescription;
+	}
+
+	static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
+		std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+		attributeDescriptions[0].binding = 0;
+		attributeDescriptions[0].location = 0;
+		attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+		attributeDescriptions[0].offset = offsetof(Vertex, pos);
+		attributeDescriptions[1].binding = 0;
+		attributeDescriptions[1].location = 1;
+		attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+		attributeDescriptions[1].offset = offsetof(Vertex, color);
+		return attributeDescriptions;
+	}
+};
+
+// note
+// Persistently mapped staging memory shared by every frame in flight.
+// head and tail are monotonically increasing byte counters, the offset in the buffer is counter % size.
+// A region becomes reusable once tail has moved past it, i.e. once the frame that consumed it retired.
+struct UploadRing {
+	VkBuffer                 buffer = nullptr;
+	VkDeviceMemory           memory = nullptr;
+	char*                    mapped = nullptr;
+	VkDeviceSize               size = 0;
+	VkDeviceSize               head = 0;
+	VkDeviceSize               tail = 0;
+
+	std::optional<VkDeviceSize> allocate(VkDeviceSize bytes, VkDeviceSize alignment) {
+		auto begin = (head + alignment - 1) / alignment * alignment;
+		auto offset = begin % size;
+		if (offset + bytes > size) {
+			// a region never straddles the end of the buffer
+			begin += size - offset;
+			offset = 0;
+		}
+		if (begin + bytes - tail > size) {
+			return std::nullopt;
+		}
+		head = begin + bytes;
+		return offset;
+	}
+};
+
+// note
+struct Particle {
+	glm::vec2 position;
+	glm::vec2 velocity;
+	glm::vec4 color;
+
+	static VkVertexInputBindingDescription getBindingDescription() {
+		VkVertexInputBindingDescription bindingDescription{};
+		bindingDescription.binding = 0;
+		bindingDescription.stride = sizeof(Particle);
+		bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+		return bindingDescription;
+	}
+
+	static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() {
+		std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+		attributeDescriptions[0].binding = 0;
+		attributeDescriptions[0].location = 0;
+		attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+		attributeDescriptions[0].offset = offsetof(Particle, position);
+		attributeDescriptions[1].binding = 0;
+		attributeDescriptions[1].location = 1;
+		attributeDescriptions[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+		attributeDescriptions[1].offset = offsetof(Particle, color);
+		return attributeDescriptions;
+	}
+};
+
+// note
+struct SimulationParams {
+	float    deltaTime;
+	uint32_t particleCount;
+	uint32_t substeps;
+	uint32_t reset;
+};
+
+// note
+// A unit of compute work (culling, post-processing, simulation) handed to the scheduler.
+// record() only writes commands, the scheduler decides which queue the pass runs on.
+struct ComputePass {
+	const char*                          name;
+	std::function<void(VkCommandBuffer)> record;
+};
+
+// note
+struct PendingOwnershipTransfer {
+	VkBuffer                 buffer;
+	VkAccessFlags     dstAccessMask;
+	VkPipelineStageFlags dstStageMask;
+};
+
+const uint32_t WIDTH = 800;
+const uint32_t HEIGHT = 600;
+
+// note
+const int MAX_FRAMES_IN_FLIGHT = 2;
+const VkDeviceSize UPLOAD_RING_SIZE = 64ull << 20;
+// Bulk payload streamed with every frame to keep the transfer queue busy.
+const VkDeviceSize STREAM_PAYLOAD_SIZE = 16ull << 20;
+// The triangle lives in front of the payload inside the same stream buffer.
+const VkDeviceSize STREAM_VERTEX_REGION_SIZE = 256;
+
+// note
+const uint32_t PARTICLE_COUNT = 256 * 1024;
+const uint32_t SIMULATION_SUBSTEPS = 64;
+const uint32_t BENCHMARK_WARMUP_FRAMES = 60;
+const uint32_t BENCHMARK_FRAMES = 300;
+
+class HelloTriangleApplication {
+public:
+	void run() {
+		initWindow();
+		initVulkan();
+		mainLoop();
+		cleanup();
+	}
+
+private:
+	GLFWwindow* window = nullptr;
+	VkInstance                             instance = nullptr;
+	VkPhysicalDevice                 physicalDevice = nullptr;
+	VkDevice                                 device = nullptr;
+	VkSurfaceKHR                            surface = nullptr;
+	VkQueue                           graphicsQueue = nullptr;
+	VkQueue                            presentQueue = nullptr;
+	VkSwapchainKHR                        swapChain = nullptr;
+	std::vector<VkImage>            swapChainImages;
+	VkFormat                   swapChainImageFormat;
+	VkExtent2D                      swapChainExtent;
+	std::vector<VkImageView>    swapChainImageViews;
+
+	VkShaderModule                 vertShaderModule = nullptr;
+	VkShaderModule                 fragShaderModule = nullptr;
+
+	VkPipelineLayout                 pipelineLayout = nullptr;
+
+	PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = nullptr;
+	PFN_vkGetDeviceProcAddr     vkGetDeviceProcAddr = nullptr;
+	PFN_vkDestroyInstance         vkDestroyInstance = nullptr;
+	PFN_vkDestroyDevice             vkDestroyDevice = nullptr;
+	PFN_vkDestroySurfaceKHR	    vkDestroySurfaceKHR = nullptr;
+	PFN_vkDestroySwapchainKHR vkDestroySwapchainKHR = nullptr;
+	PFN_vkDestroyImageView	     vkDestroyImageView = nullptr;
+	PFN_vkDestroyShaderModule vkDestroyShaderModule = nullptr;
+	PFN_vkDestroyPipelineLayout vkDestroyPipelineLayout;
+
+	// note
+	VkRenderPass                         renderPass = nullptr;
+	PFN_vkDestroyRenderPass     vkDestroyRenderPass;
+	VkPipeline                     graphicsPipeline = nullptr;
+	PFN_vkDestroyPipeline         vkDestroyPipeline;
+
+	// note
+	QueueFamilyIndices           queueFamilyIndices;
+	VkQueue                           transferQueue = nullptr;
+	std::vector<VkFramebuffer>  swapChainFramebuffers;
+	VkCommandPool                       commandPool = nullptr;
+	VkCommandPool               transferCommandPool = nullptr;
+	std::vector<VkCommandBuffer>       commandBuffers;
+	std::vector<VkCommandBuffer> uploadCommandBuffers;
+	std::vector<VkSemaphore> imageAvailableSemaphores;
+	std::vector<VkSemaphore> renderFinishedSemaphores;
+	std::vector<VkSemaphore> uploadFinishedSemaphores;
+	std::vector<VkFence>               inFlightFences;
+	uint32_t                           currentFrame = 0;
+
+	UploadRing                           uploadRing;
+	VkDeviceSize             uploadOffsetAlignment = 16;
+	std::vector<VkDeviceSize>        uploadRingMarks;
+	bool                            uploadRecording = false;
+	std::vector<PendingOwnershipTransfer> pendingReleases;
+	std::vector<PendingOwnershipTransfer> pendingAcquires;
+	VkPipelineStageFlags           uploadWaitStages = 0;
+
+	std::vector<VkBuffer>             streamBuffers;
+	std::vector<VkDeviceMemory> streamBufferMemories;
+	std::vector<char>                 streamPayload;
+	VkDeviceSize                   uploadedBytes = 0;
+	uint64_t                      uploadedFrames = 0;
+	std::chrono::steady_clock::time_point uploadReportTime;
+
+	PFN_vkDestroyFramebuffer     vkDestroyFramebuffer = nullptr;
+	PFN_vkDestroyCommandPool     vkDestroyCommandPool = nullptr;
+	PFN_vkDestroySemaphore         vkDestroySemaphore = nullptr;
+	PFN_vkDestroyFence                 vkDestroyFence = nullptr;
+	PFN_vkDestroyBuffer               vkDestroyBuffer = nullptr;
+	PFN_vkFreeMemory                     vkFreeMemory = nullptr;
+	PFN_vkUnmapMemory                   vkUnmapMemory = nullptr;
+	PFN_vkDeviceWaitIdle             vkDeviceWaitIdle = nullptr;
+	PFN_vkWaitForFences               vkWaitForFences = nullptr;
+	PFN_vkResetFences                   vkResetFences = nullptr;
+	PFN_vkAcquireNextImageKHR   vkAcquireNextImageKHR = nullptr;
+	PFN_vkQueueSubmit                   vkQueueSubmit = nullptr;
+	PFN_vkQueuePresentKHR           vkQueuePresentKHR = nullptr;
+	PFN_vkBeginCommandBuffer     vkBeginCommandBuffer = nullptr;
+	PFN_vkEndCommandBuffer         vkEndCommandBuffer = nullptr;
+	PFN_vkResetCommandBuffer     vkResetCommandBuffer = nullptr;
+	PFN_vkCmdBeginRenderPass     vkCmdBeginRenderPass = nullptr;
+	PFN_vkCmdEndRenderPass         vkCmdEndRenderPass = nullptr;
+	PFN_vkCmdBindPipeline           vkCmdBindPipeline = nullptr;
+	PFN_vkCmdBindVertexBuffers vkCmdBindVertexBuffers = nullptr;
+	PFN_vkCmdDraw                           vkCmdDraw = nullptr;
+	PFN_vkCmdCopyBuffer               vkCmdCopyBuffer = nullptr;
+	PFN_vkCmdPipelineBarrier     vkCmdPipelineBarrier = nullptr;
+
+	// note
+	VkQueue                            computeQueue = nullptr;
+	VkCommandPool                computeCommandPool = nullptr;
+	std::vector<VkCommandBuffer> computeCommandBuffers;
+	std::vector<uint64_t>           computeSlotValues;
+	VkSemaphore                     computeTimeline = nullptr;
+	VkSemaphore                    graphicsTimeline = nullptr;
+	uint64_t                   computeTimelineValue = 0;
+	uint64_t                  graphicsTimelineValue = 0;
+	uint64_t                      lastComputeValue = 0;
+	bool                       asyncComputeEnabled = false;
+	uint64_t                          frameCounter = 0;
+
+	std::array<VkBuffer, 2>          particleBuffers = {};
+	std::array<VkDeviceMemory, 2> particleBufferMemories = {};
+	VkDescriptorSetLayout computeDescriptorSetLayout = nullptr;
+	VkDescriptorPool          computeDescriptorPool = nullptr;
+	std::array<VkDescriptorSet, 2> particleDescriptorSets = {};
+	VkShaderModule              computeShaderModule = nullptr;
+	VkPipelineLayout          computePipelineLayout = nullptr;
+	VkPipeline                      computePipeline = nullptr;
+	VkShaderModule         particleVertShaderModule = nullptr;
+	VkPipeline                     particlePipeline = nullptr;
+
+	enum class BenchmarkPhase { Warmup, Serial, Async, Done };
+	BenchmarkPhase                   benchmarkPhase = BenchmarkPhase::Done;
+	uint32_t                    benchmarkFrameCount = 0;
+	double                         serialFrameTime = 0.0;
+	std::chrono::steady_clock::time_point benchmarkStartTime;
+
+	PFN_vkDestroyDescriptorSetLayout vkDestroyDescriptorSetLayout = nullptr;
+	PFN_vkDestroyDescriptorPool   vkDestroyDescriptorPool = nullptr;
+	PFN_vkWaitSemaphores                 vkWaitSemaphores = nullptr;
+	PFN_vkCmdDispatch                       vkCmdDispatch = nullptr;
+	PFN_vkCmdBindDescriptorSets   vkCmdBindDescriptorSets = nullptr;
+	PFN_vkCmdPushConstants             vkCmdPushConstants = nullptr;
+
+#ifndef NDEBUG
+	VkDebugUtilsMessengerEXT         debugMessenger = nullptr;
+	PFN_vkDestroyDebugUtilsMessengerEXT vkDestroyDebugUtilsMessengerEXT = nullptr;
+#endif
+
+	void initWindow() {
+		glfwInit();
+
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+
+		window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan", nullptr, nullptr);
+	}
+
+	void initVulkan() {
+		initInstance();
+		createSurface();
+		selectPhysicalDevice();
+		initDevice();
+		createSwapChain();
+		createImageViews();
+		// note
+		createRenderPass();
+		createGraphicsPipeline();
+		// note
+		createFramebuffers();
+		createCommandPools();
+		createCommandBuffers();
+		createSyncObjects();
+		createUploadRing();
+		createStreamBuffers();
+		// note
+		createParticleBuffers();
+		createComputePipeline();
+		createParticlePipeline();
+		startComputeBenchmark();
+	}
+
+	void mainLoop() {
+		// note
+		uploadReportTime = std::chrono::steady_clock::now();
+		while (!glfwWindowShouldClose(window)) {
+			glfwPollEvents();
+			drawFrame();
+		}
+
+		vkDeviceWaitIdle(device);
+	}
+
+	void cleanup() {
+
+		// note
+		if (vkDestroyPipeline) {
+			vkDestroyPipeline(device, particlePipeline, nullptr);
+			vkDestroyPipeline(device, computePipeline, nullptr);
+		}
+		if (vkDestroyPipelineLayout) {
+			vkDestroyPipelineLayout(device, computePipelineLayout, nullptr);
+		}
+		if (vkDestroyShaderModule) {
+			vkDestroyShaderModule(device, particleVertShaderModule, nullptr);
+			vkDestroyShaderModule(device, computeShaderModule, nullptr);
+		}
+		if (vkDestroyDescriptorPool) {
+			vkDestroyDescriptorPool(device, computeDescriptorPool, nullptr);
+		}
+		if (vkDestroyDescriptorSetLayout) {
+			vkDestroyDescriptorSetLayout(device, computeDescriptorSetLayout, nullptr);
+		}
+		for (size_t i = 0; i < particleBuffers.size(); i++) {
+			if (particleBuffers[i]) {
+				vkDestroyBuffer(device, particleBuffers[i], nullptr);
+				vkFreeMemory(device, particleBufferMemories[i], nullptr);
+			}
+		}
+		if (vkDestroySemaphore) {
+			vkDestroySemaphore(device, computeTimeline, nullptr);
+			vkDestroySemaphore(device, graphicsTimeline, nullptr);
+		}
+		if (vkDestroyCommandPool) {
+			vkDestroyCommandPool(device, computeCommandPool, nullptr);
+		}
+
+		for (size_t i = 0; i < streamBuffers.size(); i++) {
+			vkDestroyBuffer(device, streamBuffers[i], nullptr);
+			vkFreeMemory(device, streamBufferMemories[i], nullptr);
+		}
+		if (uploadRing.buffer) {
+			vkUnmapMemory(device, uploadRing.memory);
+			vkDestroyBuffer(device, uploadRing.buffer, nullptr);
+			vkFreeMemory(device, uploadRing.memory, nullptr);
+		}
+		for (auto semaphore : imageAvailableSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto semaphore : renderFinishedSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto semaphore : uploadFinishedSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto fence : inFlightFences) {
+			vkDestroyFence(device, fence, nullptr);
+		}
+		if (vkDestroyCommandPool) {
+			vkDestroyCommandPool(device, transferCommandPool, nullptr);
+			vkDestroyCommandPool(device, commandPool, nullptr);
+		}
+		for (auto framebuffer : swapChainFramebuffers) {
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+		}
+
+		// note
+		if (vkDestroyPipeline) {
+			vkDestroyPipeline(device, graphicsPipeline, nullptr);
+		}
+
+		if (vkDestroyPipelineLayout) {
+			vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+		}
+
+		// note
+		if (vkDestroyRenderPass) {
+			vkDestroyRenderPass(device, renderPass, nullptr);
+		}
+
+		if (vkDestroyShaderModule) {
+			vkDestroyShaderModule(device, vertShaderModule, nullptr);
+			vkDestroyShaderModule(device, fragShaderModule, nullptr);
+		}
+
+		for (auto imageView : swapChainImageViews) {
+			vkDestroyImageView(device, imageView, nullptr);
+		}
+
+		vkDestroySwapchainKHR(device, swapChain, nullptr);
+		if (vkDestroyDevice) {
+			vkDestroyDevice(device, nullptr);
+
+		}
+#ifndef NDEBUG
+		if (vkDestroyDebugUtilsMessengerEXT) {
+			vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+		}
+#endif
+		if (vkDestroyInstance) {
+			vkDestroySurfaceKHR(instance, surface, nullptr);
+			vkDestroyInstance(instance, nullptr);
+		}
+		glfwDestroyWindow(window);
+
+		glfwTerminate();
+	}
+
+	void initInstance() {
+		vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)glfwGetInstanceProcAddress(nullptr, "vkGetInstanceProcAddr");
+		auto vkEnumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+		auto vkEnumerateInstanceExtensionProperties = (PFN_vkEnumerateInstanceExtensionProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceExtensionProperties");
+		auto vkEnumerateInstanceLayerProperties = (PFN_vkEnumerateInstanceLayerProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceLayerProperties");
+		auto vkCreateInstance = (PFN_vkCreateInstance)vkGetInstanceProcAddr(nullptr, "vkCreateInstance");
+
+		uint32_t supportedVersion = 0u;
+		VkResult result = vkEnumerateInstanceVersion(&supportedVersion);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Version: " << VK_VERSION_MAJOR(supportedVersion) << "." << VK_VERSION_MINOR(supportedVersion) << "." << VK_VERSION_PATCH(supportedVersion) << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to enumerate instance version");
+		}
+
+		auto requestInstanceVersion = 0u;
+		if (supportedVersion >= VK_API_VERSION_1_3) {
+			requestInstanceVersion = VK_API_VERSION_1_3;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_2) {
+			requestInstanceVersion = VK_API_VERSION_1_2;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_1) {
+			requestInstanceVersion = VK_API_VERSION_1_1;
+		}
+		else {
+			requestInstanceVersion = VK_API_VERSION_1_0;
+		}
+
+		VkApplicationInfo  appInfo = {};
+		appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+		appInfo.pApplicationName = "Hello Triangle";
+		appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.pEngineName = "No Engine";
+		appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.apiVersion = requestInstanceVersion;
+		appInfo.pNext = nullptr;
+
+		uint32_t        extensionCount = 0;
+		auto ppExtensioNames = glfwGetRequiredInstanceExtensions(&extensionCount);
+
+		std::vector<const char*> requestedInstanceExtensions = std::vector<const char*>(ppExtensioNames, ppExtensioNames + extensionCount);
+#ifndef NDEBUG
+		requestedInstanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+#endif
+		std::vector<const char*> requestedInstanceLayers = {
+			//	"VK_LAYER_LUNARG_api_dump"
+		};
+#ifndef NDEBUG
+		requestedInstanceLayers.push_back("VK_LAYER_KHRONOS_validation");
+#endif		
+
+		std::vector<const char*> enabledInstanceExtensions;
+		std::vector<const char*> enabledInstanceLayers;
+
+		auto instanceExtensionPropCount = 0u;
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(instanceExtensionPropCount);
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, extensionProps.data());
+
+		auto instanceLayerPropCount = 0u;
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, nullptr);
+		std::vector<VkLayerProperties> layerProps(instanceLayerPropCount);
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, layerProps.data());
+
+		for (auto& requestedInstanceExtension : requestedInstanceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedInstanceExtension)) {
+				throw std::runtime_error("failed to find instance extension: " + std::string(requestedInstanceExtension));
+			}
+		}
+		for (auto& requestedInstanceLayer : requestedInstanceLayers) {
+			if (!findLayerProperties(layerProps, requestedInstanceLayer)) {
+				throw std::runtime_error("failed to find instance layer: " + std::string(requestedInstanceLayer));
+			}
+		}
+
+		enabledInstanceExtensions = requestedInstanceExtensions;
+		enabledInstanceLayers = requestedInstanceLayers;
+
+		VkInstanceCreateInfo createInfo = {};
+		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+		createInfo.pApplicationInfo = &appInfo;
+		createInfo.enabledExtensionCount = enabledInstanceExtensions.size();
+		createInfo.ppEnabledExtensionNames = enabledInstanceExtensions.data();
+		createInfo.enabledLayerCount = enabledInstanceLayers.size();
+		createInfo.ppEnabledLayerNames = enabledInstanceLayers.data();
+
+		result = vkCreateInstance(&createInfo, nullptr, &instance);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Instance created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create instance");
+		}
+		vkDestroyInstance = (PFN_vkDestroyInstance)vkGetInstanceProcAddr(instance, "vkDestroyInstance");
+
+#ifndef NDEBUG
+		auto vkCreateDebugUtilsMessengerEXT = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
+		VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = {};
+		debugCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+		debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+		debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+		debugCreateInfo.pfnUserCallback = debugCallback;
+		result = vkCreateDebugUtilsMessengerEXT(instance, &debugCreateInfo, nullptr, &debugMessenger);
+		if (result == VK_SUCCESS) {
+			std::cout << "Debug Messenger created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create debug messenger");
+		}
+		vkDestroyDebugUtilsMessengerEXT = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+#endif
+	}
+
+	void createSurface()
+	{
+		vkDestroySurfaceKHR = (PFN_vkDestroySurfaceKHR)vkGetInstanceProcAddr(instance, "vkDestroySurfaceKHR");
+		if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create window surface!");
+		}
+	}
+
+	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails details;
+		auto vkGetPhysicalDeviceSurfaceCapabilitiesKHR = (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"); // notice that instance, not device
+		auto vkGetPhysicalDeviceSurfaceFormatsKHR = (PFN_vkGetPhysicalDeviceSurfaceFormatsKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+		auto vkGetPhysicalDeviceSurfacePresentModesKHR = (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
+
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physDev, surface, &details.capabilities);
+
+		uint32_t formatCount = 0;
+		vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, nullptr);
+		if (formatCount != 0) {
+			details.formats.resize(formatCount);
+			vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, details.formats.data());
+		}
+
+		uint32_t presentModeCount = 0;
+		vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, nullptr);
+		if (presentModeCount != 0) {
+			details.presentModes.resize(presentModeCount);
+			vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, details.presentModes.data());
+		}
+
+		return details;
+	}
+
+	bool isDeviceSuitable(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physDev);
+		if (!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty()) {
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	void selectPhysicalDevice() {
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		auto physicalDeviceCount = 0u;
+		auto result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, nullptr);
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+		std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+		result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, physicalDevices.data());
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+
+		for (auto& physDev : physicalDevices) {
+			VkPhysicalDeviceProperties physicalDeviceProperties;
+			vkGetPhysicalDeviceProperties(physDev, &physicalDeviceProperties);
+			std::cout << "Physical Device: " << physicalDeviceProperties.deviceName << std::endl;
+			std::cout << "API Version: " << VK_VERSION_MAJOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_MINOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_PATCH(physicalDeviceProperties.apiVersion) << std::endl;
+			std::cout << "Driver Version: " << physicalDeviceProperties.driverVersion << std::endl;
+			std::cout << "Vendor ID: " << physicalDeviceProperties.vendorID << std::endl;
+			std::cout << "Device ID: " << physicalDeviceProperties.deviceID << std::endl;
+			VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+			vkGetPhysicalDeviceFeatures(physDev, &physicalDeviceFeatures);
+			std::cout << "GeometryShader    : " << physicalDeviceFeatures.geometryShader << std::endl;
+			std::cout << "TessellationShader: " << physicalDeviceFeatures.tessellationShader << std::endl;
+			std::uint32_t extensionCount;
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, nullptr);
+			std::vector<VkExtensionProperties> extensionProps(extensionCount);
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, extensionProps.data());
+			std::cout << "ExtensionCount: " << extensionProps.size() << std::endl;
+			size_t index = 0;
+			for (auto& extensionProp : extensionProps) {
+				std::cout << "Extensions[" << index << "]: " << extensionProp.extensionName << std::endl;
+				index++;
+			}
+			if (vkGetPhysicalDeviceFeatures2) {
+				// Query Vulkan Features
+				VkPhysicalDeviceFeatures2        physicalDeviceFeatures2 = {};
+				VkPhysicalDeviceVulkan11Features physicalDeviceVulkan11Features = {};
+				VkPhysicalDeviceVulkan12Features physicalDeviceVulkan12Features = {};
+				VkPhysicalDeviceVulkan13Features physicalDeviceVulkan13Features = {};
+				physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				physicalDeviceVulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+				physicalDeviceVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				physicalDeviceVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+				physicalDeviceFeatures2.pNext = &physicalDeviceVulkan11Features;
+				physicalDeviceVulkan11Features.pNext = &physicalDeviceVulkan12Features;
+				physicalDeviceVulkan12Features.pNext = &physicalDeviceVulkan13Features;
+				physicalDeviceVulkan13Features.pNext = nullptr;
+				vkGetPhysicalDeviceFeatures2(physDev, &physicalDeviceFeatures2);
+				std::cout << "BufferDeviceAddress: " << physicalDeviceVulkan12Features.bufferDeviceAddress << std::endl;
+				std::cout << "DynamicRendering   : " << physicalDeviceVulkan13Features.dynamicRendering << std::endl;
+			}
+			auto queueFamilyCount = 0u;
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+			std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilyProps.data());
+			std::cout << "QueueFamilyCount: " << queueFamilyProps.size() << std::endl;
+			for (auto& queueFamilyProp : queueFamilyProps) {
+				std::cout << "QueueFlags: ";
+				if (queueFamilyProp.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+					std::cout << "GRAPHICS |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_COMPUTE_BIT) {
+					std::cout << "COMPUTE |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_TRANSFER_BIT) {
+					std::cout << "TRANSFER |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) {
+					std::cout << "SPARSE_BINDING |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_PROTECTED_BIT) {
+					std::cout << "PROTECTED |";
+				}
+				std::cout << std::endl;
+				std::cout << "QueueCount: " << queueFamilyProp.queueCount << std::endl;
+				std::cout << "TimestampValidBits: " << queueFamilyProp.timestampValidBits << std::endl;
+			}
+		}
+
+		if (physicalDevices.size() > 0 && isDeviceSuitable(physicalDevices[0])) {
+			physicalDevice = physicalDevices[0];
+		}
+		else {
+			throw std::runtime_error("failed to find a physical device with Vulkan support");
+		}
+
+
+	}
+
+	QueueFamilyIndices findQueueFamilies(VkPhysicalDevice physDev)
+	{
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+
+		QueueFamilyIndices indices;
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilies.data());
+
+		int i = 0;
+		for (const auto& queueFamily : queueFamilies) {
+			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+				indices.graphicsFamily = i;
+			}
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physDev, i, surface, &presentSupport);
+
+			if (presentSupport) {
+				indices.presentFamily = i;
+			}
+
+			if (indices.isComplete()) {
+				break;
+			}
+			i++;
+		}
+
+		// note
+		// prefer a transfer-only family (DMA engine), then an async compute family, then the graphics family itself
+		auto transferFamilies = findQueueFamilyIndices(queueFamilies, VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+		if (transferFamilies.empty()) {
+			transferFamilies = findQueueFamilyIndices(queueFamilies, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+		}
+		if (!transferFamilies.empty()) {
+			indices.transferFamily = transferFamilies[0];
+		}
+		else {
+			indices.transferFamily = indices.graphicsFamily;
+		}
+
+		// note
+		// async compute needs a family without graphics, otherwise compute passes stay on the graphics queue
+		auto computeFamilies = findQueueFamilyIndices(queueFamilies, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+		if (!computeFamilies.empty()) {
+			indices.computeFamily = computeFamilies[0];
+		}
+		else {
+			indices.computeFamily = indices.graphicsFamily;
+		}
+
+		return indices;
+	}
+
+	void initDevice() {
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		std::uint32_t extensionCount;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(extensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensionProps.data());
+
+		std::vector<const char*> requestedDeviceExtensions = std::vector<const char*>{
+			VK_KHR_SWAPCHAIN_EXTENSION_NAME
+		};
+		// note
+		// timeline semaphores are core in Vulkan 1.2, older devices need the KHR extension
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+		if (physicalDeviceProperties.apiVersion < VK_API_VERSION_1_2) {
+			requestedDeviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+		}
+		std::vector<const char*> enabledDeviceExtensions;
+		for (auto& requestedDeviceExtension : requestedDeviceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedDeviceExtension)) {
+				throw std::runtime_error("failed to find device extension: " + std::string(requestedDeviceExtension));
+			}
+		}
+
+		enabledDeviceExtensions = requestedDeviceExtensions;
+
+		VkDeviceCreateInfo deviceCreateInfo = {};
+		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		deviceCreateInfo.enabledExtensionCount = requestedDeviceExtensions.size();
+		deviceCreateInfo.ppEnabledExtensionNames = requestedDeviceExtensions.data();
+
+		VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &physicalDeviceFeatures);
+		deviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
+
+		// note
+		VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures = {};
+		timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+		if (vkGetPhysicalDeviceFeatures2) {
+			VkPhysicalDeviceFeatures2 physicalDeviceFeatures2 = {};
+			physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			physicalDeviceFeatures2.pNext = &timelineSemaphoreFeatures;
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+		}
+		if (!timelineSemaphoreFeatures.timelineSemaphore) {
+			throw std::runtime_error("failed to find timeline semaphore support");
+		}
+		timelineSemaphoreFeatures.pNext = nullptr;
+		deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+
+		auto queueFamilyCount = 0u;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProps.data());
+
+		// note
+		queueFamilyIndices = findQueueFamilies(physicalDevice);
+		std::set<uint32_t> uniqueQueueFamilyIndices = { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value(), queueFamilyIndices.transferFamily.value(), queueFamilyIndices.computeFamily.value() };
+
+		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+		float queuePriority = 1.0f;
+		for (uint32_t uniqueQueueFamilyindex : uniqueQueueFamilyIndices) {
+			VkDeviceQueueCreateInfo queueCreateInfo = {};
+			queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queueCreateInfo.queueFamilyIndex = uniqueQueueFamilyindex;
+			queueCreateInfo.queueCount = 1;
+			queueCreateInfo.pQueuePriorities = &queuePriority;
+			queueCreateInfos.push_back(queueCreateInfo);
+		}
+
+		deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
+		deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+
+		auto vkCreateDevice = (PFN_vkCreateDevice)vkGetInstanceProcAddr(instance, "vkCreateDevice");
+		auto result = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Device created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create device");
+		}
+
+		vkGetDeviceProcAddr = (PFN_vkGetDeviceProcAddr)vkGetInstanceProcAddr(instance, "vkGetDeviceProcAddr");
+		auto vkGetDeviceQueue = (PFN_vkGetDeviceQueue)vkGetDeviceProcAddr(device, "vkGetDeviceQueue");
+		vkDestroyDevice = (PFN_vkDestroyDevice)vkGetDeviceProcAddr(device, "vkDestroyDevice");
+
+		vkGetDeviceQueue(device, queueFamilyIndices.graphicsFamily.value(), 0, &graphicsQueue);
+		vkGetDeviceQueue(device, queueFamilyIndices.presentFamily.value(), 0, &presentQueue);
+		// note
+		vkGetDeviceQueue(device, queueFamilyIndices.transferFamily.value(), 0, &transferQueue);
+		std::cout << "Transfer Queue Family: " << queueFamilyIndices.transferFamily.value()
+			<< (queueFamilyIndices.hasDedicatedTransfer() ? " (dedicated)" : " (shared with graphics)") << std::endl;
+		// note
+		// a family shared by transfer and compute hands out the same queue to both, submissions stay single threaded
+		vkGetDeviceQueue(device, queueFamilyIndices.computeFamily.value(), 0, &computeQueue);
+		std::cout << "Compute Queue Family: " << queueFamilyIndices.computeFamily.value()
+			<< (queueFamilyIndices.hasDedicatedCompute() ? " (dedicated)" : " (shared with graphics)") << std::endl;
+	}
+
+	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
+	{
+		for (const auto& availableFormat : availableFormats) {
+			if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+				return availableFormat;
+			}
+		}
+
+		return availableFormats[0];
+	}
+
+	VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
+	{
+		for (const auto& availablePresentMode : availablePresentModes) {
+			if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+				return availablePresentMode;
+			}
+		}
+
+		return VK_PRESENT_MODE_FIFO_KHR;
+	}
+
+	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
+	{
+		if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+			return capabilities.currentExtent;
+		}
+		else {
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+
+			VkExtent2D actualExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+
+			actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+			actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+
+			return actualExtent;
+		}
+	}
+
+	void createSwapChain()
+	{
+		auto vkCreateSwapchainKHR = (PFN_vkCreateSwapchainKHR)vkGetDeviceProcAddr(device, "vkCreateSwapchainKHR");
+		auto vkGetSwapchainImagesKHR = (PFN_vkGetSwapchainImagesKHR)vkGetDeviceProcAddr(device, "vkGetSwapchainImagesKHR");
+
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
+
+		VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
+		VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+		VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
+
+		uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+
+		if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
+			imageCount = swapChainSupport.capabilities.maxImageCount;
+		}
+
+		VkSwapchainCreateInfoKHR createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+		createInfo.surface = surface;
+		createInfo.minImageCount = imageCount;
+		createInfo.imageFormat = surfaceFormat.format;
+		createInfo.imageColorSpace = surfaceFormat.colorSpace;
+		createInfo.imageExtent = extent;
+		createInfo.imageArrayLayers = 1;
+		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+		// note
+		QueueFamilyIndices indices = queueFamilyIndices;
+		uint32_t sharedQueueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+
+		if (indices.graphicsFamily != indices.presentFamily) {
+			createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+			createInfo.queueFamilyIndexCount = 2;
+			createInfo.pQueueFamilyIndices = sharedQueueFamilyIndices;
+		}
+		else {
+			createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			/*createInfo.queueFamilyIndexCount = 0;
+			createInfo.pQueueFamilyIndices = nullptr;*/
+		}
+
+		createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
+		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+		createInfo.presentMode = presentMode;
+		createInfo.clipped = VK_TRUE;
+
+		createInfo.oldSwapchain = VK_NULL_HANDLE;
+
+		if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create swap chain!");
+		}
+
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);
+		swapChainImages.resize(imageCount);
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImages.data());
+
+		swapChainImageFormat = surfaceFormat.format;
+		swapChainExtent = extent;
+
+		vkDestroySwapchainKHR = (PFN_vkDestroySwapchainKHR)vkGetDeviceProcAddr(device, "vkDestroySwapchainKHR");
+	}
+
+	void createImageViews()
+	{
+		auto vkCreateImageView = (PFN_vkCreateImageView)vkGetDeviceProcAddr(device, "vkCreateImageView");
+
+		swapChainImageViews.resize(swapChainImages.size());
+
+		for (size_t i = 0; i < swapChainImages.size(); i++) {
+			VkImageViewCreateInfo createInfo{};
+			createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			createInfo.image = swapChainImages[i];
+			createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			createInfo.format = swapChainImageFormat;
+			createInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+			createInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+			createInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+			createInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+			createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			createInfo.subresourceRange.baseMipLevel = 0;
+			createInfo.subresourceRange.levelCount = 1;
+			createInfo.subresourceRange.baseArrayLayer = 0;
+			createInfo.subresourceRange.layerCount = 1;
+
+			if (vkCreateImageView(device, &createInfo, nullptr, &swapChainImageViews[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create image views!");
+			}
+		}
+
+		vkDestroyImageView = (PFN_vkDestroyImageView)vkGetDeviceProcAddr(device, "vkDestroyImageView");
+	}
+
+	// note
+	void createRenderPass() {
+		VkAttachmentDescription colorAttachment{};
+		colorAttachment.format = swapChainImageFormat;
+		colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+		VkAttachmentReference colorAttachmentRef{};
+		colorAttachmentRef.attachment = 0;
+		colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		VkSubpassDescription subpass{};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &colorAttachmentRef;
+
+		// note
+		VkSubpassDependency dependency{};
+		dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependency.dstSubpass = 0;
+		dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependency.srcAccessMask = 0;
+		dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+		VkRenderPassCreateInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassInfo.attachmentCount = 1;
+		renderPassInfo.pAttachments = &colorAttachment;
+		renderPassInfo.subpassCount = 1;
+		renderPassInfo.pSubpasses = &subpass;
+		renderPassInfo.dependencyCount = 1;
+		renderPassInfo.pDependencies = &dependency;
+
+		auto vkCreateRenderPass = (PFN_vkCreateRenderPass)vkGetInstanceProcAddr(instance, "vkCreateRenderPass");
+		if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create render pass");
+		}
+
+		vkDestroyRenderPass = (PFN_vkDestroyRenderPass)vkGetDeviceProcAddr(device, "vkDestroyRenderPass");
+	}
+
+	void createGraphicsPipeline() {
+		auto vertShaderCode = readFile(SHADER_ROOT_DIR"/shader.vert.spv");
+		auto fragShaderCode = readFile(SHADER_ROOT_DIR"/shader.frag.spv");
+
+		vertShaderModule = createShaderModule(vertShaderCode);
+		fragShaderModule = createShaderModule(fragShaderCode);
+
+		VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+		vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+		vertShaderStageInfo.module = vertShaderModule;
+		vertShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+		fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fragShaderStageInfo.module = fragShaderModule;
+		fragShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
+
+		// note
+		auto bindingDescription = Vertex::getBindingDescription();
+		auto attributeDescriptions = Vertex::getAttributeDescriptions();
+
+		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vertexInputInfo.vertexBindingDescriptionCount = 1;
+		vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+		vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)swapChainExtent.width;
+		viewport.height = (float)swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = swapChainExtent;
+
+		VkPipelineViewportStateCreateInfo viewportState{};
+		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewportState.viewportCount = 1;
+		viewportState.pViewports = &viewport;
+		viewportState.scissorCount = 1;
+		viewportState.pScissors = &scissor;
+
+		VkPipelineRasterizationStateCreateInfo rasterizer{};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.0f;
+		rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+		rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+		rasterizer.depthBiasEnable = VK_FALSE;
+
+		VkPipelineMultisampleStateCreateInfo multisampling{};
+		multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisampling.sampleShadingEnable = VK_FALSE;
+		multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.blendEnable = VK_FALSE;
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD; // Optional
+		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD; // Optional
+
+		VkPipelineColorBlendStateCreateInfo colorBlending{};
+		colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlending.logicOpEnable = VK_FALSE;
+		colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
+		colorBlending.attachmentCount = 1;
+		colorBlending.pAttachments = &colorBlendAttachment;
+		colorBlending.blendConstants[0] = 0.0f; // Optional
+		colorBlending.blendConstants[1] = 0.0f; // Optional
+		colorBlending.blendConstants[2] = 0.0f; // Optional
+		colorBlending.blendConstants[3] = 0.0f; // Optional
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 0;
+		pipelineLayoutInfo.pSetLayouts = nullptr;
+		pipelineLayoutInfo.pushConstantRangeCount = 0;
+		pipelineLayoutInfo.pPushConstantRanges = nullptr;
+
+		auto vkCreatePipelineLayout = (PFN_vkCreatePipelineLayout)vkGetInstanceProcAddr(instance, "vkCreatePipelineLayout");
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create pipeline layout");
+		}
+
+		// note
+		VkGraphicsPipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipelineInfo.stageCount = 2;
+		pipelineInfo.pStages = shaderStages;
+		pipelineInfo.pVertexInputState = &vertexInputInfo;
+		pipelineInfo.pInputAssemblyState = &inputAssembly;
+		pipelineInfo.pViewportState = &viewportState;
+		pipelineInfo.pRasterizationState = &rasterizer;
+		pipelineInfo.pMultisampleState = &multisampling;
+		pipelineInfo.pDepthStencilState = nullptr;
+		pipelineInfo.pColorBlendState = &colorBlending;
+		pipelineInfo.pDynamicState = nullptr;
+		pipelineInfo.layout = pipelineLayout;
+		pipelineInfo.renderPass = renderPass;
+		pipelineInfo.subpass = 0;
+
+		auto vkCreateGraphicsPipelines = (PFN_vkCreateGraphicsPipelines)vkGetInstanceProcAddr(instance, "vkCreateGraphicsPipelines");
+		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create graphics pipeline");
+		}
+
+		vkDestroyPipeline = (PFN_vkDestroyPipeline)vkGetDeviceProcAddr(device, "vkDestroyPipeline");
+
+		vkDestroyPipelineLayout = (PFN_vkDestroyPipelineLayout)vkGetDeviceProcAddr(device, "vkDestroyPipelineLayout");
+		vkDestroyShaderModule = (PFN_vkDestroyShaderModule)vkGetDeviceProcAddr(device, "vkDestroyShaderModule");
+	}
+
+	// note
+	void createParticleBuffers() {
+		// concurrent sharing avoids an ownership transfer between the graphics and compute queues every frame
+		std::vector<uint32_t> sharedQueueFamilies = { queueFamilyIndices.graphicsFamily.value() };
+		if (queueFamilyIndices.hasDedicatedCompute()) {
+			sharedQueueFamilies.push_back(queueFamilyIndices.computeFamily.value());
+		}
+		for (size_t i = 0; i < particleBuffers.size(); i++) {
+			createBuffer(sizeof(Particle) * PARTICLE_COUNT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, particleBuffers[i], particleBufferMemories[i], sharedQueueFamilies);
+		}
+	}
+
+	void createComputePipeline() {
+		auto vkCreateDescriptorSetLayout = (PFN_vkCreateDescriptorSetLayout)vkGetDeviceProcAddr(device, "vkCreateDescriptorSetLayout");
+		auto vkCreateDescriptorPool = (PFN_vkCreateDescriptorPool)vkGetDeviceProcAddr(device, "vkCreateDescriptorPool");
+		auto vkAllocateDescriptorSets = (PFN_vkAllocateDescriptorSets)vkGetDeviceProcAddr(device, "vkAllocateDescriptorSets");
+		auto vkUpdateDescriptorSets = (PFN_vkUpdateDescriptorSets)vkGetDeviceProcAddr(device, "vkUpdateDescriptorSets");
+		auto vkCreatePipelineLayout = (PFN_vkCreatePipelineLayout)vkGetDeviceProcAddr(device, "vkCreatePipelineLayout");
+		auto vkCreateComputePipelines = (PFN_vkCreateComputePipelines)vkGetDeviceProcAddr(device, "vkCreateComputePipelines");
+
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+		for (uint32_t i = 0; i < bindings.size(); i++) {
+			bindings[i].binding = i;
+			bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			bindings[i].descriptorCount = 1;
+			bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		}
+
+		VkDescriptorSetLayoutCreateInfo layoutInfo{};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+		layoutInfo.pBindings = bindings.data();
+		if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &computeDescriptorSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create compute descriptor set layout");
+		}
+
+		VkDescriptorPoolSize poolSize{};
+		poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		poolSize.descriptorCount = static_cast<uint32_t>(bindings.size() * particleDescriptorSets.size());
+
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.poolSizeCount = 1;
+		poolInfo.pPoolSizes = &poolSize;
+		poolInfo.maxSets = static_cast<uint32_t>(particleDescriptorSets.size());
+		if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &computeDescriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create compute descriptor pool");
+		}
+
+		std::array<VkDescriptorSetLayout, 2> setLayouts = { computeDescriptorSetLayout, computeDescriptorSetLayout };
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = computeDescriptorPool;
+		allocInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+		allocInfo.pSetLayouts = setLayouts.data();
+		if (vkAllocateDescriptorSets(device, &allocInfo, particleDescriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate compute descriptor sets");
+		}
+
+		// set i reads particleBuffers[i] and writes the other one
+		for (size_t i = 0; i < particleDescriptorSets.size(); i++) {
+			std::array<VkDescriptorBufferInfo, 2> bufferInfos{};
+			bufferInfos[0].buffer = particleBuffers[i];
+			bufferInfos[0].offset = 0;
+			bufferInfos[0].range = VK_WHOLE_SIZE;
+			bufferInfos[1].buffer = particleBuffers[1 - i];
+			bufferInfos[1].offset = 0;
+			bufferInfos[1].range = VK_WHOLE_SIZE;
+
+			std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+			for (uint32_t j = 0; j < descriptorWrites.size(); j++) {
+				descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				descriptorWrites[j].dstSet = particleDescriptorSets[i];
+				descriptorWrites[j].dstBinding = j;
+				descriptorWrites[j].dstArrayElement = 0;
+				descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				descriptorWrites[j].descriptorCount = 1;
+				descriptorWrites[j].pBufferInfo = &bufferInfos[j];
+			}
+			vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+		}
+
+		auto computeShaderCode = readFile(SHADER_ROOT_DIR"/particle.comp.spv");
+		computeShaderModule = createShaderModule(computeShaderCode);
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = sizeof(SimulationParams);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &computeDescriptorSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &computePipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create compute pipeline layout");
+		}
+
+		VkComputePipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		pipelineInfo.stage.module = computeShaderModule;
+		pipelineInfo.stage.pName = "main";
+		pipelineInfo.layout = computePipelineLayout;
+		if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create compute pipeline");
+		}
+
+		vkDestroyDescriptorSetLayout = (PFN_vkDestroyDescriptorSetLayout)vkGetDeviceProcAddr(device, "vkDestroyDescriptorSetLayout");
+		vkDestroyDescriptorPool = (PFN_vkDestroyDescriptorPool)vkGetDeviceProcAddr(device, "vkDestroyDescriptorPool");
+	}
+
+	void createParticlePipeline() {
+		auto particleVertShaderCode = readFile(SHADER_ROOT_DIR"/particle.vert.spv");
+		particleVertShaderModule = createShaderModule(particleVertShaderCode);
+
+		VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+		vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+		vertShaderStageInfo.module = particleVertShaderModule;
+		vertShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+		fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fragShaderStageInfo.module = fragShaderModule;
+		fragShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
+
+		auto bindingDescription = Particle::getBindingDescription();
+		auto attributeDescriptions = Particle::getAttributeDescriptions();
+
+		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vertexInputInfo.vertexBindingDescriptionCount = 1;
+		vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+		vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+		inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)swapChainExtent.width;
+		viewport.height = (float)swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = swapChainExtent;
+
+		VkPipelineViewportStateCreateInfo viewportState{};
+		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewportState.viewportCount = 1;
+		viewportState.pViewports = &viewport;
+		viewportState.scissorCount = 1;
+		viewportState.pScissors = &scissor;
+
+		VkPipelineRasterizationStateCreateInfo rasterizer{};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.0f;
+		rasterizer.cullMode = VK_CULL_MODE_NONE;
+		rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+		rasterizer.depthBiasEnable = VK_FALSE;
+
+		VkPipelineMultisampleStateCreateInfo multisampling{};
+		multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisampling.sampleShadingEnable = VK_FALSE;
+		multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.blendEnable = VK_FALSE;
+
+		VkPipelineColorBlendStateCreateInfo colorBlending{};
+		colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlending.logicOpEnable = VK_FALSE;
+		colorBlending.attachmentCount = 1;
+		colorBlending.pAttachments = &colorBlendAttachment;
+
+		// the particles need no descriptors, the triangle's empty layout is compatible
+		VkGraphicsPipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipelineInfo.stageCount = 2;
+		pipelineInfo.pStages = shaderStages;
+		pipelineInfo.pVertexInputState = &vertexInputInfo;
+		pipelineInfo.pInputAssemblyState = &inputAssembly;
+		pipelineInfo.pViewportState = &viewportState;
+		pipelineInfo.pRasterizationState = &rasterizer;
+		pipelineInfo.pMultisampleState = &multisampling;
+		pipelineInfo.pDepthStencilState = nullptr;
+		pipelineInfo.pColorBlendState = &colorBlending;
+		pipelineInfo.pDynamicState = nullptr;
+		pipelineInfo.layout = pipelineLayout;
+		pipelineInfo.renderPass = renderPass;
+		pipelineInfo.subpass = 0;
+
+		auto vkCreateGraphicsPipelines = (PFN_vkCreateGraphicsPipelines)vkGetDeviceProcAddr(device, "vkCreateGraphicsPipelines");
+		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &particlePipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create particle pipeline");
+		}
+	}
+
+	std::vector<ComputePass> buildComputePasses() {
+		auto src = static_cast<size_t>(frameCounter % 2);
+
+		SimulationParams params{};
+		params.deltaTime = 1.0f / 60.0f;
+		params.particleCount = PARTICLE_COUNT;
+		params.substeps = SIMULATION_SUBSTEPS;
+		params.reset = frameCounter == 0 ? 1u : 0u;
+
+		std::vector<ComputePass> passes;
+		passes.push_back({ "particle simulation", [this, src, params](VkCommandBuffer commandBuffer) {
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, 0, 1, &particleDescriptorSets[src], 0, nullptr);
+			vkCmdPushConstants(commandBuffer, computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(params), &params);
+			vkCmdDispatch(commandBuffer, (PARTICLE_COUNT + 255) / 256, 1, 1);
+		} });
+		return passes;
+	}
+
+	// Passes run in the order given, each one sees the writes of the previous ones.
+	// previousReaders are the stages that read the outputs earlier on the same queue.
+	void recordComputePasses(VkCommandBuffer commandBuffer, const std::vector<ComputePass>& passes, VkPipelineStageFlags previousReaders) {
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(commandBuffer, previousReaders | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+			1, &barrier, 0, nullptr, 0, nullptr);
+		for (size_t i = 0; i < passes.size(); i++) {
+			if (i > 0) {
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+					1, &barrier, 0, nullptr, 0, nullptr);
+			}
+			passes[i].record(commandBuffer);
+		}
+	}
+
+	// Runs the passes on the compute queue. They wait for the graphics submission that last read their outputs
+	// and signal computeTimeline, the returned value is what the graphics queue waits for before consuming them.
+	uint64_t submitAsyncCompute(const std::vector<ComputePass>& passes, uint64_t waitGraphicsValue) {
+		// the frame fence only covers the graphics queue, make sure this slot's compute work retired as well
+		if (computeSlotValues[currentFrame] > 0) {
+			VkSemaphoreWaitInfo waitInfo{};
+			waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+			waitInfo.semaphoreCount = 1;
+			waitInfo.pSemaphores = &computeTimeline;
+			waitInfo.pValues = &computeSlotValues[currentFrame];
+			vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+		}
+
+		auto commandBuffer = computeCommandBuffers[currentFrame];
+		vkResetCommandBuffer(commandBuffer, 0);
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording compute command buffer");
+		}
+		recordComputePasses(commandBuffer, passes, 0);
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record compute command buffer");
+		}
+
+		uint64_t signalValue = computeTimelineValue + 1;
+		VkTimelineSemaphoreSubmitInfo timelineInfo{};
+		timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timelineInfo.waitSemaphoreValueCount = 1;
+		timelineInfo.pWaitSemaphoreValues = &waitGraphicsValue;
+		timelineInfo.signalSemaphoreValueCount = 1;
+		timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.pNext = &timelineInfo;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &graphicsTimeline;
+		submitInfo.pWaitDstStageMask = &waitStage;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &computeTimeline;
+		if (vkQueueSubmit(computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit compute command buffer");
+		}
+
+		computeTimelineValue = signalValue;
+		computeSlotValues[currentFrame] = signalValue;
+		return signalValue;
+	}
+
+	void startComputeBenchmark() {
+		asyncComputeEnabled = false;
+		benchmarkFrameCount = 0;
+		if (!queueFamilyIndices.hasDedicatedCompute()) {
+			std::cout << "Async compute benchmark skipped: no compute-only queue family, compute passes run on the graphics queue" << std::endl;
+			benchmarkPhase = BenchmarkPhase::Done;
+			return;
+		}
+		benchmarkPhase = BenchmarkPhase::Warmup;
+	}
+
+	// Serial records the compute passes into the graphics command buffer, Async submits them to the compute queue.
+	// The frame rate must not be capped by presentation for the difference to show.
+	void updateComputeBenchmark() {
+		if (benchmarkPhase == BenchmarkPhase::Done) {
+			return;
+		}
+
+		benchmarkFrameCount++;
+		auto now = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double, std::milli>(now - benchmarkStartTime).count();
+		switch (benchmarkPhase) {
+		case BenchmarkPhase::Warmup:
+			if (benchmarkFrameCount == BENCHMARK_WARMUP_FRAMES) {
+				benchmarkPhase = BenchmarkPhase::Serial;
+				benchmarkFrameCount = 0;
+				benchmarkStartTime = now;
+			}
+			break;
+		case BenchmarkPhase::Serial:
+			if (benchmarkFrameCount == BENCHMARK_FRAMES) {
+				serialFrameTime = elapsed / BENCHMARK_FRAMES;
+				benchmarkPhase = BenchmarkPhase::Async;
+				asyncComputeEnabled = true;
+				benchmarkFrameCount = 0;
+				benchmarkStartTime = now;
+			}
+			break;
+		case BenchmarkPhase::Async:
+			if (benchmarkFrameCount == BENCHMARK_FRAMES) {
+				double asyncFrameTime = elapsed / BENCHMARK_FRAMES;
+				std::cout << "Async compute benchmark: serial " << serialFrameTime << " ms/frame, async " << asyncFrameTime << " ms/frame ("
+					<< 100.0 * (serialFrameTime - asyncFrameTime) / serialFrameTime << "% of the frame hidden by overlap)" << std::endl;
+				benchmarkPhase = BenchmarkPhase::Done;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	// note
+	void createFramebuffers() {
+		auto vkCreateFramebuffer = (PFN_vkCreateFramebuffer)vkGetDeviceProcAddr(device, "vkCreateFramebuffer");
+
+		swapChainFramebuffers.resize(swapChainImageViews.size());
+		for (size_t i = 0; i < swapChainImageViews.size(); i++) {
+			VkImageView attachments[] = { swapChainImageViews[i] };
+
+			VkFramebufferCreateInfo framebufferInfo{};
+			framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			framebufferInfo.renderPass = renderPass;
+			framebufferInfo.attachmentCount = 1;
+			framebufferInfo.pAttachments = attachments;
+			framebufferInfo.width = swapChainExtent.width;
+			framebufferInfo.height = swapChainExtent.height;
+			framebufferInfo.layers = 1;
+
+			if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &swapChainFramebuffers[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create framebuffer");
+			}
+		}
+
+		vkDestroyFramebuffer = (PFN_vkDestroyFramebuffer)vkGetDeviceProcAddr(device, "vkDestroyFramebuffer");
+	}
+
+	void createCommandPools() {
+		auto vkCreateCommandPool = (PFN_vkCreateCommandPool)vkGetDeviceProcAddr(device, "vkCreateCommandPool");
+
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create command pool");
+		}
+
+		// upload commands are always recorded for the transfer family, even when it is the graphics family
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = queueFamilyIndices.transferFamily.value();
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &transferCommandPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create transfer command pool");
+		}
+
+		// note
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = queueFamilyIndices.computeFamily.value();
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &computeCommandPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create compute command pool");
+		}
+
+		vkDestroyCommandPool = (PFN_vkDestroyCommandPool)vkGetDeviceProcAddr(device, "vkDestroyCommandPool");
+	}
+
+	void createCommandBuffers() {
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+
+		commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		uploadCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+		if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate command buffers");
+		}
+
+		allocInfo.commandPool = transferCommandPool;
+		allocInfo.commandBufferCount = static_cast<uint32_t>(uploadCommandBuffers.size());
+		if (vkAllocateCommandBuffers(device, &allocInfo, uploadCommandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate upload command buffers");
+		}
+
+		// note
+		computeCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		computeSlotValues.assign(MAX_FRAMES_IN_FLIGHT, 0);
+		allocInfo.commandPool = computeCommandPool;
+		allocInfo.commandBufferCount = static_cast<uint32_t>(computeCommandBuffers.size());
+		if (vkAllocateCommandBuffers(device, &allocInfo, computeCommandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate compute command buffers");
+		}
+
+		vkBeginCommandBuffer = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(device, "vkBeginCommandBuffer");
+		vkEndCommandBuffer = (PFN_vkEndCommandBuffer)vkGetDeviceProcAddr(device, "vkEndCommandBuffer");
+		vkResetCommandBuffer = (PFN_vkResetCommandBuffer)vkGetDeviceProcAddr(device, "vkResetCommandBuffer");
+		vkCmdBeginRenderPass = (PFN_vkCmdBeginRenderPass)vkGetDeviceProcAddr(device, "vkCmdBeginRenderPass");
+		vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass)vkGetDeviceProcAddr(device, "vkCmdEndRenderPass");
+		vkCmdBindPipeline = (PFN_vkCmdBindPipeline)vkGetDeviceProcAddr(device, "vkCmdBindPipeline");
+		vkCmdBindVertexBuffers = (PFN_vkCmdBindVertexBuffers)vkGetDeviceProcAddr(device, "vkCmdBindVertexBuffers");
+		vkCmdDraw = (PFN_vkCmdDraw)vkGetDeviceProcAddr(device, "vkCmdDraw");
+		vkCmdCopyBuffer = (PFN_vkCmdCopyBuffer)vkGetDeviceProcAddr(device, "vkCmdCopyBuffer");
+		vkCmdPipelineBarrier = (PFN_vkCmdPipelineBarrier)vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier");
+		// note
+		vkCmdDispatch = (PFN_vkCmdDispatch)vkGetDeviceProcAddr(device, "vkCmdDispatch");
+		vkCmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets)vkGetDeviceProcAddr(device, "vkCmdBindDescriptorSets");
+		vkCmdPushConstants = (PFN_vkCmdPushConstants)vkGetDeviceProcAddr(device, "vkCmdPushConstants");
+	}
+
+	void createSyncObjects() {
+		auto vkCreateSemaphore = (PFN_vkCreateSemaphore)vkGetDeviceProcAddr(device, "vkCreateSemaphore");
+		auto vkCreateFence = (PFN_vkCreateFence)vkGetDeviceProcAddr(device, "vkCreateFence");
+
+		imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+		uploadFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+		inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+		// presentation may hold on to the semaphore until the image is reacquired, so one per image
+		renderFinishedSemaphores.resize(swapChainImages.size());
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
+				vkCreateSemaphore(device, &semaphoreInfo, nullptr, &uploadFinishedSemaphores[i]) != VK_SUCCESS ||
+				vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a frame");
+			}
+		}
+		for (size_t i = 0; i < renderFinishedSemaphores.size(); i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a swap chain image");
+			}
+		}
+
+		// note
+		VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+		timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		timelineCreateInfo.initialValue = 0;
+		semaphoreInfo.pNext = &timelineCreateInfo;
+		if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &computeTimeline) != VK_SUCCESS ||
+			vkCreateSemaphore(device, &semaphoreInfo, nullptr, &graphicsTimeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create timeline semaphores");
+		}
+
+		vkWaitSemaphores = (PFN_vkWaitSemaphores)vkGetDeviceProcAddr(device, "vkWaitSemaphores");
+		if (!vkWaitSemaphores) {
+			vkWaitSemaphores = (PFN_vkWaitSemaphores)vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR");
+		}
+
+		vkDestroySemaphore = (PFN_vkDestroySemaphore)vkGetDeviceProcAddr(device, "vkDestroySemaphore");
+		vkDestroyFence = (PFN_vkDestroyFence)vkGetDeviceProcAddr(device, "vkDestroyFence");
+		vkWaitForFences = (PFN_vkWaitForFences)vkGetDeviceProcAddr(device, "vkWaitForFences");
+		vkResetFences = (PFN_vkResetFences)vkGetDeviceProcAddr(device, "vkResetFences");
+		vkAcquireNextImageKHR = (PFN_vkAcquireNextImageKHR)vkGetDeviceProcAddr(device, "vkAcquireNextImageKHR");
+		vkQueueSubmit = (PFN_vkQueueSubmit)vkGetDeviceProcAddr(device, "vkQueueSubmit");
+		vkQueuePresentKHR = (PFN_vkQueuePresentKHR)vkGetDeviceProcAddr(device, "vkQueuePresentKHR");
+		vkDeviceWaitIdle = (PFN_vkDeviceWaitIdle)vkGetDeviceProcAddr(device, "vkDeviceWaitIdle");
+	}
+
+	uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+		auto vkGetPhysicalDeviceMemoryProperties = (PFN_vkGetPhysicalDeviceMemoryProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties");
+
+		VkPhysicalDeviceMemoryProperties memProperties;
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+			if ((typeFilter & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+
+		throw std::runtime_error("failed to find suitable memory type");
+	}
+
+	// note
+	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory,
+		const std::vector<uint32_t>& concurrentQueueFamilies = {}) {
+		auto vkCreateBuffer = (PFN_vkCreateBuffer)vkGetDeviceProcAddr(device, "vkCreateBuffer");
+		auto vkGetBufferMemoryRequirements = (PFN_vkGetBufferMemoryRequirements)vkGetDeviceProcAddr(device, "vkGetBufferMemoryRequirements");
+		auto vkAllocateMemory = (PFN_vkAllocateMemory)vkGetDeviceProcAddr(device, "vkAllocateMemory");
+		auto vkBindBufferMemory = (PFN_vkBindBufferMemory)vkGetDeviceProcAddr(device, "vkBindBufferMemory");
+
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		if (concurrentQueueFamilies.size() > 1) {
+			bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+			bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(concurrentQueueFamilies.size());
+			bufferInfo.pQueueFamilyIndices = concurrentQueueFamilies.data();
+		}
+		if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create buffer");
+		}
+
+		VkMemoryRequirements memRequirements;
+		vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize = memRequirements.size;
+		allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+		if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate buffer memory");
+		}
+
+		vkBindBufferMemory(device, buffer, bufferMemory, 0);
+
+		vkDestroyBuffer = (PFN_vkDestroyBuffer)vkGetDeviceProcAddr(device, "vkDestroyBuffer");
+		vkFreeMemory = (PFN_vkFreeMemory)vkGetDeviceProcAddr(device, "vkFreeMemory");
+	}
+
+	void createUploadRing() {
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+		uploadOffsetAlignment = std::max<VkDeviceSize>(physicalDeviceProperties.limits.optimalBufferCopyOffsetAlignment, 16);
+
+		uploadRing.size = UPLOAD_RING_SIZE;
+		createBuffer(uploadRing.size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uploadRing.buffer, uploadRing.memory);
+
+		// mapped once for the lifetime of the ring
+		void* mapped = nullptr;
+		if (vkMapMemory(device, uploadRing.memory, 0, uploadRing.size, 0, &mapped) != VK_SUCCESS) {
+			throw std::runtime_error("failed to map upload ring");
+		}
+		uploadRing.mapped = static_cast<char*>(mapped);
+		uploadRingMarks.assign(MAX_FRAMES_IN_FLIGHT, 0);
+
+		vkUnmapMemory = (PFN_vkUnmapMemory)vkGetDeviceProcAddr(device, "vkUnmapMemory");
+	}
+
+	void createStreamBuffers() {
+		streamBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		streamBufferMemories.resize(MAX_FRAMES_IN_FLIGHT);
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			createBuffer(STREAM_VERTEX_REGION_SIZE + STREAM_PAYLOAD_SIZE, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, streamBuffers[i], streamBufferMemories[i]);
+		}
+
+		streamPayload.resize(STREAM_PAYLOAD_SIZE);
+		for (size_t i = 0; i < streamPayload.size(); i++) {
+			streamPayload[i] = static_cast<char>(i * 31);
+		}
+	}
+
+	void retireUploads(uint32_t frame) {
+		uploadRing.tail = std::max(uploadRing.tail, uploadRingMarks[frame]);
+	}
+
+	void beginUploads() {
+		if (uploadRecording) {
+			return;
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		vkResetCommandBuffer(uploadCommandBuffers[currentFrame], 0);
+		if (vkBeginCommandBuffer(uploadCommandBuffers[currentFrame], &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording upload command buffer");
+		}
+		uploadRecording = true;
+	}
+
+	VkDeviceSize allocateUploadSpace(VkDeviceSize bytes) {
+		auto offset = uploadRing.allocate(bytes, uploadOffsetAlignment);
+		if (!offset) {
+			// the ring is full of data still read by other frames in flight, never wait for the frame being recorded
+			std::vector<VkFence> fences;
+			for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+				if (i != currentFrame) {
+					fences.push_back(inFlightFences[i]);
+				}
+			}
+			if (!fences.empty()) {
+				vkWaitForFences(device, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+			}
+			for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+				if (i != currentFrame) {
+					retireUploads(i);
+				}
+			}
+			offset = uploadRing.allocate(bytes, uploadOffsetAlignment);
+		}
+		if (!offset) {
+			throw std::runtime_error("upload ring exhausted by a single frame");
+		}
+		return offset.value();
+	}
+
+	void uploadBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize size, VkAccessFlags dstAccessMask, VkPipelineStageFlags dstStageMask) {
+		beginUploads();
+
+		auto src = static_cast<const char*>(data);
+		auto maxChunkSize = uploadRing.size / MAX_FRAMES_IN_FLIGHT;
+		while (size > 0) {
+			auto chunkSize = std::min(size, maxChunkSize);
+			auto srcOffset = allocateUploadSpace(chunkSize);
+			std::memcpy(uploadRing.mapped + srcOffset, src, static_cast<size_t>(chunkSize));
+
+			VkBufferCopy copyRegion{};
+			copyRegion.srcOffset = srcOffset;
+			copyRegion.dstOffset = dstOffset;
+			copyRegion.size = chunkSize;
+			vkCmdCopyBuffer(uploadCommandBuffers[currentFrame], uploadRing.buffer, dstBuffer, 1, &copyRegion);
+
+			src += chunkSize;
+			dstOffset += chunkSize;
+			size -= chunkSize;
+			uploadedBytes += chunkSize;
+		}
+
+		auto pending = std::find_if(pendingReleases.begin(), pendingReleases.end(), [&](const PendingOwnershipTransfer& transfer) {
+			return transfer.buffer == dstBuffer;
+		});
+		if (pending == pendingReleases.end()) {
+			pendingReleases.push_back({ dstBuffer, dstAccessMask, dstStageMask });
+		}
+		else {
+			pending->dstAccessMask |= dstAccessMask;
+			pending->dstStageMask |= dstStageMask;
+		}
+	}
+
+	// Submits this frame's copies on the transfer queue and returns the stages the graphics submission
+	// has to wait at, or 0 when nothing was uploaded.
+	VkPipelineStageFlags submitUploads() {
+		pendingAcquires.clear();
+		if (!uploadRecording) {
+			return 0;
+		}
+
+		auto commandBuffer = uploadCommandBuffers[currentFrame];
+		VkPipelineStageFlags waitStages = 0;
+		std::vector<VkBufferMemoryBarrier> releaseBarriers;
+		for (auto& pending : pendingReleases) {
+			waitStages |= pending.dstStageMask;
+			if (queueFamilyIndices.hasDedicatedTransfer()) {
+				// release half of the queue family ownership transfer, dstAccessMask is ignored here
+				VkBufferMemoryBarrier barrier{};
+				barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+				barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				barrier.dstAccessMask = 0;
+				barrier.srcQueueFamilyIndex = queueFamilyIndices.transferFamily.value();
+				barrier.dstQueueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+				barrier.buffer = pending.buffer;
+				barrier.offset = 0;
+				barrier.size = VK_WHOLE_SIZE;
+				releaseBarriers.push_back(barrier);
+			}
+		}
+		if (!releaseBarriers.empty()) {
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+				0, nullptr, static_cast<uint32_t>(releaseBarriers.size()), releaseBarriers.data(), 0, nullptr);
+		}
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record upload command buffer");
+		}
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &uploadFinishedSemaphores[currentFrame];
+		if (vkQueueSubmit(transferQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit upload command buffer");
+		}
+
+		// the graphics submission waits on the upload, so this frame's fence also retires the staged bytes
+		uploadRingMarks[currentFrame] = uploadRing.head;
+		pendingAcquires.swap(pendingReleases);
+		pendingReleases.clear();
+		uploadRecording = false;
+		return waitStages;
+	}
+
+	void recordOwnershipAcquires(VkCommandBuffer commandBuffer) {
+		if (!queueFamilyIndices.hasDedicatedTransfer() || pendingAcquires.empty()) {
+			return;
+		}
+
+		// acquire half of the transfer, its source stages chain with the semaphore wait of the submission
+		VkPipelineStageFlags dstStages = 0;
+		std::vector<VkBufferMemoryBarrier> acquireBarriers;
+		for (auto& pending : pendingAcquires) {
+			VkBufferMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = pending.dstAccessMask;
+			barrier.srcQueueFamilyIndex = queueFamilyIndices.transferFamily.value();
+			barrier.dstQueueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+			barrier.buffer = pending.buffer;
+			barrier.offset = 0;
+			barrier.size = VK_WHOLE_SIZE;
+			acquireBarriers.push_back(barrier);
+			dstStages |= pending.dstStageMask;
+		}
+		vkCmdPipelineBarrier(commandBuffer, dstStages, dstStages, 0,
+			0, nullptr, static_cast<uint32_t>(acquireBarriers.size()), acquireBarriers.data(), 0, nullptr);
+	}
+
+	void updateStreamBuffer(uint32_t frame) {
+		static auto startTime = std::chrono::steady_clock::now();
+		float time = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+
+		std::array<Vertex, 3> vertices = { {
+			{{ 0.0f, -0.5f}, {1.0f, 0.0f, 0.0f}},
+			{{ 0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}},
+			{{-0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}}
+		} };
+		float c = std::cos(time);
+		float s = std::sin(time);
+		for (auto& vertex : vertices) {
+			vertex.pos = glm::vec2(c * vertex.pos.x - s * vertex.pos.y, s * vertex.pos.x + c * vertex.pos.y);
+		}
+
+		uploadBuffer(streamBuffers[frame], 0, vertices.data(), sizeof(vertices),
+			VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+		uploadBuffer(streamBuffers[frame], STREAM_VERTEX_REGION_SIZE, streamPayload.data(), streamPayload.size(),
+			VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+	}
+
+	void reportUploadBandwidth() {
+		uploadedFrames++;
+		auto now = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double>(now - uploadReportTime).count();
+		if (elapsed < 1.0) {
+			return;
+		}
+
+		double megabytes = static_cast<double>(uploadedBytes) / (1024.0 * 1024.0);
+		std::cout << "Upload bandwidth: " << megabytes / elapsed << " MB/s ("
+			<< megabytes / static_cast<double>(uploadedFrames) << " MB/frame, "
+			<< (queueFamilyIndices.hasDedicatedTransfer() ? "dedicated transfer queue" : "graphics queue family") << ")" << std::endl;
+
+		uploadedBytes = 0;
+		uploadedFrames = 0;
+		uploadReportTime = now;
+	}
+
+	void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex, const std::vector<ComputePass>& inlineComputePasses) {
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording command buffer");
+		}
+
+		recordOwnershipAcquires(commandBuffer);
+
+		// note
+		if (!inlineComputePasses.empty()) {
+			recordComputePasses(commandBuffer, inlineComputePasses, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+			VkMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+				1, &barrier, 0, nullptr, 0, nullptr);
+		}
+
+		VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = renderPass;
+		renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+		renderPassInfo.renderArea.offset = { 0, 0 };
+		renderPassInfo.renderArea.extent = swapChainExtent;
+		renderPassInfo.clearValueCount = 1;
+		renderPassInfo.pClearValues = &clearColor;
+
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+
+		VkBuffer vertexBuffers[] = { streamBuffers[currentFrame] };
+		VkDeviceSize offsets[] = { 0 };
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+		vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+
+		// note
+		// draws what the previous frame's simulation produced while this frame's simulation writes the other buffer
+		if (frameCounter > 0) {
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particlePipeline);
+			VkBuffer particleVertexBuffers[] = { particleBuffers[frameCounter % 2] };
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, particleVertexBuffers, offsets);
+			vkCmdDraw(commandBuffer, PARTICLE_COUNT, 1, 0, 0);
+		}
+		vkCmdEndRenderPass(commandBuffer);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record command buffer");
+		}
+	}
+
+	void drawFrame() {
+		vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+		retireUploads(currentFrame);
+
+		uint32_t imageIndex = 0;
+		auto result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to acquire swap chain image");
+		}
+		vkResetFences(device, 1, &inFlightFences[currentFrame]);
+
+		// the copies run on the transfer queue while the graphics queue is still busy with the previous frame
+		updateStreamBuffer(currentFrame);
+		auto uploadWaitStages = submitUploads();
+
+		// note
+		// compute N waits for graphics N-1 (last reader of its output), graphics N waits for compute N-1 (producer of its input),
+		// so compute N and graphics N run side by side
+		auto computePasses = buildComputePasses();
+		auto graphicsWaitComputeValue = lastComputeValue;
+		std::vector<ComputePass> inlineComputePasses;
+		if (asyncComputeEnabled) {
+			lastComputeValue = submitAsyncCompute(computePasses, graphicsTimelineValue);
+		}
+		else {
+			lastComputeValue = 0;
+			inlineComputePasses = computePasses;
+		}
+
+		vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+		recordCommandBuffer(commandBuffers[currentFrame], imageIndex, inlineComputePasses);
+
+		std::vector<VkSemaphore> waitSemaphores = { imageAvailableSemaphores[currentFrame] };
+		std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+		std::vector<uint64_t> waitValues = { 0 };
+		if (uploadWaitStages != 0) {
+			// only the stages that consume the uploaded data wait for the transfer queue
+			waitSemaphores.push_back(uploadFinishedSemaphores[currentFrame]);
+			waitStages.push_back(uploadWaitStages);
+			waitValues.push_back(0);
+		}
+		if (graphicsWaitComputeValue > 0) {
+			waitSemaphores.push_back(computeTimeline);
+			waitStages.push_back(VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+			waitValues.push_back(graphicsWaitComputeValue);
+		}
+
+		uint64_t graphicsSignalValue = graphicsTimelineValue + 1;
+		std::array<VkSemaphore, 2> signalSemaphores = { renderFinishedSemaphores[imageIndex], graphicsTimeline };
+		std::array<uint64_t, 2> signalValues = { 0, graphicsSignalValue };
+
+		VkTimelineSemaphoreSubmitInfo timelineInfo{};
+		timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+		timelineInfo.pWaitSemaphoreValues = waitValues.data();
+		timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+		timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.pNext = &timelineInfo;
+		submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+		submitInfo.pWaitSemaphores = waitSemaphores.data();
+		submitInfo.pWaitDstStageMask = waitStages.data();
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+		submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+		submitInfo.pSignalSemaphores = signalSemaphores.data();
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit draw command buffer");
+		}
+		graphicsTimelineValue = graphicsSignalValue;
+
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinishedSemaphores[imageIndex];
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &swapChain;
+		presentInfo.pImageIndices = &imageIndex;
+		result = vkQueuePresentKHR(presentQueue, &presentInfo);
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to present swap chain image");
+		}
+
+		reportUploadBandwidth();
+		// note
+		updateComputeBenchmark();
+		frameCounter++;
+		currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	}
+
+
+	VkShaderModule createShaderModule(const std::vector<char>& code) {
+		VkShaderModuleCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = code.size();
+		createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+		auto vkCreateShaderModule = (PFN_vkCreateShaderModule)vkGetInstanceProcAddr(instance, "vkCreateShaderModule");
+		VkShaderModule shaderModule;
+		if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create shader module");
+		}
+
+		return shaderModule;
+	}
+
+
+	static std::vector<char> readFile(const std::string& filename) {
+		std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to open file");
+		}
+
+		size_t fileSize = (size_t)file.tellg();
+		std::vector<char> buffer(fileSize);
+
+		file.seekg(0);
+		file.read(buffer.data(), fileSize);
+
+		file.close();
+		return buffer;
+	}
+
+
+};
+
+int main() {
+	HelloTriangleApplication app;
+
+	try {
+		app.run();
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#version 450
+
+layout(set = 0, binding = 1) uniform texture2D materialImage;
+layout(set = 0, binding = 2) uniform sampler materialSampler;
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main(){
+	vec3 texel = texture(sampler2D(materialImage, materialSampler), fragTexCoord).rgb;
+	outColor = vec4(fragColor * texel, 1.0);
+}
\ No newline at end of file
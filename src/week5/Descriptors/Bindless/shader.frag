@@ -0,0 +1,23 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 0, binding = 1) uniform texture2D images[];
+layout(set = 0, binding = 2) uniform sampler samplers[];
+
+layout(push_constant) uniform DrawHandles {
+	uint instanceBuffer;
+	uint instanceIndex;
+	uint imageIndex;
+	uint samplerIndex;
+} handles;
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main(){
+	// push constants are the same for the whole draw, so the indices need no nonuniformEXT
+	vec3 texel = texture(sampler2D(images[handles.imageIndex], samplers[handles.samplerIndex]), fragTexCoord).rgb;
+	outColor = vec4(fragColor * texel, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+struct InstanceData {
+	vec4 offsetScale;
+	vec4 color;
+};
+
+// every storage buffer of the bindless set, the instances are in the one named by the handle
+layout(std430, set = 0, binding = 0) readonly buffer Instances {
+	InstanceData instances[];
+} buffers[];
+
+layout(push_constant) uniform DrawHandles {
+	uint instanceBuffer;
+	uint instanceIndex;
+	uint imageIndex;
+	uint samplerIndex;
+} handles;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main(){
+	InstanceData instance = buffers[handles.instanceBuffer].instances[handles.instanceIndex];
+	gl_Position = vec4(inPosition.xy * instance.offsetScale.z + instance.offsetScale.xy, inPosition.z, 1.0);
+	fragColor = instance.color.rgb * (0.35 + 0.65 * max(-inNormal.z, 0.0));
+	fragTexCoord = inTexCoord * vec2(2.0, 1.0);
+}
\ No newline at end of file
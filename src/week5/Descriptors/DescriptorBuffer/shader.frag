@@ -0,0 +1,13 @@
+#version 450
+
+layout(set = 0, binding = 1) uniform sampler2D materialTexture;
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main(){
+	vec3 texel = texture(materialTexture, fragTexCoord).rgb;
+	outColor = vec4(fragColor * texel, 1.0);
+}
\ No newline at end of file
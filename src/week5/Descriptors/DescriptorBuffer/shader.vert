@@ -0,0 +1,21 @@
+#version 450
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+// the descriptor covers exactly this draw's instance
+layout(std430, set = 0, binding = 0) readonly buffer Instance {
+	vec4 offsetScale;
+	vec4 color;
+} instance;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main(){
+	gl_Position = vec4(inPosition.xy * instance.offsetScale.z + instance.offsetScale.xy, inPosition.z, 1.0);
+	fragColor = instance.color.rgb * (0.35 + 0.65 * max(-inNormal.z, 0.0));
+	fragTexCoord = inTexCoord * vec2(2.0, 1.0);
+}
\ No newline at end of file
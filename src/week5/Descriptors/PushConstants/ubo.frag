@@ -0,0 +1,24 @@
+#version 450
+
+// MATERIAL_TEXTURE_COUNT in main.cpp
+layout(set = 0, binding = 1) uniform sampler2D materialTextures[64];
+
+// same bits as DrawFlag in main.cpp
+const uint DRAW_FLAG_UNTEXTURED = 1;
+
+layout(set = 1, binding = 0) uniform DrawConstants {
+	uint transformIndex;
+	uint materialIndex;
+	uint flags;
+} draw;
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+void main(){
+	// one uniform range for the whole draw, a dynamically uniform index
+	vec3 texel = (draw.flags & DRAW_FLAG_UNTEXTURED) != 0 ? vec3(1.0) : texture(materialTextures[draw.materialIndex], fragTexCoord).rgb;
+	outColor = vec4(fragColor * texel, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#version 450
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+struct InstanceData {
+	vec4 offsetScale;
+	vec4 color;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances {
+	InstanceData instances[];
+};
+
+// same bits as DrawFlag in main.cpp
+const uint DRAW_FLAG_UNLIT = 2;
+
+layout(set = 1, binding = 0) uniform DrawConstants {
+	uint transformIndex;
+	uint materialIndex;
+	uint flags;
+} draw;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main(){
+	InstanceData instance = instances[draw.transformIndex];
+	gl_Position = vec4(inPosition.xy * instance.offsetScale.z + instance.offsetScale.xy, inPosition.z, 1.0);
+	float shading = (draw.flags & DRAW_FLAG_UNLIT) != 0 ? 1.0 : 0.35 + 0.65 * max(-inNormal.z, 0.0);
+	fragColor = instance.color.rgb * shading;
+	fragTexCoord = inTexCoord * vec2(2.0, 1.0);
+}
\ No newline at end of file
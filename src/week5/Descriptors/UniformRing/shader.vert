@@ -0,0 +1,36 @@
+#version 450
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+struct InstanceData {
+	vec4 offsetScale;
+	vec4 color;
+};
+
+// both blocks live in the uniform ring, the dynamic offsets of the bind say where
+layout(set = 1, binding = 0) uniform Frame {
+	vec4 lightDirection;
+} frame;
+
+layout(set = 1, binding = 1) uniform Object {
+	InstanceData instance;
+	uint materialIndex;
+	uint flags;
+} object;
+
+// same bits as DrawFlag in main.cpp
+const uint DRAW_FLAG_UNLIT = 2;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main(){
+	InstanceData instance = object.instance;
+	gl_Position = vec4(inPosition.xy * instance.offsetScale.z + instance.offsetScale.xy, inPosition.z, 1.0);
+	float shading = (object.flags & DRAW_FLAG_UNLIT) != 0 ? 1.0 : 0.35 + 0.65 * max(dot(inNormal, normalize(frame.lightDirection.xyz)), 0.0);
+	fragColor = instance.color.rgb * shading;
+	fragTexCoord = inTexCoord * vec2(2.0, 1.0);
+}
\ No newline at end of file
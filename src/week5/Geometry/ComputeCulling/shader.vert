@@ -0,0 +1,29 @@
+#version 450
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+struct ObjectData {
+	vec4 boundingSphere;
+	vec4 color;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+	ObjectData objects[];
+};
+
+layout(push_constant) uniform Camera {
+	mat4 viewProjection;
+} camera;
+
+layout(location = 0) out vec3 fragColor;
+
+void main(){
+	// firstInstance of each culled command is the object index
+	ObjectData object = objects[gl_InstanceIndex];
+	gl_Position = camera.viewProjection * vec4(object.boundingSphere.xyz + inPosition * object.boundingSphere.w, 1.0);
+	float light = max(dot(inNormal, normalize(vec3(0.4, 0.8, 0.3))), 0.0);
+	fragColor = object.color.rgb * (0.3 + 0.7 * light) * (0.9 + 0.1 * inTexCoord.x);
+}
\ No newline at end of file
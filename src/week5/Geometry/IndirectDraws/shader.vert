@@ -0,0 +1,23 @@
+#version 450
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+struct InstanceData {
+	vec4 offsetScale;
+	vec4 color;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances {
+	InstanceData instances[];
+};
+
+layout(location = 0) out vec3 fragColor;
+
+void main(){
+	InstanceData instance = instances[gl_InstanceIndex];
+	gl_Position = vec4(inPosition.xy * instance.offsetScale.z + instance.offsetScale.xy, inPosition.z, 1.0);
+	fragColor = instance.color.rgb * (0.35 + 0.65 * max(-inNormal.z, 0.0)) * (0.75 + 0.25 * inTexCoord.x);
+}
\ No newline at end of file
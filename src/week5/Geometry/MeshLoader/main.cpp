@@ -0,0 +1,2731 @@
+#define GLFW_INCLUDE_VULKAN
+#define VK_NO_PROTOTYPES
+#include "config.h"
+#include <GLFW/glfw3.h>
+#include <vulkan/vulkan.h>
+#include <vulkan/vulkan.hpp>
+// note
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <optional>
+#include <set>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+// note
+#include <array>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstring>
+#include <cstddef>
+#include <functional>
+// note
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <cctype>
+#include <exception>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback2(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer2: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+
+inline auto findExtensionProperties(const std::vector<VkExtensionProperties>& extensionProps, const char* name) {
+	for (auto& extensionProp : extensionProps) {
+		if (strcmp(extensionProp.extensionName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findLayerProperties(const std::vector<VkLayerProperties>& layerProps, const char* name) {
+	for (auto& layerProp : layerProps) {
+		if (strcmp(layerProp.layerName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findQueueFamilyIndices(const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			indices.push_back(i);
+		}
+	}
+	return indices;
+}
+inline auto findQueueFamilyIndices(
+	VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR,
+	const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			if (!surface) {
+				indices.push_back(i);
+			}
+			else {
+				VkBool32 presentSupport = false;
+				vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+				if (presentSupport) {
+					indices.push_back(i);
+				}
+			}
+		}
+	}
+	return indices;
+}
+
+struct SwapChainSupportDetails {
+	VkSurfaceCapabilitiesKHR        capabilities;
+	std::vector<VkSurfaceFormatKHR> formats;
+	std::vector<VkPresentModeKHR>   presentModes;
+};
+
+struct QueueFamilyIndices {
+	std::optional<uint32_t> graphicsFamily;
+	std::optional<uint32_t> presentFamily;
+
+	bool isComplete()
+	{
+		return graphicsFamily.has_value() && presentFamily.has_value();
+	}
+};
+
+// note
+// Interleaved keeps every attribute of a vertex together in one binding. Split streams give each attribute its
+// own tightly packed binding, so a pass that reads only positions does not drag normals and uvs through the cache.
+enum class VertexLayout {
+	Interleaved,
+	SplitStreams,
+};
+
+struct MeshVertex {
+	glm::vec3 position;
+	glm::vec3   normal;
+	glm::vec2 texCoord;
+};
+
+// Source geometry, one array per attribute. Uploading reshapes it into the layout of the mesh.
+struct MeshData {
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3>   normals;
+	std::vector<glm::vec2> texCoords;
+	std::vector<uint32_t>    indices;
+};
+
+struct VertexInputDescription {
+	std::vector<VkVertexInputBindingDescription>     bindings;
+	std::vector<VkVertexInputAttributeDescription> attributes;
+};
+
+// Locations match shader.vert: 0 position, 1 normal, 2 texCoord. positionOnly matches position.vert.
+inline VertexInputDescription describeVertexInput(VertexLayout layout, bool positionOnly) {
+	VertexInputDescription description;
+	if (layout == VertexLayout::Interleaved) {
+		description.bindings.push_back({ 0, sizeof(MeshVertex), VK_VERTEX_INPUT_RATE_VERTEX });
+		description.attributes.push_back({ 0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(MeshVertex, position) });
+		if (!positionOnly) {
+			description.attributes.push_back({ 1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(MeshVertex, normal) });
+			description.attributes.push_back({ 2, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(MeshVertex, texCoord) });
+		}
+	}
+	else {
+		description.bindings.push_back({ 0, sizeof(glm::vec3), VK_VERTEX_INPUT_RATE_VERTEX });
+		description.attributes.push_back({ 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0 });
+		if (!positionOnly) {
+			description.bindings.push_back({ 1, sizeof(glm::vec3), VK_VERTEX_INPUT_RATE_VERTEX });
+			description.bindings.push_back({ 2, sizeof(glm::vec2), VK_VERTEX_INPUT_RATE_VERTEX });
+			description.attributes.push_back({ 1, 1, VK_FORMAT_R32G32B32_SFLOAT, 0 });
+			description.attributes.push_back({ 2, 2, VK_FORMAT_R32G32_SFLOAT, 0 });
+		}
+	}
+	return description;
+}
+
+// note
+// Split streams share one buffer, streamOffsets holds where each attribute array starts.
+struct GpuMesh {
+	VertexLayout                     layout = VertexLayout::Interleaved;
+	VkBuffer                   vertexBuffer = nullptr;
+	VkDeviceMemory             vertexMemory = nullptr;
+	std::array<VkDeviceSize, 3> streamOffsets = {};
+	VkBuffer                    indexBuffer = nullptr;
+	VkDeviceMemory              indexMemory = nullptr;
+	VkIndexType                   indexType = VK_INDEX_TYPE_UINT32;
+	uint32_t                     indexCount = 0;
+	uint32_t                    vertexCount = 0;
+};
+
+// note
+// A UV sphere squeezed into clip space: xy around center, z inside [0.1, 0.9] so nothing is clipped.
+// Triangles are wound clockwise on screen for the front half, matching the rasterizer state.
+inline MeshData generateSphere(glm::vec2 center, float radius, uint32_t rings, uint32_t segments) {
+	MeshData mesh;
+	auto vertexCount = size_t(rings + 1) * (segments + 1);
+	mesh.positions.reserve(vertexCount);
+	mesh.normals.reserve(vertexCount);
+	mesh.texCoords.reserve(vertexCount);
+	for (uint32_t ring = 0; ring <= rings; ring++) {
+		float theta = glm::pi<float>() * ring / rings;
+		for (uint32_t segment = 0; segment <= segments; segment++) {
+			float phi = glm::two_pi<float>() * segment / segments;
+			glm::vec3 normal = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+			mesh.positions.push_back({ center.x + radius * normal.x, center.y + radius * normal.y, 0.5f + 0.4f * normal.z });
+			mesh.normals.push_back(normal);
+			mesh.texCoords.push_back({ float(segment) / segments, float(ring) / rings });
+		}
+	}
+	mesh.indices.reserve(size_t(rings) * segments * 6);
+	for (uint32_t ring = 0; ring < rings; ring++) {
+		for (uint32_t segment = 0; segment < segments; segment++) {
+			uint32_t a = ring * (segments + 1) + segment;
+			uint32_t b = a + segments + 1;
+			uint32_t c = a + 1;
+			uint32_t d = b + 1;
+			mesh.indices.insert(mesh.indices.end(), { a, b, c, b, d, c });
+		}
+	}
+	return mesh;
+}
+
+// note
+// Read-only view of a whole file through the page cache, no copy into process memory.
+struct MappedFile {
+	const char* data = nullptr;
+	size_t      size = 0;
+#ifdef _WIN32
+	HANDLE      file = INVALID_HANDLE_VALUE;
+	HANDLE   mapping = nullptr;
+#else
+	int           fd = -1;
+#endif
+
+	explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER fileSize{};
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+			throw std::runtime_error("failed to open " + path);
+		}
+		size = static_cast<size_t>(fileSize.QuadPart);
+		if (size > 0) {
+			mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			data = mapping ? static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+			if (!data) {
+				unmap();
+				throw std::runtime_error("failed to map " + path);
+			}
+		}
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		struct stat fileStat{};
+		if (fd < 0 || fstat(fd, &fileStat) != 0) {
+			unmap();
+			throw std::runtime_error("failed to open " + path);
+		}
+		size = static_cast<size_t>(fileStat.st_size);
+		if (size > 0) {
+			void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (view == MAP_FAILED) {
+				unmap();
+				throw std::runtime_error("failed to map " + path);
+			}
+			data = static_cast<const char*>(view);
+			// chunks are parsed front to back, let the kernel read ahead
+			madvise(view, size, MADV_SEQUENTIAL);
+		}
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile() {
+		unmap();
+	}
+
+	void unmap() {
+#ifdef _WIN32
+		if (data) {
+			UnmapViewOfFile(data);
+		}
+		if (mapping) {
+			CloseHandle(mapping);
+		}
+		if (file != INVALID_HANDLE_VALUE) {
+			CloseHandle(file);
+		}
+		file = INVALID_HANDLE_VALUE;
+		mapping = nullptr;
+#else
+		if (data) {
+			munmap(const_cast<char*>(data), size);
+		}
+		if (fd >= 0) {
+			close(fd);
+		}
+		fd = -1;
+#endif
+		data = nullptr;
+	}
+};
+
+// note
+// Fixed set of worker threads. parallelFor hands out task indices from an atomic counter, the calling thread
+// works along, and the first exception thrown by a task is rethrown to the caller once every task has finished.
+struct WorkerPool {
+	std::vector<std::thread>                 workers;
+	std::mutex                                 mutex;
+	std::condition_variable                     wake;
+	std::condition_variable                     idle;
+	const std::function<void(uint32_t)>*         job = nullptr;
+	uint32_t                               taskCount = 0;
+	std::atomic<uint32_t>                   nextTask = 0;
+	uint32_t                           activeWorkers = 0;
+	uint64_t                              generation = 0;
+	bool                                    stopping = false;
+	std::exception_ptr                  firstFailure;
+
+	// threadCount includes the thread calling parallelFor
+	explicit WorkerPool(uint32_t threadCount) {
+		for (uint32_t i = 1; i < threadCount; i++) {
+			workers.emplace_back([this] { workerLoop(); });
+		}
+	}
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	~WorkerPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+
+	uint32_t threadCount() const {
+		return static_cast<uint32_t>(workers.size()) + 1;
+	}
+
+	void parallelFor(uint32_t count, const std::function<void(uint32_t)>& task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &task;
+			taskCount = count;
+			nextTask = 0;
+			activeWorkers = static_cast<uint32_t>(workers.size());
+			firstFailure = nullptr;
+			generation++;
+		}
+		wake.notify_all();
+		drain();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		idle.wait(lock, [this] { return activeWorkers == 0; });
+		job = nullptr;
+		if (firstFailure) {
+			std::rethrow_exception(firstFailure);
+		}
+	}
+
+	void drain() {
+		for (uint32_t task = nextTask++; task < taskCount; task = nextTask++) {
+			try {
+				(*job)(task);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!firstFailure) {
+					firstFailure = std::current_exception();
+				}
+			}
+		}
+	}
+
+	void workerLoop() {
+		uint64_t seenGeneration = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+				if (stopping) {
+					return;
+				}
+				seenGeneration = generation;
+			}
+			drain();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				activeWorkers--;
+			}
+			idle.notify_one();
+		}
+	}
+};
+
+// note
+// Minimal JSON reader for the glTF header chunk. Strings are views into the mapped file and escapes are kept as
+// they are, which is fine for the ASCII keys and names glTF uses.
+struct JsonValue {
+	enum class Type { Null, Boolean, Number, String, Array, Object };
+
+	Type                                                      type = Type::Null;
+	double                                                  number = 0.0;
+	std::string_view                                        string;
+	std::vector<JsonValue>                                   array;
+	std::vector<std::pair<std::string_view, JsonValue>>     object;
+
+	const JsonValue* find(std::string_view key) const {
+		for (auto& [name, value] : object) {
+			if (name == key) {
+				return &value;
+			}
+		}
+		return nullptr;
+	}
+
+	const JsonValue& operator[](std::string_view key) const {
+		auto value = find(key);
+		if (!value) {
+			throw std::runtime_error("glTF JSON is missing \"" + std::string(key) + "\"");
+		}
+		return *value;
+	}
+
+	const JsonValue& operator[](size_t index) const {
+		if (type != Type::Array || index >= array.size()) {
+			throw std::runtime_error("glTF JSON index out of range");
+		}
+		return array[index];
+	}
+
+	uint32_t asIndex() const {
+		return static_cast<uint32_t>(number);
+	}
+
+	uint32_t indexOr(std::string_view key, uint32_t fallback) const {
+		auto value = find(key);
+		return value ? value->asIndex() : fallback;
+	}
+};
+
+struct JsonParser {
+	const char* cursor;
+	const char*    end;
+
+	JsonValue parse() {
+		JsonValue value;
+		skipSpace();
+		if (cursor == end) {
+			throw std::runtime_error("unexpected end of glTF JSON");
+		}
+		switch (*cursor) {
+		case '{':
+			value.type = JsonValue::Type::Object;
+			cursor++;
+			while (skipSpace(), cursor < end && *cursor != '}') {
+				auto key = parseString();
+				skipSpace();
+				expect(':');
+				value.object.emplace_back(key, parse());
+				skipSpace();
+				if (cursor < end && *cursor == ',') {
+					cursor++;
+				}
+			}
+			expect('}');
+			break;
+		case '[':
+			value.type = JsonValue::Type::Array;
+			cursor++;
+			while (skipSpace(), cursor < end && *cursor != ']') {
+				value.array.push_back(parse());
+				skipSpace();
+				if (cursor < end && *cursor == ',') {
+					cursor++;
+				}
+			}
+			expect(']');
+			break;
+		case '"':
+			value.type = JsonValue::Type::String;
+			value.string = parseString();
+			break;
+		case 't':
+		case 'f':
+		case 'n':
+			value.type = *cursor == 'n' ? JsonValue::Type::Null : JsonValue::Type::Boolean;
+			value.number = *cursor == 't' ? 1.0 : 0.0;
+			while (cursor < end && std::isalpha(static_cast<unsigned char>(*cursor))) {
+				cursor++;
+			}
+			break;
+		default: {
+			value.type = JsonValue::Type::Number;
+			auto [next, error] = std::from_chars(cursor, end, value.number);
+			if (error != std::errc()) {
+				throw std::runtime_error("malformed number in glTF JSON");
+			}
+			cursor = next;
+			break;
+		}
+		}
+		return value;
+	}
+
+	std::string_view parseString() {
+		expect('"');
+		auto begin = cursor;
+		while (cursor < end && *cursor != '"') {
+			cursor += *cursor == '\\' ? 2 : 1;
+		}
+		if (cursor >= end) {
+			throw std::runtime_error("unterminated string in glTF JSON");
+		}
+		return std::string_view(begin, cursor++ - begin);
+	}
+
+	void skipSpace() {
+		while (cursor < end && std::isspace(static_cast<unsigned char>(*cursor))) {
+			cursor++;
+		}
+	}
+
+	void expect(char c) {
+		if (cursor >= end || *cursor != c) {
+			throw std::runtime_error(std::string("expected '") + c + "' in glTF JSON");
+		}
+		cursor++;
+	}
+};
+
+// note
+enum class MeshFileFormat {
+	Obj,
+	Glb,
+};
+
+// One newline-aligned slice of an OBJ file with what the counting pass found in it. The prefix sums over the
+// counts are where the slice writes its attributes, vertices and indices.
+struct ObjChunk {
+	const char*             begin = nullptr;
+	const char*               end = nullptr;
+	uint32_t            positions = 0;
+	uint32_t              normals = 0;
+	uint32_t            texCoords = 0;
+	uint32_t              corners = 0;
+	uint32_t            triangles = 0;
+	uint32_t         positionBase = 0;
+	uint32_t           normalBase = 0;
+	uint32_t         texCoordBase = 0;
+	uint32_t           cornerBase = 0;
+	uint32_t         triangleBase = 0;
+};
+
+// A contiguous run of vertices or indices of one glTF primitive, the unit of work of the fill pass.
+struct GlbTask {
+	uint32_t    primitive = 0;
+	bool          indices = false;
+	uint32_t        first = 0;
+	uint32_t        count = 0;
+};
+
+struct GlbAccessor {
+	const char*      data = nullptr;
+	uint32_t        count = 0;
+	uint32_t       stride = 0;
+	uint32_t componentType = 0;
+};
+
+struct GlbPrimitive {
+	GlbAccessor    positions;
+	GlbAccessor      normals;
+	GlbAccessor    texCoords;
+	GlbAccessor      indices;
+	uint32_t      vertexBase = 0;
+	uint32_t       indexBase = 0;
+	uint32_t      indexCount = 0;
+};
+
+// Everything the fill pass needs, worked out before the staging buffer exists so it can be sized exactly.
+struct MeshImportPlan {
+	MeshFileFormat               format = MeshFileFormat::Obj;
+	uint32_t                vertexCount = 0;
+	uint32_t                 indexCount = 0;
+	std::vector<ObjChunk>     objChunks;
+	std::vector<GlbPrimitive> primitives;
+	std::vector<GlbTask>        glbTasks;
+
+	VkDeviceSize vertexBytes() const { return VkDeviceSize(vertexCount) * sizeof(MeshVertex); }
+	VkDeviceSize indexBytes() const { return VkDeviceSize(indexCount) * sizeof(uint32_t); }
+};
+
+// OBJ faces index three separate attribute pools, so those pools are the one scratch copy a parallel OBJ
+// parse cannot avoid. Vertices and indices themselves go straight to the destination.
+struct ObjAttributePools {
+	std::unique_ptr<glm::vec3[]> positions;
+	std::unique_ptr<glm::vec3[]>   normals;
+	std::unique_ptr<glm::vec2[]> texCoords;
+};
+
+inline const char* skipObjSpace(const char* cursor, const char* end) {
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+		cursor++;
+	}
+	return cursor;
+}
+
+inline const char* parseObjFloat(const char* cursor, const char* end, float& value) {
+	cursor = skipObjSpace(cursor, end);
+	// from_chars does not take a leading plus, some exporters write one
+	if (cursor < end && *cursor == '+') {
+		cursor++;
+	}
+	auto [next, error] = std::from_chars(cursor, end, value);
+	if (error != std::errc()) {
+		throw std::runtime_error("malformed number in OBJ file");
+	}
+	return next;
+}
+
+// OBJ indices are 1-based, negative ones count back from the newest attribute at that point of the file.
+inline uint32_t resolveObjIndex(int64_t index, uint32_t definedSoFar) {
+	auto resolved = index < 0 ? int64_t(definedSoFar) + index : index - 1;
+	if (resolved < 0 || resolved >= int64_t(definedSoFar)) {
+		throw std::runtime_error("OBJ face references an undefined vertex attribute");
+	}
+	return static_cast<uint32_t>(resolved);
+}
+
+inline const char* objLineEnd(const char* cursor, const char* end) {
+	auto newline = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+	return newline ? newline : end;
+}
+
+inline uint32_t countObjCorners(const char* cursor, const char* lineEnd) {
+	uint32_t corners = 0;
+	while (true) {
+		cursor = skipObjSpace(cursor, lineEnd);
+		if (cursor >= lineEnd || *cursor == '\r' || *cursor == '#') {
+			return corners;
+		}
+		corners++;
+		while (cursor < lineEnd && *cursor != ' ' && *cursor != '\t' && *cursor != '\r') {
+			cursor++;
+		}
+	}
+}
+
+// Counting pass over one chunk, a single scan for the line starts.
+inline void countObjChunk(ObjChunk& chunk) {
+	for (auto cursor = chunk.begin; cursor < chunk.end;) {
+		auto lineEnd = objLineEnd(cursor, chunk.end);
+		cursor = skipObjSpace(cursor, lineEnd);
+		if (lineEnd - cursor >= 2 && cursor[0] == 'v') {
+			chunk.positions += cursor[1] == ' ' || cursor[1] == '\t';
+			chunk.normals += cursor[1] == 'n';
+			chunk.texCoords += cursor[1] == 't';
+		}
+		else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t')) {
+			auto corners = countObjCorners(cursor + 2, lineEnd);
+			if (corners >= 3) {
+				chunk.corners += corners;
+				chunk.triangles += corners - 2;
+			}
+		}
+		cursor = lineEnd + (lineEnd < chunk.end);
+	}
+}
+
+inline void parseObjAttributes(const ObjChunk& chunk, ObjAttributePools& pools) {
+	auto position = pools.positions.get() + chunk.positionBase;
+	auto normal = pools.normals.get() + chunk.normalBase;
+	auto texCoord = pools.texCoords.get() + chunk.texCoordBase;
+	for (auto cursor = chunk.begin; cursor < chunk.end;) {
+		auto lineEnd = objLineEnd(cursor, chunk.end);
+		cursor = skipObjSpace(cursor, lineEnd);
+		if (lineEnd - cursor >= 2 && cursor[0] == 'v') {
+			if (cursor[1] == ' ' || cursor[1] == '\t') {
+				auto next = parseObjFloat(cursor + 1, lineEnd, position->x);
+				next = parseObjFloat(next, lineEnd, position->y);
+				parseObjFloat(next, lineEnd, position->z);
+				position++;
+			}
+			else if (cursor[1] == 'n') {
+				auto next = parseObjFloat(cursor + 2, lineEnd, normal->x);
+				next = parseObjFloat(next, lineEnd, normal->y);
+				parseObjFloat(next, lineEnd, normal->z);
+				normal++;
+			}
+			else if (cursor[1] == 't') {
+				auto next = skipObjSpace(parseObjFloat(cursor + 2, lineEnd, texCoord->x), lineEnd);
+				// v is optional and defaults to 0
+				texCoord->y = 0.0f;
+				if (next < lineEnd && *next != '\r' && *next != '#') {
+					parseObjFloat(next, lineEnd, texCoord->y);
+				}
+				// OBJ puts v = 0 at the bottom of the image, Vulkan samples row 0 first
+				texCoord->y = 1.0f - texCoord->y;
+				texCoord++;
+			}
+		}
+		cursor = lineEnd + (lineEnd < chunk.end);
+	}
+}
+
+// Every face corner becomes its own vertex and polygons are fanned into triangles. Sharing identical corners
+// would need a global hash table across chunks, which is the optimizer's job, not the loader's.
+inline void parseObjFaces(const ObjChunk& chunk, const ObjAttributePools& pools, MeshVertex* vertices, uint32_t* indices) {
+	uint32_t positionsSoFar = chunk.positionBase;
+	uint32_t normalsSoFar = chunk.normalBase;
+	uint32_t texCoordsSoFar = chunk.texCoordBase;
+	uint32_t corner = chunk.cornerBase;
+	auto index = indices + size_t(chunk.triangleBase) * 3;
+	for (auto cursor = chunk.begin; cursor < chunk.end;) {
+		auto lineEnd = objLineEnd(cursor, chunk.end);
+		cursor = skipObjSpace(cursor, lineEnd);
+		if (lineEnd - cursor >= 2 && cursor[0] == 'v') {
+			positionsSoFar += cursor[1] == ' ' || cursor[1] == '\t';
+			normalsSoFar += cursor[1] == 'n';
+			texCoordsSoFar += cursor[1] == 't';
+		}
+		else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t')
+			&& countObjCorners(cursor + 2, lineEnd) >= 3) {
+			uint32_t firstCorner = corner;
+			cursor += 2;
+			while (true) {
+				cursor = skipObjSpace(cursor, lineEnd);
+				if (cursor >= lineEnd || *cursor == '\r' || *cursor == '#') {
+					break;
+				}
+				// v, v/vt, v//vn or v/vt/vn
+				std::array<int64_t, 3> references = {};
+				for (size_t slot = 0; slot < references.size(); slot++) {
+					if (cursor < lineEnd && *cursor != '/') {
+						auto [next, error] = std::from_chars(cursor, lineEnd, references[slot]);
+						if (error != std::errc()) {
+							throw std::runtime_error("malformed face in OBJ file");
+						}
+						cursor = next;
+					}
+					if (cursor >= lineEnd || *cursor != '/') {
+						break;
+					}
+					cursor++;
+				}
+
+				auto& vertex = vertices[corner];
+				vertex.position = pools.positions[resolveObjIndex(references[0], positionsSoFar)];
+				vertex.texCoord = references[1] != 0 ? pools.texCoords[resolveObjIndex(references[1], texCoordsSoFar)] : glm::vec2(0.0f);
+				vertex.normal = references[2] != 0 ? pools.normals[resolveObjIndex(references[2], normalsSoFar)] : glm::vec3(0.0f);
+				if (corner - firstCorner >= 2) {
+					// OBJ winds counter-clockwise, the pipeline culls with clockwise front faces
+					index[0] = firstCorner;
+					index[1] = corner;
+					index[2] = corner - 1;
+					index += 3;
+				}
+				corner++;
+			}
+		}
+		cursor = lineEnd + (lineEnd < chunk.end);
+	}
+}
+
+inline MeshImportPlan planObjImport(const MappedFile& file, WorkerPool& pool) {
+	MeshImportPlan plan;
+	plan.format = MeshFileFormat::Obj;
+
+	// several chunks per thread so an uneven file still balances, but never slices smaller than 256 KiB
+	const size_t minChunkBytes = 256 * 1024;
+	size_t chunkCount = std::clamp<size_t>(file.size / minChunkBytes, 1, size_t(pool.threadCount()) * 8);
+	auto fileEnd = file.data + file.size;
+	auto chunkBegin = file.data;
+	for (size_t i = 0; i < chunkCount && chunkBegin < fileEnd; i++) {
+		auto chunkEnd = i + 1 == chunkCount ? fileEnd : std::max(chunkBegin, file.data + file.size * (i + 1) / chunkCount);
+		chunkEnd = chunkEnd < fileEnd ? objLineEnd(chunkEnd, fileEnd) : fileEnd;
+		chunkEnd = chunkEnd < fileEnd ? chunkEnd + 1 : fileEnd;
+		ObjChunk chunk;
+		chunk.begin = chunkBegin;
+		chunk.end = chunkEnd;
+		plan.objChunks.push_back(chunk);
+		chunkBegin = chunkEnd;
+	}
+
+	pool.parallelFor(static_cast<uint32_t>(plan.objChunks.size()), [&](uint32_t i) {
+		countObjChunk(plan.objChunks[i]);
+	});
+
+	ObjChunk totals;
+	for (auto& chunk : plan.objChunks) {
+		chunk.positionBase = totals.positions;
+		chunk.normalBase = totals.normals;
+		chunk.texCoordBase = totals.texCoords;
+		chunk.cornerBase = totals.corners;
+		chunk.triangleBase = totals.triangles;
+		totals.positions += chunk.positions;
+		totals.normals += chunk.normals;
+		totals.texCoords += chunk.texCoords;
+		totals.corners += chunk.corners;
+		totals.triangles += chunk.triangles;
+	}
+	plan.vertexCount = totals.corners;
+	plan.indexCount = totals.triangles * 3;
+	return plan;
+}
+
+inline void importObj(const MeshImportPlan& plan, WorkerPool& pool, MeshVertex* vertices, uint32_t* indices) {
+	auto& last = plan.objChunks.back();
+	ObjAttributePools pools;
+	pools.positions.reset(new glm::vec3[last.positionBase + last.positions]);
+	pools.normals.reset(new glm::vec3[last.normalBase + last.normals]);
+	pools.texCoords.reset(new glm::vec2[last.texCoordBase + last.texCoords]);
+
+	auto chunkCount = static_cast<uint32_t>(plan.objChunks.size());
+	// faces may point at attributes of any earlier chunk, so all pools are filled before any face is read
+	pool.parallelFor(chunkCount, [&](uint32_t i) {
+		parseObjAttributes(plan.objChunks[i], pools);
+	});
+	pool.parallelFor(chunkCount, [&](uint32_t i) {
+		parseObjFaces(plan.objChunks[i], pools, vertices, indices);
+	});
+}
+
+// note
+const uint32_t GLB_MAGIC = 0x46546C67;
+const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+const uint32_t GLB_CHUNK_BIN = 0x004E4942;
+const uint32_t GLTF_UNSIGNED_BYTE = 5121;
+const uint32_t GLTF_UNSIGNED_SHORT = 5123;
+const uint32_t GLTF_UNSIGNED_INT = 5125;
+const uint32_t GLTF_FLOAT = 5126;
+const uint32_t GLTF_TRIANGLES = 4;
+const uint32_t GLB_TASK_ELEMENTS = 64 * 1024;
+
+inline uint32_t readLittleEndian32(const char* data) {
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+inline GlbAccessor resolveGlbAccessor(const JsonValue& json, uint32_t accessorIndex, const char* bin, size_t binSize,
+	uint32_t expectedComponentType, uint32_t components) {
+	auto& accessor = json["accessors"][accessorIndex];
+	auto& bufferView = json["bufferViews"][accessor["bufferView"].asIndex()];
+	if (bufferView.indexOr("buffer", 0) != 0) {
+		throw std::runtime_error("glTF binary accessor points outside the BIN chunk");
+	}
+
+	GlbAccessor resolved;
+	resolved.componentType = accessor["componentType"].asIndex();
+	if (expectedComponentType != 0 && resolved.componentType != expectedComponentType) {
+		throw std::runtime_error("unsupported glTF accessor component type");
+	}
+	uint32_t componentSize = resolved.componentType == GLTF_UNSIGNED_BYTE ? 1 : resolved.componentType == GLTF_UNSIGNED_SHORT ? 2 : 4;
+	resolved.count = accessor["count"].asIndex();
+	resolved.stride = bufferView.indexOr("byteStride", componentSize * components);
+	size_t offset = size_t(bufferView.indexOr("byteOffset", 0)) + accessor.indexOr("byteOffset", 0);
+	size_t lastByte = offset + (resolved.count ? size_t(resolved.count - 1) * resolved.stride + componentSize * components : 0);
+	if (lastByte > binSize || lastByte > offset + bufferView["byteLength"].asIndex()) {
+		throw std::runtime_error("glTF accessor runs past its buffer view");
+	}
+	resolved.data = bin + offset;
+	return resolved;
+}
+
+// Reads the JSON chunk and resolves every triangle primitive of every mesh to pointers into the mapped BIN chunk.
+// Node transforms are not applied, the primitives land in the buffer in mesh space one after another.
+inline MeshImportPlan planGlbImport(const MappedFile& file) {
+	if (file.size < 20 || readLittleEndian32(file.data) != GLB_MAGIC || readLittleEndian32(file.data + 4) != 2) {
+		throw std::runtime_error("not a glTF 2.0 binary file");
+	}
+	const char* json = nullptr;
+	size_t jsonSize = 0;
+	const char* bin = nullptr;
+	size_t binSize = 0;
+	for (size_t offset = 12; offset + 8 <= file.size;) {
+		size_t chunkSize = readLittleEndian32(file.data + offset);
+		uint32_t chunkType = readLittleEndian32(file.data + offset + 4);
+		if (offset + 8 + chunkSize > file.size) {
+			throw std::runtime_error("truncated glTF binary chunk");
+		}
+		if (chunkType == GLB_CHUNK_JSON) {
+			json = file.data + offset + 8;
+			jsonSize = chunkSize;
+		}
+		else if (chunkType == GLB_CHUNK_BIN) {
+			bin = file.data + offset + 8;
+			binSize = chunkSize;
+		}
+		offset += 8 + ((chunkSize + 3) & ~size_t(3));
+	}
+	if (!json || !bin) {
+		throw std::runtime_error("glTF binary file needs both a JSON and a BIN chunk");
+	}
+
+	JsonParser parser{ json, json + jsonSize };
+	auto document = parser.parse();
+
+	MeshImportPlan plan;
+	plan.format = MeshFileFormat::Glb;
+	for (auto& mesh : document["meshes"].array) {
+		for (auto& primitive : mesh["primitives"].array) {
+			if (primitive.indexOr("mode", GLTF_TRIANGLES) != GLTF_TRIANGLES) {
+				continue;
+			}
+			auto& attributes = primitive["attributes"];
+			GlbPrimitive resolved;
+			resolved.positions = resolveGlbAccessor(document, attributes["POSITION"].asIndex(), bin, binSize, GLTF_FLOAT, 3);
+			if (auto normal = attributes.find("NORMAL")) {
+				resolved.normals = resolveGlbAccessor(document, normal->asIndex(), bin, binSize, GLTF_FLOAT, 3);
+			}
+			if (auto texCoord = attributes.find("TEXCOORD_0")) {
+				resolved.texCoords = resolveGlbAccessor(document, texCoord->asIndex(), bin, binSize, GLTF_FLOAT, 2);
+			}
+			if (auto indices = primitive.find("indices")) {
+				resolved.indices = resolveGlbAccessor(document, indices->asIndex(), bin, binSize, 0, 1);
+			}
+			resolved.vertexBase = plan.vertexCount;
+			resolved.indexBase = plan.indexCount;
+			resolved.indexCount = resolved.indices.data ? resolved.indices.count : resolved.positions.count;
+			// the winding swap reads one index ahead, a partial triangle would read past the accessor
+			if (resolved.indexCount % 3 != 0) {
+				throw std::runtime_error("failed to import glTF primitive, its index count is not a multiple of 3");
+			}
+			plan.vertexCount += resolved.positions.count;
+			plan.indexCount += resolved.indexCount;
+
+			auto primitiveIndex = static_cast<uint32_t>(plan.primitives.size());
+			for (uint32_t first = 0; first < resolved.positions.count; first += GLB_TASK_ELEMENTS) {
+				plan.glbTasks.push_back({ primitiveIndex, false, first, std::min(GLB_TASK_ELEMENTS, resolved.positions.count - first) });
+			}
+			for (uint32_t first = 0; first < resolved.indexCount; first += GLB_TASK_ELEMENTS) {
+				plan.glbTasks.push_back({ primitiveIndex, true, first, std::min(GLB_TASK_ELEMENTS, resolved.indexCount - first) });
+			}
+			plan.primitives.push_back(resolved);
+		}
+	}
+	return plan;
+}
+
+inline void fillGlbTask(const GlbPrimitive& primitive, const GlbTask& task, MeshVertex* vertices, uint32_t* indices) {
+	if (!task.indices) {
+		for (uint32_t i = task.first; i < task.first + task.count; i++) {
+			auto& vertex = vertices[primitive.vertexBase + i];
+			memcpy(&vertex.position, primitive.positions.data + size_t(i) * primitive.positions.stride, sizeof(glm::vec3));
+			if (primitive.normals.data) {
+				memcpy(&vertex.normal, primitive.normals.data + size_t(i) * primitive.normals.stride, sizeof(glm::vec3));
+			}
+			else {
+				vertex.normal = glm::vec3(0.0f);
+			}
+			if (primitive.texCoords.data) {
+				memcpy(&vertex.texCoord, primitive.texCoords.data + size_t(i) * primitive.texCoords.stride, sizeof(glm::vec2));
+			}
+			else {
+				vertex.texCoord = glm::vec2(0.0f);
+			}
+		}
+		return;
+	}
+
+	// glTF winds counter-clockwise, swapping the last two indices of each triangle flips it for the pipeline
+	auto& source = primitive.indices;
+	for (uint32_t i = task.first; i < task.first + task.count; i++) {
+		uint32_t sourceIndex = i % 3 == 1 ? i + 1 : i % 3 == 2 ? i - 1 : i;
+		uint32_t value = sourceIndex;
+		if (source.data) {
+			auto element = source.data + size_t(sourceIndex) * source.stride;
+			if (source.componentType == GLTF_UNSIGNED_BYTE) {
+				value = static_cast<uint8_t>(*element);
+			}
+			else if (source.componentType == GLTF_UNSIGNED_SHORT) {
+				uint16_t shortValue;
+				memcpy(&shortValue, element, sizeof(shortValue));
+				value = shortValue;
+			}
+			else {
+				memcpy(&value, element, sizeof(value));
+			}
+			if (value >= primitive.positions.count) {
+				throw std::runtime_error("failed to import glTF primitive, an index is past its vertex count");
+			}
+		}
+		indices[primitive.indexBase + i] = primitive.vertexBase + value;
+	}
+}
+
+inline MeshFileFormat meshFileFormatOf(const std::string& path) {
+	auto extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	if (extension == ".obj") {
+		return MeshFileFormat::Obj;
+	}
+	if (extension == ".glb") {
+		return MeshFileFormat::Glb;
+	}
+	throw std::runtime_error("unsupported mesh file " + path + ", expected .obj or .glb");
+}
+
+inline MeshImportPlan planMeshImport(const MappedFile& file, MeshFileFormat format, WorkerPool& pool) {
+	return format == MeshFileFormat::Obj ? planObjImport(file, pool) : planGlbImport(file);
+}
+
+// Writes vertices and indices of a planned import to their final place, normally mapped staging memory.
+// Only ever written, never read back, so write-combined memory is fine.
+inline void importMesh(const MeshImportPlan& plan, WorkerPool& pool, MeshVertex* vertices, uint32_t* indices) {
+	if (plan.format == MeshFileFormat::Obj) {
+		if (!plan.objChunks.empty()) {
+			importObj(plan, pool, vertices, indices);
+		}
+		return;
+	}
+	pool.parallelFor(static_cast<uint32_t>(plan.glbTasks.size()), [&](uint32_t i) {
+		auto& task = plan.glbTasks[i];
+		fillGlbTask(plan.primitives[task.primitive], task, vertices, indices);
+	});
+}
+
+const uint32_t WIDTH = 800;
+const uint32_t HEIGHT = 600;
+
+// note
+const int MAX_FRAMES_IN_FLIGHT = 2;
+const uint32_t SCENE_SPHERE_RINGS = 64;
+const uint32_t SCENE_SPHERE_SEGMENTS = 128;
+// about a million vertices and two million triangles per benchmark draw
+const uint32_t VERTEX_BENCHMARK_RINGS = 1024;
+const uint32_t VERTEX_BENCHMARK_SEGMENTS = 1024;
+const uint32_t VERTEX_BENCHMARK_DRAWS = 8;
+// written out as OBJ when no mesh files are given on the command line, roughly 45 MB
+const uint32_t MESH_IMPORT_SYNTHETIC_RINGS = 512;
+const uint32_t MESH_IMPORT_SYNTHETIC_SEGMENTS = 512;
+
+// note
+// A color image the size of the swap chain that benchmarks render into, with the render pass and framebuffer
+// to draw to it.
+struct OffscreenTarget {
+	VkImage                           image = nullptr;
+	VkDeviceMemory                   memory = nullptr;
+	VkImageView                        view = nullptr;
+	VkRenderPass                 renderPass = nullptr;
+	VkFramebuffer               framebuffer = nullptr;
+};
+
+class HelloTriangleApplication {
+public:
+	// note
+	// .obj or .glb files for the import benchmark, taken from the command line
+	std::vector<std::string> meshImportPaths;
+
+	void run() {
+		initWindow();
+		initVulkan();
+		mainLoop();
+		cleanup();
+	}
+
+private:
+	GLFWwindow* window = nullptr;
+	VkInstance                             instance = nullptr;
+	VkPhysicalDevice                 physicalDevice = nullptr;
+	VkDevice                                 device = nullptr;
+	VkSurfaceKHR                            surface = nullptr;
+	VkQueue                           graphicsQueue = nullptr;
+	VkQueue                            presentQueue = nullptr;
+	VkSwapchainKHR                        swapChain = nullptr;
+	std::vector<VkImage>            swapChainImages;
+	VkFormat                   swapChainImageFormat;
+	VkExtent2D                      swapChainExtent;
+	std::vector<VkImageView>    swapChainImageViews;
+
+	VkShaderModule                 vertShaderModule = nullptr;
+	VkShaderModule                 fragShaderModule = nullptr;
+
+	VkPipelineLayout                 pipelineLayout = nullptr;
+
+	PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = nullptr;
+	PFN_vkGetDeviceProcAddr     vkGetDeviceProcAddr = nullptr;
+	PFN_vkDestroyInstance         vkDestroyInstance = nullptr;
+	PFN_vkDestroyDevice             vkDestroyDevice = nullptr;
+	PFN_vkDestroySurfaceKHR	    vkDestroySurfaceKHR = nullptr;
+	PFN_vkDestroySwapchainKHR vkDestroySwapchainKHR = nullptr;
+	PFN_vkDestroyImageView	     vkDestroyImageView = nullptr;
+	PFN_vkDestroyShaderModule vkDestroyShaderModule = nullptr;
+	PFN_vkDestroyPipelineLayout vkDestroyPipelineLayout;
+
+	// note
+	VkRenderPass                         renderPass = nullptr;
+	PFN_vkDestroyRenderPass     vkDestroyRenderPass;
+	VkPipeline                     graphicsPipeline = nullptr;
+	PFN_vkDestroyPipeline         vkDestroyPipeline;
+
+	// note
+	// graphicsPipeline draws interleaved meshes, splitStreamPipeline the split stream ones
+	VkPipeline                  splitStreamPipeline = nullptr;
+	VkShaderModule             positionShaderModule = nullptr;
+	std::vector<GpuMesh>                     meshes;
+
+	// note
+	QueueFamilyIndices           queueFamilyIndices;
+	std::vector<VkFramebuffer>  swapChainFramebuffers;
+	VkCommandPool                       commandPool = nullptr;
+	std::vector<VkCommandBuffer>       commandBuffers;
+	std::vector<VkSemaphore> imageAvailableSemaphores;
+	std::vector<VkSemaphore> renderFinishedSemaphores;
+	std::vector<VkFence>               inFlightFences;
+	uint32_t                           currentFrame = 0;
+
+	PFN_vkDestroyFramebuffer     vkDestroyFramebuffer = nullptr;
+	PFN_vkDestroyCommandPool     vkDestroyCommandPool = nullptr;
+	PFN_vkDestroySemaphore         vkDestroySemaphore = nullptr;
+	PFN_vkDestroyFence                 vkDestroyFence = nullptr;
+	PFN_vkDestroyBuffer               vkDestroyBuffer = nullptr;
+	PFN_vkFreeMemory                     vkFreeMemory = nullptr;
+	PFN_vkDeviceWaitIdle             vkDeviceWaitIdle = nullptr;
+	PFN_vkWaitForFences               vkWaitForFences = nullptr;
+	PFN_vkResetFences                   vkResetFences = nullptr;
+	PFN_vkAcquireNextImageKHR   vkAcquireNextImageKHR = nullptr;
+	PFN_vkQueueSubmit                   vkQueueSubmit = nullptr;
+	PFN_vkQueuePresentKHR           vkQueuePresentKHR = nullptr;
+	PFN_vkBeginCommandBuffer     vkBeginCommandBuffer = nullptr;
+	PFN_vkEndCommandBuffer         vkEndCommandBuffer = nullptr;
+	PFN_vkResetCommandBuffer     vkResetCommandBuffer = nullptr;
+	PFN_vkCmdBeginRenderPass     vkCmdBeginRenderPass = nullptr;
+	PFN_vkCmdEndRenderPass         vkCmdEndRenderPass = nullptr;
+	PFN_vkCmdBindPipeline           vkCmdBindPipeline = nullptr;
+	PFN_vkCmdBindVertexBuffers vkCmdBindVertexBuffers = nullptr;
+	PFN_vkCmdBindIndexBuffer     vkCmdBindIndexBuffer = nullptr;
+	PFN_vkCmdDrawIndexed             vkCmdDrawIndexed = nullptr;
+	PFN_vkCmdCopyBuffer               vkCmdCopyBuffer = nullptr;
+
+#ifndef NDEBUG
+	VkDebugUtilsMessengerEXT         debugMessenger = nullptr;
+	PFN_vkDestroyDebugUtilsMessengerEXT vkDestroyDebugUtilsMessengerEXT = nullptr;
+#endif
+
+	void initWindow() {
+		glfwInit();
+
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+
+		window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan", nullptr, nullptr);
+	}
+
+	void initVulkan() {
+		initInstance();
+		createSurface();
+		selectPhysicalDevice();
+		initDevice();
+		createSwapChain();
+		createImageViews();
+		// note
+		createRenderPass();
+		createGraphicsPipeline();
+		// note
+		createFramebuffers();
+		createCommandPool();
+		createCommandBuffers();
+		createSyncObjects();
+		createMeshes();
+		benchmarkVertexFetch();
+		// note
+		benchmarkMeshImport();
+	}
+
+	void mainLoop() {
+		while (!glfwWindowShouldClose(window)) {
+			glfwPollEvents();
+			drawFrame();
+		}
+
+		vkDeviceWaitIdle(device);
+	}
+
+	void cleanup() {
+
+		// note
+		for (auto& mesh : meshes) {
+			destroyMesh(mesh);
+		}
+		for (auto semaphore : imageAvailableSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto semaphore : renderFinishedSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto fence : inFlightFences) {
+			vkDestroyFence(device, fence, nullptr);
+		}
+		if (vkDestroyCommandPool) {
+			vkDestroyCommandPool(device, commandPool, nullptr);
+		}
+		for (auto framebuffer : swapChainFramebuffers) {
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+		}
+
+		// note
+		if (vkDestroyPipeline) {
+			vkDestroyPipeline(device, graphicsPipeline, nullptr);
+			vkDestroyPipeline(device, splitStreamPipeline, nullptr);
+		}
+
+		if (vkDestroyPipelineLayout) {
+			vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+		}
+
+		// note
+		if (vkDestroyRenderPass) {
+			vkDestroyRenderPass(device, renderPass, nullptr);
+		}
+
+		if (vkDestroyShaderModule) {
+			vkDestroyShaderModule(device, vertShaderModule, nullptr);
+			vkDestroyShaderModule(device, fragShaderModule, nullptr);
+			vkDestroyShaderModule(device, positionShaderModule, nullptr);
+		}
+
+		for (auto imageView : swapChainImageViews) {
+			vkDestroyImageView(device, imageView, nullptr);
+		}
+
+		vkDestroySwapchainKHR(device, swapChain, nullptr);
+		if (vkDestroyDevice) {
+			vkDestroyDevice(device, nullptr);
+
+		}
+#ifndef NDEBUG
+		if (vkDestroyDebugUtilsMessengerEXT) {
+			vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+		}
+#endif
+		if (vkDestroyInstance) {
+			vkDestroySurfaceKHR(instance, surface, nullptr);
+			vkDestroyInstance(instance, nullptr);
+		}
+		glfwDestroyWindow(window);
+
+		glfwTerminate();
+	}
+
+	void initInstance() {
+		vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)glfwGetInstanceProcAddress(nullptr, "vkGetInstanceProcAddr");
+		auto vkEnumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+		auto vkEnumerateInstanceExtensionProperties = (PFN_vkEnumerateInstanceExtensionProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceExtensionProperties");
+		auto vkEnumerateInstanceLayerProperties = (PFN_vkEnumerateInstanceLayerProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceLayerProperties");
+		auto vkCreateInstance = (PFN_vkCreateInstance)vkGetInstanceProcAddr(nullptr, "vkCreateInstance");
+
+		uint32_t supportedVersion = 0u;
+		VkResult result = vkEnumerateInstanceVersion(&supportedVersion);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Version: " << VK_VERSION_MAJOR(supportedVersion) << "." << VK_VERSION_MINOR(supportedVersion) << "." << VK_VERSION_PATCH(supportedVersion) << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to enumerate instance version");
+		}
+
+		auto requestInstanceVersion = 0u;
+		if (supportedVersion >= VK_API_VERSION_1_3) {
+			requestInstanceVersion = VK_API_VERSION_1_3;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_2) {
+			requestInstanceVersion = VK_API_VERSION_1_2;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_1) {
+			requestInstanceVersion = VK_API_VERSION_1_1;
+		}
+		else {
+			requestInstanceVersion = VK_API_VERSION_1_0;
+		}
+
+		VkApplicationInfo  appInfo = {};
+		appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+		appInfo.pApplicationName = "Hello Triangle";
+		appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.pEngineName = "No Engine";
+		appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.apiVersion = requestInstanceVersion;
+		appInfo.pNext = nullptr;
+
+		uint32_t        extensionCount = 0;
+		auto ppExtensioNames = glfwGetRequiredInstanceExtensions(&extensionCount);
+
+		std::vector<const char*> requestedInstanceExtensions = std::vector<const char*>(ppExtensioNames, ppExtensioNames + extensionCount);
+#ifndef NDEBUG
+		requestedInstanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+#endif
+		std::vector<const char*> requestedInstanceLayers = {
+			//	"VK_LAYER_LUNARG_api_dump"
+		};
+#ifndef NDEBUG
+		requestedInstanceLayers.push_back("VK_LAYER_KHRONOS_validation");
+#endif		
+
+		std::vector<const char*> enabledInstanceExtensions;
+		std::vector<const char*> enabledInstanceLayers;
+
+		auto instanceExtensionPropCount = 0u;
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(instanceExtensionPropCount);
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, extensionProps.data());
+
+		auto instanceLayerPropCount = 0u;
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, nullptr);
+		std::vector<VkLayerProperties> layerProps(instanceLayerPropCount);
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, layerProps.data());
+
+		for (auto& requestedInstanceExtension : requestedInstanceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedInstanceExtension)) {
+				throw std::runtime_error("failed to find instance extension: " + std::string(requestedInstanceExtension));
+			}
+		}
+		for (auto& requestedInstanceLayer : requestedInstanceLayers) {
+			if (!findLayerProperties(layerProps, requestedInstanceLayer)) {
+				throw std::runtime_error("failed to find instance layer: " + std::string(requestedInstanceLayer));
+			}
+		}
+
+		enabledInstanceExtensions = requestedInstanceExtensions;
+		enabledInstanceLayers = requestedInstanceLayers;
+
+		VkInstanceCreateInfo createInfo = {};
+		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+		createInfo.pApplicationInfo = &appInfo;
+		createInfo.enabledExtensionCount = enabledInstanceExtensions.size();
+		createInfo.ppEnabledExtensionNames = enabledInstanceExtensions.data();
+		createInfo.enabledLayerCount = enabledInstanceLayers.size();
+		createInfo.ppEnabledLayerNames = enabledInstanceLayers.data();
+
+		result = vkCreateInstance(&createInfo, nullptr, &instance);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Instance created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create instance");
+		}
+		vkDestroyInstance = (PFN_vkDestroyInstance)vkGetInstanceProcAddr(instance, "vkDestroyInstance");
+
+#ifndef NDEBUG
+		auto vkCreateDebugUtilsMessengerEXT = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
+		VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = {};
+		debugCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+		debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+		debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+		debugCreateInfo.pfnUserCallback = debugCallback;
+		result = vkCreateDebugUtilsMessengerEXT(instance, &debugCreateInfo, nullptr, &debugMessenger);
+		if (result == VK_SUCCESS) {
+			std::cout << "Debug Messenger created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create debug messenger");
+		}
+		vkDestroyDebugUtilsMessengerEXT = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+#endif
+	}
+
+	void createSurface()
+	{
+		vkDestroySurfaceKHR = (PFN_vkDestroySurfaceKHR)vkGetInstanceProcAddr(instance, "vkDestroySurfaceKHR");
+		if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create window surface!");
+		}
+	}
+
+	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails details;
+		auto vkGetPhysicalDeviceSurfaceCapabilitiesKHR = (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"); // notice that instance, not device
+		auto vkGetPhysicalDeviceSurfaceFormatsKHR = (PFN_vkGetPhysicalDeviceSurfaceFormatsKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+		auto vkGetPhysicalDeviceSurfacePresentModesKHR = (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
+
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physDev, surface, &details.capabilities);
+
+		uint32_t formatCount = 0;
+		vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, nullptr);
+		if (formatCount != 0) {
+			details.formats.resize(formatCount);
+			vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, details.formats.data());
+		}
+
+		uint32_t presentModeCount = 0;
+		vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, nullptr);
+		if (presentModeCount != 0) {
+			details.presentModes.resize(presentModeCount);
+			vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, details.presentModes.data());
+		}
+
+		return details;
+	}
+
+	bool isDeviceSuitable(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physDev);
+		if (!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty()) {
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	void selectPhysicalDevice() {
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		auto physicalDeviceCount = 0u;
+		auto result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, nullptr);
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+		std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+		result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, physicalDevices.data());
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+
+		for (auto& physDev : physicalDevices) {
+			VkPhysicalDeviceProperties physicalDeviceProperties;
+			vkGetPhysicalDeviceProperties(physDev, &physicalDeviceProperties);
+			std::cout << "Physical Device: " << physicalDeviceProperties.deviceName << std::endl;
+			std::cout << "API Version: " << VK_VERSION_MAJOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_MINOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_PATCH(physicalDeviceProperties.apiVersion) << std::endl;
+			std::cout << "Driver Version: " << physicalDeviceProperties.driverVersion << std::endl;
+			std::cout << "Vendor ID: " << physicalDeviceProperties.vendorID << std::endl;
+			std::cout << "Device ID: " << physicalDeviceProperties.deviceID << std::endl;
+			VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+			vkGetPhysicalDeviceFeatures(physDev, &physicalDeviceFeatures);
+			std::cout << "GeometryShader    : " << physicalDeviceFeatures.geometryShader << std::endl;
+			std::cout << "TessellationShader: " << physicalDeviceFeatures.tessellationShader << std::endl;
+			std::uint32_t extensionCount;
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, nullptr);
+			std::vector<VkExtensionProperties> extensionProps(extensionCount);
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, extensionProps.data());
+			std::cout << "ExtensionCount: " << extensionProps.size() << std::endl;
+			size_t index = 0;
+			for (auto& extensionProp : extensionProps) {
+				std::cout << "Extensions[" << index << "]: " << extensionProp.extensionName << std::endl;
+				index++;
+			}
+			if (vkGetPhysicalDeviceFeatures2) {
+				// Query Vulkan Features
+				VkPhysicalDeviceFeatures2        physicalDeviceFeatures2 = {};
+				VkPhysicalDeviceVulkan11Features physicalDeviceVulkan11Features = {};
+				VkPhysicalDeviceVulkan12Features physicalDeviceVulkan12Features = {};
+				VkPhysicalDeviceVulkan13Features physicalDeviceVulkan13Features = {};
+				physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				physicalDeviceVulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+				physicalDeviceVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				physicalDeviceVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+				physicalDeviceFeatures2.pNext = &physicalDeviceVulkan11Features;
+				physicalDeviceVulkan11Features.pNext = &physicalDeviceVulkan12Features;
+				physicalDeviceVulkan12Features.pNext = &physicalDeviceVulkan13Features;
+				physicalDeviceVulkan13Features.pNext = nullptr;
+				vkGetPhysicalDeviceFeatures2(physDev, &physicalDeviceFeatures2);
+				std::cout << "BufferDeviceAddress: " << physicalDeviceVulkan12Features.bufferDeviceAddress << std::endl;
+				std::cout << "DynamicRendering   : " << physicalDeviceVulkan13Features.dynamicRendering << std::endl;
+			}
+			auto queueFamilyCount = 0u;
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+			std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilyProps.data());
+			std::cout << "QueueFamilyCount: " << queueFamilyProps.size() << std::endl;
+			for (auto& queueFamilyProp : queueFamilyProps) {
+				std::cout << "QueueFlags: ";
+				if (queueFamilyProp.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+					std::cout << "GRAPHICS |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_COMPUTE_BIT) {
+					std::cout << "COMPUTE |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_TRANSFER_BIT) {
+					std::cout << "TRANSFER |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) {
+					std::cout << "SPARSE_BINDING |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_PROTECTED_BIT) {
+					std::cout << "PROTECTED |";
+				}
+				std::cout << std::endl;
+				std::cout << "QueueCount: " << queueFamilyProp.queueCount << std::endl;
+				std::cout << "TimestampValidBits: " << queueFamilyProp.timestampValidBits << std::endl;
+			}
+		}
+
+		if (physicalDevices.size() > 0 && isDeviceSuitable(physicalDevices[0])) {
+			physicalDevice = physicalDevices[0];
+		}
+		else {
+			throw std::runtime_error("failed to find a physical device with Vulkan support");
+		}
+
+
+	}
+
+	QueueFamilyIndices findQueueFamilies(VkPhysicalDevice physDev)
+	{
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+
+		QueueFamilyIndices indices;
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilies.data());
+
+		int i = 0;
+		for (const auto& queueFamily : queueFamilies) {
+			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+				indices.graphicsFamily = i;
+			}
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physDev, i, surface, &presentSupport);
+
+			if (presentSupport) {
+				indices.presentFamily = i;
+			}
+
+			if (indices.isComplete()) {
+				break;
+			}
+			i++;
+		}
+
+		return indices;
+	}
+
+	void initDevice() {
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		std::uint32_t extensionCount;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(extensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensionProps.data());
+
+		std::vector<const char*> requestedDeviceExtensions = std::vector<const char*>{
+			VK_KHR_SWAPCHAIN_EXTENSION_NAME
+		};
+		std::vector<const char*> enabledDeviceExtensions;
+		for (auto& requestedDeviceExtension : requestedDeviceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedDeviceExtension)) {
+				throw std::runtime_error("failed to find device extension: " + std::string(requestedDeviceExtension));
+			}
+		}
+
+		enabledDeviceExtensions = requestedDeviceExtensions;
+
+		VkDeviceCreateInfo deviceCreateInfo = {};
+		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		deviceCreateInfo.enabledExtensionCount = requestedDeviceExtensions.size();
+		deviceCreateInfo.ppEnabledExtensionNames = requestedDeviceExtensions.data();
+
+		VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &physicalDeviceFeatures);
+		deviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
+
+		auto queueFamilyCount = 0u;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProps.data());
+
+		// note
+		queueFamilyIndices = findQueueFamilies(physicalDevice);
+		std::set<uint32_t> uniqueQueueFamilyIndices = { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value() };
+
+		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+		float queuePriority = 1.0f;
+		for (uint32_t uniqueQueueFamilyindex : uniqueQueueFamilyIndices) {
+			VkDeviceQueueCreateInfo queueCreateInfo = {};
+			queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queueCreateInfo.queueFamilyIndex = uniqueQueueFamilyindex;
+			queueCreateInfo.queueCount = 1;
+			queueCreateInfo.pQueuePriorities = &queuePriority;
+			queueCreateInfos.push_back(queueCreateInfo);
+		}
+
+		deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
+		deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+
+		auto vkCreateDevice = (PFN_vkCreateDevice)vkGetInstanceProcAddr(instance, "vkCreateDevice");
+		auto result = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Device created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create device");
+		}
+
+		vkGetDeviceProcAddr = (PFN_vkGetDeviceProcAddr)vkGetInstanceProcAddr(instance, "vkGetDeviceProcAddr");
+		auto vkGetDeviceQueue = (PFN_vkGetDeviceQueue)vkGetDeviceProcAddr(device, "vkGetDeviceQueue");
+		vkDestroyDevice = (PFN_vkDestroyDevice)vkGetDeviceProcAddr(device, "vkDestroyDevice");
+
+		vkGetDeviceQueue(device, queueFamilyIndices.graphicsFamily.value(), 0, &graphicsQueue);
+		vkGetDeviceQueue(device, queueFamilyIndices.presentFamily.value(), 0, &presentQueue);
+	}
+
+	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
+	{
+		for (const auto& availableFormat : availableFormats) {
+			if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+				return availableFormat;
+			}
+		}
+
+		return availableFormats[0];
+	}
+
+	VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
+	{
+		for (const auto& availablePresentMode : availablePresentModes) {
+			if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+				return availablePresentMode;
+			}
+		}
+
+		return VK_PRESENT_MODE_FIFO_KHR;
+	}
+
+	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
+	{
+		if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+			return capabilities.currentExtent;
+		}
+		else {
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+
+			VkExtent2D actualExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+
+			actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+			actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+
+			return actualExtent;
+		}
+	}
+
+	void createSwapChain()
+	{
+		auto vkCreateSwapchainKHR = (PFN_vkCreateSwapchainKHR)vkGetDeviceProcAddr(device, "vkCreateSwapchainKHR");
+		auto vkGetSwapchainImagesKHR = (PFN_vkGetSwapchainImagesKHR)vkGetDeviceProcAddr(device, "vkGetSwapchainImagesKHR");
+
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
+
+		VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
+		VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+		VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
+
+		uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+
+		if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
+			imageCount = swapChainSupport.capabilities.maxImageCount;
+		}
+
+		VkSwapchainCreateInfoKHR createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+		createInfo.surface = surface;
+		createInfo.minImageCount = imageCount;
+		createInfo.imageFormat = surfaceFormat.format;
+		createInfo.imageColorSpace = surfaceFormat.colorSpace;
+		createInfo.imageExtent = extent;
+		createInfo.imageArrayLayers = 1;
+		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+		// note
+		QueueFamilyIndices indices = queueFamilyIndices;
+		uint32_t sharedQueueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+
+		if (indices.graphicsFamily != indices.presentFamily) {
+			createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+			createInfo.queueFamilyIndexCount = 2;
+			createInfo.pQueueFamilyIndices = sharedQueueFamilyIndices;
+		}
+		else {
+			createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			/*createInfo.queueFamilyIndexCount = 0;
+			createInfo.pQueueFamilyIndices = nullptr;*/
+		}
+
+		createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
+		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+		createInfo.presentMode = presentMode;
+		createInfo.clipped = VK_TRUE;
+
+		createInfo.oldSwapchain = VK_NULL_HANDLE;
+
+		if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create swap chain!");
+		}
+
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);
+		swapChainImages.resize(imageCount);
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImages.data());
+
+		swapChainImageFormat = surfaceFormat.format;
+		swapChainExtent = extent;
+
+		vkDestroySwapchainKHR = (PFN_vkDestroySwapchainKHR)vkGetDeviceProcAddr(device, "vkDestroySwapchainKHR");
+	}
+
+	void createImageViews()
+	{
+		auto vkCreateImageView = (PFN_vkCreateImageView)vkGetDeviceProcAddr(device, "vkCreateImageView");
+
+		swapChainImageViews.resize(swapChainImages.size());
+
+		for (size_t i = 0; i < swapChainImages.size(); i++) {
+			VkImageViewCreateInfo createInfo{};
+			createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			createInfo.image = swapChainImages[i];
+			createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+			createInfo.format = swapChainImageFormat;
+			createInfo.components.r = VK_COMPONENT_SWIZZLE_R;
+			createInfo.components.g = VK_COMPONENT_SWIZZLE_G;
+			createInfo.components.b = VK_COMPONENT_SWIZZLE_B;
+			createInfo.components.a = VK_COMPONENT_SWIZZLE_A;
+			createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			createInfo.subresourceRange.baseMipLevel = 0;
+			createInfo.subresourceRange.levelCount = 1;
+			createInfo.subresourceRange.baseArrayLayer = 0;
+			createInfo.subresourceRange.layerCount = 1;
+
+			if (vkCreateImageView(device, &createInfo, nullptr, &swapChainImageViews[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create image views!");
+			}
+		}
+
+		vkDestroyImageView = (PFN_vkDestroyImageView)vkGetDeviceProcAddr(device, "vkDestroyImageView");
+	}
+
+	// note
+	void createRenderPass() {
+		renderPass = createRenderPass(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+		vkDestroyRenderPass = (PFN_vkDestroyRenderPass)vkGetDeviceProcAddr(device, "vkDestroyRenderPass");
+	}
+
+	// note
+	// Benchmarks keep their color image as an attachment instead. Layouts don't take part in render pass
+	// compatibility, the pipelines made for renderPass draw in either.
+	VkRenderPass createRenderPass(VkImageLayout colorFinalLayout) {
+		VkAttachmentDescription colorAttachment{};
+		colorAttachment.format = swapChainImageFormat;
+		colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		colorAttachment.finalLayout = colorFinalLayout;
+
+		VkAttachmentReference colorAttachmentRef{};
+		colorAttachmentRef.attachment = 0;
+		colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		VkSubpassDescription subpass{};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &colorAttachmentRef;
+
+		// note
+		VkSubpassDependency dependency{};
+		dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependency.dstSubpass = 0;
+		dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependency.srcAccessMask = 0;
+		dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+		VkRenderPassCreateInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassInfo.attachmentCount = 1;
+		renderPassInfo.pAttachments = &colorAttachment;
+		renderPassInfo.subpassCount = 1;
+		renderPassInfo.pSubpasses = &subpass;
+		renderPassInfo.dependencyCount = 1;
+		renderPassInfo.pDependencies = &dependency;
+
+		auto vkCreateRenderPass = (PFN_vkCreateRenderPass)vkGetInstanceProcAddr(instance, "vkCreateRenderPass");
+		VkRenderPass created = nullptr;
+		if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &created) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create render pass");
+		}
+		return created;
+	}
+
+	// note
+	// Swap chain images belong to the presentation engine until they are acquired, benchmarks draw here instead.
+	OffscreenTarget createOffscreenTarget() {
+		auto vkCreateImage = (PFN_vkCreateImage)vkGetDeviceProcAddr(device, "vkCreateImage");
+		auto vkGetImageMemoryRequirements = (PFN_vkGetImageMemoryRequirements)vkGetDeviceProcAddr(device, "vkGetImageMemoryRequirements");
+		auto vkAllocateMemory = (PFN_vkAllocateMemory)vkGetDeviceProcAddr(device, "vkAllocateMemory");
+		auto vkBindImageMemory = (PFN_vkBindImageMemory)vkGetDeviceProcAddr(device, "vkBindImageMemory");
+		auto vkCreateImageView = (PFN_vkCreateImageView)vkGetDeviceProcAddr(device, "vkCreateImageView");
+		auto vkCreateFramebuffer = (PFN_vkCreateFramebuffer)vkGetDeviceProcAddr(device, "vkCreateFramebuffer");
+
+		OffscreenTarget target;
+		target.renderPass = createRenderPass(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = swapChainImageFormat;
+		imageInfo.extent = { swapChainExtent.width, swapChainExtent.height, 1 };
+		imageInfo.mipLevels = 1;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		if (vkCreateImage(device, &imageInfo, nullptr, &target.image) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create offscreen image");
+		}
+
+		VkMemoryRequirements memRequirements;
+		vkGetImageMemoryRequirements(device, target.image, &memRequirements);
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize = memRequirements.size;
+		allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		if (vkAllocateMemory(device, &allocInfo, nullptr, &target.memory) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate offscreen image memory");
+		}
+		vkBindImageMemory(device, target.image, target.memory, 0);
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = target.image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = swapChainImageFormat;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		if (vkCreateImageView(device, &viewInfo, nullptr, &target.view) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create offscreen image view");
+		}
+
+		VkImageView attachments[] = { target.view };
+
+		VkFramebufferCreateInfo framebufferInfo{};
+		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferInfo.renderPass = target.renderPass;
+		framebufferInfo.attachmentCount = 1;
+		framebufferInfo.pAttachments = attachments;
+		framebufferInfo.width = swapChainExtent.width;
+		framebufferInfo.height = swapChainExtent.height;
+		framebufferInfo.layers = 1;
+		if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &target.framebuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create offscreen framebuffer");
+		}
+		return target;
+	}
+
+	void destroyOffscreenTarget(OffscreenTarget& target) {
+		auto vkDestroyImage = (PFN_vkDestroyImage)vkGetDeviceProcAddr(device, "vkDestroyImage");
+
+		vkDestroyFramebuffer(device, target.framebuffer, nullptr);
+		vkDestroyImageView(device, target.view, nullptr);
+		vkDestroyImage(device, target.image, nullptr);
+		vkFreeMemory(device, target.memory, nullptr);
+		vkDestroyRenderPass(device, target.renderPass, nullptr);
+		target = {};
+	}
+
+	void createGraphicsPipeline() {
+		auto vertShaderCode = readFile(SHADER_ROOT_DIR"/shader.vert.spv");
+		auto fragShaderCode = readFile(SHADER_ROOT_DIR"/shader.frag.spv");
+		// note
+		auto positionShaderCode = readFile(SHADER_ROOT_DIR"/position.vert.spv");
+
+		vertShaderModule = createShaderModule(vertShaderCode);
+		fragShaderModule = createShaderModule(fragShaderCode);
+		positionShaderModule = createShaderModule(positionShaderCode);
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 0;
+		pipelineLayoutInfo.pSetLayouts = nullptr;
+		pipelineLayoutInfo.pushConstantRangeCount = 0;
+		pipelineLayoutInfo.pPushConstantRanges = nullptr;
+
+		auto vkCreatePipelineLayout = (PFN_vkCreatePipelineLayout)vkGetInstanceProcAddr(instance, "vkCreatePipelineLayout");
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create pipeline layout");
+		}
+
+		// note
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = swapChainExtent;
+		graphicsPipeline = createMeshPipeline(VertexLayout::Interleaved, false, scissor);
+		splitStreamPipeline = createMeshPipeline(VertexLayout::SplitStreams, false, scissor);
+
+		vkDestroyPipeline = (PFN_vkDestroyPipeline)vkGetDeviceProcAddr(device, "vkDestroyPipeline");
+
+		vkDestroyPipelineLayout = (PFN_vkDestroyPipelineLayout)vkGetDeviceProcAddr(device, "vkDestroyPipelineLayout");
+		vkDestroyShaderModule = (PFN_vkDestroyShaderModule)vkGetDeviceProcAddr(device, "vkDestroyShaderModule");
+	}
+
+	// The vertex input state follows the layout, positionOnly swaps in position.vert which reads location 0 only.
+	VkPipeline createMeshPipeline(VertexLayout layout, bool positionOnly, VkRect2D scissor) {
+		VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+		vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+		vertShaderStageInfo.module = positionOnly ? positionShaderModule : vertShaderModule;
+		vertShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+		fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fragShaderStageInfo.module = fragShaderModule;
+		fragShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
+
+		// note
+		auto vertexInput = describeVertexInput(layout, positionOnly);
+
+		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexInput.bindings.size());
+		vertexInputInfo.pVertexBindingDescriptions = vertexInput.bindings.data();
+		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInput.attributes.size());
+		vertexInputInfo.pVertexAttributeDescriptions = vertexInput.attributes.data();
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)swapChainExtent.width;
+		viewport.height = (float)swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkPipelineViewportStateCreateInfo viewportState{};
+		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewportState.viewportCount = 1;
+		viewportState.pViewports = &viewport;
+		viewportState.scissorCount = 1;
+		viewportState.pScissors = &scissor;
+
+		VkPipelineRasterizationStateCreateInfo rasterizer{};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.0f;
+		rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+		rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+		rasterizer.depthBiasEnable = VK_FALSE;
+
+		VkPipelineMultisampleStateCreateInfo multisampling{};
+		multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisampling.sampleShadingEnable = VK_FALSE;
+		multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.blendEnable = VK_FALSE;
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD; // Optional
+		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD; // Optional
+
+		VkPipelineColorBlendStateCreateInfo colorBlending{};
+		colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlending.logicOpEnable = VK_FALSE;
+		colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
+		colorBlending.attachmentCount = 1;
+		colorBlending.pAttachments = &colorBlendAttachment;
+		colorBlending.blendConstants[0] = 0.0f; // Optional
+		colorBlending.blendConstants[1] = 0.0f; // Optional
+		colorBlending.blendConstants[2] = 0.0f; // Optional
+		colorBlending.blendConstants[3] = 0.0f; // Optional
+
+		VkGraphicsPipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipelineInfo.stageCount = 2;
+		pipelineInfo.pStages = shaderStages;
+		pipelineInfo.pVertexInputState = &vertexInputInfo;
+		pipelineInfo.pInputAssemblyState = &inputAssembly;
+		pipelineInfo.pViewportState = &viewportState;
+		pipelineInfo.pRasterizationState = &rasterizer;
+		pipelineInfo.pMultisampleState = &multisampling;
+		pipelineInfo.pDepthStencilState = nullptr;
+		pipelineInfo.pColorBlendState = &colorBlending;
+		pipelineInfo.pDynamicState = nullptr;
+		pipelineInfo.layout = pipelineLayout;
+		pipelineInfo.renderPass = renderPass;
+		pipelineInfo.subpass = 0;
+
+		auto vkCreateGraphicsPipelines = (PFN_vkCreateGraphicsPipelines)vkGetInstanceProcAddr(instance, "vkCreateGraphicsPipelines");
+		VkPipeline pipeline = nullptr;
+		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create graphics pipeline");
+		}
+		return pipeline;
+	}
+
+	VkPipeline pipelineFor(VertexLayout layout) const {
+		return layout == VertexLayout::Interleaved ? graphicsPipeline : splitStreamPipeline;
+	}
+
+	// note
+	void createFramebuffers() {
+		auto vkCreateFramebuffer = (PFN_vkCreateFramebuffer)vkGetDeviceProcAddr(device, "vkCreateFramebuffer");
+
+		swapChainFramebuffers.resize(swapChainImageViews.size());
+		for (size_t i = 0; i < swapChainImageViews.size(); i++) {
+			VkImageView attachments[] = { swapChainImageViews[i] };
+
+			VkFramebufferCreateInfo framebufferInfo{};
+			framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			framebufferInfo.renderPass = renderPass;
+			framebufferInfo.attachmentCount = 1;
+			framebufferInfo.pAttachments = attachments;
+			framebufferInfo.width = swapChainExtent.width;
+			framebufferInfo.height = swapChainExtent.height;
+			framebufferInfo.layers = 1;
+
+			if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &swapChainFramebuffers[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create framebuffer");
+			}
+		}
+
+		vkDestroyFramebuffer = (PFN_vkDestroyFramebuffer)vkGetDeviceProcAddr(device, "vkDestroyFramebuffer");
+	}
+
+	void createCommandPool() {
+		auto vkCreateCommandPool = (PFN_vkCreateCommandPool)vkGetDeviceProcAddr(device, "vkCreateCommandPool");
+
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create command pool");
+		}
+
+		vkDestroyCommandPool = (PFN_vkDestroyCommandPool)vkGetDeviceProcAddr(device, "vkDestroyCommandPool");
+	}
+
+	void createCommandBuffers() {
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+
+		commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+		if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate command buffers");
+		}
+
+		vkBeginCommandBuffer = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(device, "vkBeginCommandBuffer");
+		vkEndCommandBuffer = (PFN_vkEndCommandBuffer)vkGetDeviceProcAddr(device, "vkEndCommandBuffer");
+		vkResetCommandBuffer = (PFN_vkResetCommandBuffer)vkGetDeviceProcAddr(device, "vkResetCommandBuffer");
+		vkCmdBeginRenderPass = (PFN_vkCmdBeginRenderPass)vkGetDeviceProcAddr(device, "vkCmdBeginRenderPass");
+		vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass)vkGetDeviceProcAddr(device, "vkCmdEndRenderPass");
+		vkCmdBindPipeline = (PFN_vkCmdBindPipeline)vkGetDeviceProcAddr(device, "vkCmdBindPipeline");
+		vkCmdBindVertexBuffers = (PFN_vkCmdBindVertexBuffers)vkGetDeviceProcAddr(device, "vkCmdBindVertexBuffers");
+		vkCmdBindIndexBuffer = (PFN_vkCmdBindIndexBuffer)vkGetDeviceProcAddr(device, "vkCmdBindIndexBuffer");
+		vkCmdDrawIndexed = (PFN_vkCmdDrawIndexed)vkGetDeviceProcAddr(device, "vkCmdDrawIndexed");
+		vkCmdCopyBuffer = (PFN_vkCmdCopyBuffer)vkGetDeviceProcAddr(device, "vkCmdCopyBuffer");
+	}
+
+	void createSyncObjects() {
+		auto vkCreateSemaphore = (PFN_vkCreateSemaphore)vkGetDeviceProcAddr(device, "vkCreateSemaphore");
+		auto vkCreateFence = (PFN_vkCreateFence)vkGetDeviceProcAddr(device, "vkCreateFence");
+
+		imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+		inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+		// presentation may hold on to the semaphore until the image is reacquired, so one per image
+		renderFinishedSemaphores.resize(swapChainImages.size());
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
+				vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a frame");
+			}
+		}
+		for (size_t i = 0; i < renderFinishedSemaphores.size(); i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a swap chain image");
+			}
+		}
+
+		vkDestroySemaphore = (PFN_vkDestroySemaphore)vkGetDeviceProcAddr(device, "vkDestroySemaphore");
+		vkDestroyFence = (PFN_vkDestroyFence)vkGetDeviceProcAddr(device, "vkDestroyFence");
+		vkWaitForFences = (PFN_vkWaitForFences)vkGetDeviceProcAddr(device, "vkWaitForFences");
+		vkResetFences = (PFN_vkResetFences)vkGetDeviceProcAddr(device, "vkResetFences");
+		vkAcquireNextImageKHR = (PFN_vkAcquireNextImageKHR)vkGetDeviceProcAddr(device, "vkAcquireNextImageKHR");
+		vkQueueSubmit = (PFN_vkQueueSubmit)vkGetDeviceProcAddr(device, "vkQueueSubmit");
+		vkQueuePresentKHR = (PFN_vkQueuePresentKHR)vkGetDeviceProcAddr(device, "vkQueuePresentKHR");
+		vkDeviceWaitIdle = (PFN_vkDeviceWaitIdle)vkGetDeviceProcAddr(device, "vkDeviceWaitIdle");
+	}
+
+	uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+		auto vkGetPhysicalDeviceMemoryProperties = (PFN_vkGetPhysicalDeviceMemoryProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties");
+
+		VkPhysicalDeviceMemoryProperties memProperties;
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+			if ((typeFilter & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+
+		throw std::runtime_error("failed to find suitable memory type");
+	}
+
+	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+		auto vkCreateBuffer = (PFN_vkCreateBuffer)vkGetDeviceProcAddr(device, "vkCreateBuffer");
+		auto vkGetBufferMemoryRequirements = (PFN_vkGetBufferMemoryRequirements)vkGetDeviceProcAddr(device, "vkGetBufferMemoryRequirements");
+		auto vkAllocateMemory = (PFN_vkAllocateMemory)vkGetDeviceProcAddr(device, "vkAllocateMemory");
+		auto vkBindBufferMemory = (PFN_vkBindBufferMemory)vkGetDeviceProcAddr(device, "vkBindBufferMemory");
+
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create buffer");
+		}
+
+		VkMemoryRequirements memRequirements;
+		vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize = memRequirements.size;
+		allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+		if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate buffer memory");
+		}
+
+		vkBindBufferMemory(device, buffer, bufferMemory, 0);
+
+		vkDestroyBuffer = (PFN_vkDestroyBuffer)vkGetDeviceProcAddr(device, "vkDestroyBuffer");
+		vkFreeMemory = (PFN_vkFreeMemory)vkGetDeviceProcAddr(device, "vkFreeMemory");
+	}
+
+	// note
+	// One-off upload: fill writes straight into the mapped staging buffer, the copy into device local memory
+	// runs on the graphics queue and is waited for before returning.
+	void createDeviceLocalBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const std::function<void(char*)>& fill, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+		auto vkUnmapMemory = (PFN_vkUnmapMemory)vkGetDeviceProcAddr(device, "vkUnmapMemory");
+
+		VkBuffer stagingBuffer = nullptr;
+		VkDeviceMemory stagingMemory = nullptr;
+		createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+		void* mapped = nullptr;
+		vkMapMemory(device, stagingMemory, 0, size, 0, &mapped);
+		fill(static_cast<char*>(mapped));
+		vkUnmapMemory(device, stagingMemory);
+
+		createBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, bufferMemory);
+		copyBuffer(stagingBuffer, buffer, size);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingMemory, nullptr);
+	}
+
+	void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0) {
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+		auto vkFreeCommandBuffers = (PFN_vkFreeCommandBuffers)vkGetDeviceProcAddr(device, "vkFreeCommandBuffers");
+		auto vkQueueWaitIdle = (PFN_vkQueueWaitIdle)vkGetDeviceProcAddr(device, "vkQueueWaitIdle");
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = commandPool;
+		allocInfo.commandBufferCount = 1;
+		VkCommandBuffer commandBuffer = nullptr;
+		if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate copy command buffer");
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+		VkBufferCopy copyRegion{};
+		copyRegion.srcOffset = srcOffset;
+		copyRegion.size = size;
+		vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit copy command buffer");
+		}
+		vkQueueWaitIdle(graphicsQueue);
+
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	}
+
+	// note
+	// Indices shrink to 16 bits whenever the mesh allows it, half the index fetch bandwidth for free.
+	GpuMesh uploadMesh(const MeshData& data, VertexLayout layout) {
+		GpuMesh mesh;
+		mesh.layout = layout;
+		mesh.vertexCount = static_cast<uint32_t>(data.positions.size());
+		mesh.indexCount = static_cast<uint32_t>(data.indices.size());
+
+		VkDeviceSize vertexBytes = 0;
+		if (layout == VertexLayout::Interleaved) {
+			vertexBytes = sizeof(MeshVertex) * mesh.vertexCount;
+			createDeviceLocalBuffer(vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, [&](char* dst) {
+				auto vertices = reinterpret_cast<MeshVertex*>(dst);
+				for (uint32_t i = 0; i < mesh.vertexCount; i++) {
+					vertices[i] = { data.positions[i], data.normals[i], data.texCoords[i] };
+				}
+			}, mesh.vertexBuffer, mesh.vertexMemory);
+		}
+		else {
+			std::array<VkDeviceSize, 3> streamSizes = { sizeof(glm::vec3) * mesh.vertexCount, sizeof(glm::vec3) * mesh.vertexCount, sizeof(glm::vec2) * mesh.vertexCount };
+			for (size_t stream = 0; stream < streamSizes.size(); stream++) {
+				// keep every stream start 16 byte aligned
+				vertexBytes = (vertexBytes + 15) & ~VkDeviceSize(15);
+				mesh.streamOffsets[stream] = vertexBytes;
+				vertexBytes += streamSizes[stream];
+			}
+			createDeviceLocalBuffer(vertexBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, [&](char* dst) {
+				memcpy(dst + mesh.streamOffsets[0], data.positions.data(), streamSizes[0]);
+				memcpy(dst + mesh.streamOffsets[1], data.normals.data(), streamSizes[1]);
+				memcpy(dst + mesh.streamOffsets[2], data.texCoords.data(), streamSizes[2]);
+			}, mesh.vertexBuffer, mesh.vertexMemory);
+		}
+
+		mesh.indexType = mesh.vertexCount <= std::numeric_limits<uint16_t>::max() + 1u ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+		VkDeviceSize indexSize = mesh.indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+		createDeviceLocalBuffer(indexSize * mesh.indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, [&](char* dst) {
+			if (mesh.indexType == VK_INDEX_TYPE_UINT16) {
+				auto indices = reinterpret_cast<uint16_t*>(dst);
+				for (uint32_t i = 0; i < mesh.indexCount; i++) {
+					indices[i] = static_cast<uint16_t>(data.indices[i]);
+				}
+			}
+			else {
+				memcpy(dst, data.indices.data(), indexSize * mesh.indexCount);
+			}
+		}, mesh.indexBuffer, mesh.indexMemory);
+
+		return mesh;
+	}
+
+	// note
+	// The production import path: parse straight into one mapped staging buffer holding vertices then indices,
+	// and copy both ranges into device local buffers.
+	GpuMesh loadMesh(const std::string& path, WorkerPool& pool) {
+		MappedFile file(path);
+		auto plan = planMeshImport(file, meshFileFormatOf(path), pool);
+		if (plan.vertexCount == 0 || plan.indexCount == 0) {
+			throw std::runtime_error("mesh file " + path + " contains no triangles");
+		}
+
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+		auto vkUnmapMemory = (PFN_vkUnmapMemory)vkGetDeviceProcAddr(device, "vkUnmapMemory");
+
+		VkBuffer stagingBuffer = nullptr;
+		VkDeviceMemory stagingMemory = nullptr;
+		createBuffer(plan.vertexBytes() + plan.indexBytes(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+		void* mapped = nullptr;
+		vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, &mapped);
+		auto vertices = static_cast<MeshVertex*>(mapped);
+		importMesh(plan, pool, vertices, reinterpret_cast<uint32_t*>(vertices + plan.vertexCount));
+		vkUnmapMemory(device, stagingMemory);
+
+		GpuMesh mesh;
+		mesh.layout = VertexLayout::Interleaved;
+		mesh.vertexCount = plan.vertexCount;
+		mesh.indexCount = plan.indexCount;
+		mesh.indexType = VK_INDEX_TYPE_UINT32;
+		createBuffer(plan.vertexBytes(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mesh.vertexBuffer, mesh.vertexMemory);
+		createBuffer(plan.indexBytes(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mesh.indexBuffer, mesh.indexMemory);
+		copyBuffer(stagingBuffer, mesh.vertexBuffer, plan.vertexBytes());
+		copyBuffer(stagingBuffer, mesh.indexBuffer, plan.indexBytes(), plan.vertexBytes());
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingMemory, nullptr);
+		return mesh;
+	}
+
+	// Test input for machines without big assets, the same sphere as the vertex benchmark in OBJ form.
+	static std::string writeSyntheticObj() {
+		auto path = (std::filesystem::temp_directory_path() / "vulkan-tutorial-mesh-import.obj").string();
+		auto mesh = generateSphere({ 0.0f, 0.0f }, 0.9f, MESH_IMPORT_SYNTHETIC_RINGS, MESH_IMPORT_SYNTHETIC_SEGMENTS);
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to write " + path);
+		}
+		for (size_t i = 0; i < mesh.positions.size(); i++) {
+			file << "v " << mesh.positions[i].x << ' ' << mesh.positions[i].y << ' ' << mesh.positions[i].z << '\n';
+			file << "vn " << mesh.normals[i].x << ' ' << mesh.normals[i].y << ' ' << mesh.normals[i].z << '\n';
+			file << "vt " << mesh.texCoords[i].x << ' ' << 1.0f - mesh.texCoords[i].y << '\n';
+		}
+		// the sphere is clockwise, OBJ wants counter-clockwise
+		for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+			auto a = mesh.indices[i] + 1, b = mesh.indices[i + 2] + 1, c = mesh.indices[i + 1] + 1;
+			file << "f " << a << '/' << a << '/' << a << ' ' << b << '/' << b << '/' << b << ' ' << c << '/' << c << '/' << c << '\n';
+		}
+		return path;
+	}
+
+	// note
+	// Parse throughput against thread count. Every run plans and fills the same mapped staging buffer, after one
+	// untimed run that pulls the file into the page cache, so the numbers are parsing and not disk speed.
+	void benchmarkMeshImport() {
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+		auto vkUnmapMemory = (PFN_vkUnmapMemory)vkGetDeviceProcAddr(device, "vkUnmapMemory");
+
+		auto paths = meshImportPaths;
+		std::string syntheticPath;
+		if (paths.empty()) {
+			syntheticPath = writeSyntheticObj();
+			paths.push_back(syntheticPath);
+		}
+
+		uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<uint32_t> threadCounts;
+		for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+			threadCounts.push_back(threads);
+		}
+		threadCounts.push_back(maxThreads);
+
+		for (auto& path : paths) {
+			MappedFile file(path);
+			auto format = meshFileFormatOf(path);
+			auto megabytes = double(file.size) / 1e6;
+
+			WorkerPool warmupPool(maxThreads);
+			auto warmupPlan = planMeshImport(file, format, warmupPool);
+			if (warmupPlan.vertexCount == 0 || warmupPlan.indexCount == 0) {
+				std::cout << "Mesh import benchmark skipped " << path << ": no triangles" << std::endl;
+				continue;
+			}
+			VkBuffer stagingBuffer = nullptr;
+			VkDeviceMemory stagingMemory = nullptr;
+			createBuffer(warmupPlan.vertexBytes() + warmupPlan.indexBytes(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+			void* mapped = nullptr;
+			vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, &mapped);
+			auto vertices = static_cast<MeshVertex*>(mapped);
+			auto indices = reinterpret_cast<uint32_t*>(vertices + warmupPlan.vertexCount);
+			importMesh(warmupPlan, warmupPool, vertices, indices);
+
+			std::cout << "Mesh import benchmark " << path << " (" << megabytes << " MB, " << warmupPlan.vertexCount << " vertices, "
+				<< warmupPlan.indexCount / 3 << " triangles):" << std::endl;
+			double singleThreadSeconds = 0.0;
+			for (auto threads : threadCounts) {
+				WorkerPool pool(threads);
+				auto start = std::chrono::steady_clock::now();
+				auto plan = planMeshImport(file, format, pool);
+				importMesh(plan, pool, vertices, indices);
+				auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				if (threads == 1) {
+					singleThreadSeconds = seconds;
+				}
+				std::cout << "  " << threads << " threads: " << seconds * 1e3 << " ms, " << megabytes / seconds << " MB/s, "
+					<< singleThreadSeconds / seconds << "x" << std::endl;
+			}
+			vkUnmapMemory(device, stagingMemory);
+			vkDestroyBuffer(device, stagingBuffer, nullptr);
+			vkFreeMemory(device, stagingMemory, nullptr);
+
+			// end to end through loadMesh, mapping and upload included
+			auto start = std::chrono::steady_clock::now();
+			auto mesh = loadMesh(path, warmupPool);
+			auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::cout << "  loadMesh with " << maxThreads << " threads: " << seconds * 1e3 << " ms including upload" << std::endl;
+			destroyMesh(mesh);
+		}
+
+		// nothing maps the file any more, a leftover one would only fill up the temp directory
+		if (!syntheticPath.empty()) {
+			std::error_code error;
+			std::filesystem::remove(syntheticPath, error);
+		}
+	}
+
+	void destroyMesh(GpuMesh& mesh) {
+		vkDestroyBuffer(device, mesh.vertexBuffer, nullptr);
+		vkFreeMemory(device, mesh.vertexMemory, nullptr);
+		vkDestroyBuffer(device, mesh.indexBuffer, nullptr);
+		vkFreeMemory(device, mesh.indexMemory, nullptr);
+		mesh = {};
+	}
+
+	// the same sphere twice, left interleaved and right split into streams
+	void createMeshes() {
+		meshes.push_back(uploadMesh(generateSphere({ -0.45f, 0.0f }, 0.4f, SCENE_SPHERE_RINGS, SCENE_SPHERE_SEGMENTS), VertexLayout::Interleaved));
+		meshes.push_back(uploadMesh(generateSphere({ 0.45f, 0.0f }, 0.4f, SCENE_SPHERE_RINGS, SCENE_SPHERE_SEGMENTS), VertexLayout::SplitStreams));
+	}
+
+	// Binds the vertex buffer once per stream, all at their own offset into the mesh buffer.
+	void bindMesh(VkCommandBuffer commandBuffer, const GpuMesh& mesh, bool positionOnly) {
+		if (mesh.layout == VertexLayout::Interleaved) {
+			VkDeviceSize offset = 0;
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mesh.vertexBuffer, &offset);
+		}
+		else {
+			std::array<VkBuffer, 3> buffers = { mesh.vertexBuffer, mesh.vertexBuffer, mesh.vertexBuffer };
+			uint32_t bindingCount = positionOnly ? 1 : 3;
+			vkCmdBindVertexBuffers(commandBuffer, 0, bindingCount, buffers.data(), mesh.streamOffsets.data());
+		}
+		vkCmdBindIndexBuffer(commandBuffer, mesh.indexBuffer, 0, mesh.indexType);
+	}
+
+	// note
+	// GPU time of indexed draws of a large mesh with a 1x1 scissor, so almost no fragment work is left and the
+	// difference between the layouts is vertex fetch. The position-only variants model depth and shadow passes.
+	void benchmarkVertexFetch() {
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+		auto vkCreateQueryPool = (PFN_vkCreateQueryPool)vkGetDeviceProcAddr(device, "vkCreateQueryPool");
+		auto vkDestroyQueryPool = (PFN_vkDestroyQueryPool)vkGetDeviceProcAddr(device, "vkDestroyQueryPool");
+		auto vkGetQueryPoolResults = (PFN_vkGetQueryPoolResults)vkGetDeviceProcAddr(device, "vkGetQueryPoolResults");
+		auto vkCmdResetQueryPool = (PFN_vkCmdResetQueryPool)vkGetDeviceProcAddr(device, "vkCmdResetQueryPool");
+		auto vkCmdWriteTimestamp = (PFN_vkCmdWriteTimestamp)vkGetDeviceProcAddr(device, "vkCmdWriteTimestamp");
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+		auto vkFreeCommandBuffers = (PFN_vkFreeCommandBuffers)vkGetDeviceProcAddr(device, "vkFreeCommandBuffers");
+		auto vkCreateFence = (PFN_vkCreateFence)vkGetDeviceProcAddr(device, "vkCreateFence");
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProps.data());
+		if (queueFamilyProps[queueFamilyIndices.graphicsFamily.value()].timestampValidBits == 0) {
+			std::cout << "Vertex fetch benchmark skipped: graphics queue has no timestamps" << std::endl;
+			return;
+		}
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+
+		auto benchmarkMesh = generateSphere({ 0.0f, 0.0f }, 0.9f, VERTEX_BENCHMARK_RINGS, VERTEX_BENCHMARK_SEGMENTS);
+		std::array<GpuMesh, 2> benchmarkMeshes = {
+			uploadMesh(benchmarkMesh, VertexLayout::Interleaved),
+			uploadMesh(benchmarkMesh, VertexLayout::SplitStreams),
+		};
+
+		struct FetchVariant {
+			const char*               name;
+			VertexLayout            layout;
+			bool              positionOnly;
+			// what the layout pulls through memory per vertex, whole strides for interleaved data
+			uint32_t        bytesPerVertex;
+			VkPipeline            pipeline = nullptr;
+		};
+		std::vector<FetchVariant> variants = {
+			{ "interleaved, all attributes", VertexLayout::Interleaved, false, sizeof(MeshVertex) },
+			{ "split streams, all attributes", VertexLayout::SplitStreams, false, sizeof(MeshVertex) },
+			{ "interleaved, position only", VertexLayout::Interleaved, true, sizeof(MeshVertex) },
+			{ "split streams, position only", VertexLayout::SplitStreams, true, sizeof(glm::vec3) },
+		};
+		VkRect2D pixelScissor = { { 0, 0 }, { 1, 1 } };
+		for (auto& variant : variants) {
+			variant.pipeline = createMeshPipeline(variant.layout, variant.positionOnly, pixelScissor);
+		}
+
+		VkQueryPoolCreateInfo queryPoolInfo{};
+		queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolInfo.queryCount = static_cast<uint32_t>(variants.size() * 2);
+		VkQueryPool queryPool = nullptr;
+		if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create vertex fetch benchmark query pool");
+		}
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+		VkCommandBuffer commandBuffer = nullptr;
+		if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate benchmark command buffer");
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording benchmark command buffer");
+		}
+		vkCmdResetQueryPool(commandBuffer, queryPool, 0, queryPoolInfo.queryCount);
+
+		auto target = createOffscreenTarget();
+		VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = target.renderPass;
+		renderPassInfo.framebuffer = target.framebuffer;
+		renderPassInfo.renderArea.offset = { 0, 0 };
+		renderPassInfo.renderArea.extent = swapChainExtent;
+		renderPassInfo.clearValueCount = 1;
+		renderPassInfo.pClearValues = &clearColor;
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		for (uint32_t variantIndex = 0; variantIndex < variants.size(); variantIndex++) {
+			auto& variant = variants[variantIndex];
+			auto& mesh = benchmarkMeshes[variant.layout == VertexLayout::Interleaved ? 0 : 1];
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, variant.pipeline);
+			bindMesh(commandBuffer, mesh, variant.positionOnly);
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, variantIndex * 2);
+			for (uint32_t draw = 0; draw < VERTEX_BENCHMARK_DRAWS; draw++) {
+				vkCmdDrawIndexed(commandBuffer, mesh.indexCount, 1, 0, 0, 0);
+			}
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, variantIndex * 2 + 1);
+		}
+		vkCmdEndRenderPass(commandBuffer);
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record benchmark command buffer");
+		}
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		VkFence fence = nullptr;
+		if (vkCreateFence(device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create benchmark fence");
+		}
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, fence) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit benchmark command buffer");
+		}
+		vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+
+		std::vector<uint64_t> timestamps(queryPoolInfo.queryCount);
+		vkGetQueryPoolResults(device, queryPool, 0, queryPoolInfo.queryCount, timestamps.size() * sizeof(uint64_t), timestamps.data(),
+			sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+		auto vertexCount = benchmarkMeshes[0].vertexCount;
+		std::cout << "Vertex fetch benchmark (" << vertexCount << " vertices, " << benchmarkMeshes[0].indexCount / 3 << " triangles, "
+			<< VERTEX_BENCHMARK_DRAWS << " draws each):" << std::endl;
+		for (uint32_t variantIndex = 0; variantIndex < variants.size(); variantIndex++) {
+			auto& variant = variants[variantIndex];
+			auto ticks = timestamps[variantIndex * 2 + 1] - timestamps[variantIndex * 2];
+			auto seconds = double(ticks) * physicalDeviceProperties.limits.timestampPeriod / 1e9 / VERTEX_BENCHMARK_DRAWS;
+			auto verticesPerSecond = vertexCount / seconds;
+			std::cout << "  " << variant.name << ": " << seconds * 1e3 << " ms/draw, " << verticesPerSecond / 1e6 << " Mvertices/s, "
+				<< verticesPerSecond * variant.bytesPerVertex / 1e9 << " GB/s vertex data (" << variant.bytesPerVertex << " bytes/vertex)" << std::endl;
+		}
+
+		vkDestroyFence(device, fence, nullptr);
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+		destroyOffscreenTarget(target);
+		vkDestroyQueryPool(device, queryPool, nullptr);
+		for (auto& variant : variants) {
+			vkDestroyPipeline(device, variant.pipeline, nullptr);
+		}
+		for (auto& mesh : benchmarkMeshes) {
+			destroyMesh(mesh);
+		}
+	}
+
+	void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording command buffer");
+		}
+
+		VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = renderPass;
+		renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+		renderPassInfo.renderArea.offset = { 0, 0 };
+		renderPassInfo.renderArea.extent = swapChainExtent;
+		renderPassInfo.clearValueCount = 1;
+		renderPassInfo.pClearValues = &clearColor;
+
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		// note
+		for (auto& mesh : meshes) {
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineFor(mesh.layout));
+			bindMesh(commandBuffer, mesh, false);
+			vkCmdDrawIndexed(commandBuffer, mesh.indexCount, 1, 0, 0, 0);
+		}
+		vkCmdEndRenderPass(commandBuffer);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record command buffer");
+		}
+	}
+
+	void drawFrame() {
+		vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+
+		uint32_t imageIndex = 0;
+		auto result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to acquire swap chain image");
+		}
+		vkResetFences(device, 1, &inFlightFences[currentFrame]);
+
+		vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+		recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &imageAvailableSemaphores[currentFrame];
+		submitInfo.pWaitDstStageMask = &waitStage;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &renderFinishedSemaphores[imageIndex];
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit draw command buffer");
+		}
+
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinishedSemaphores[imageIndex];
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &swapChain;
+		presentInfo.pImageIndices = &imageIndex;
+		result = vkQueuePresentKHR(presentQueue, &presentInfo);
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to present swap chain image");
+		}
+
+		currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	}
+
+
+	VkShaderModule createShaderModule(const std::vector<char>& code) {
+		VkShaderModuleCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = code.size();
+		createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+		auto vkCreateShaderModule = (PFN_vkCreateShaderModule)vkGetInstanceProcAddr(instance, "vkCreateShaderModule");
+		VkShaderModule shaderModule;
+		if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create shader module");
+		}
+
+		return shaderModule;
+	}
+
+
+	static std::vector<char> readFile(const std::string& filename) {
+		std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to open file");
+		}
+
+		size_t fileSize = (size_t)file.tellg();
+		std::vector<char> buffer(fileSize);
+
+		file.seekg(0);
+		file.read(buffer.data(), fileSize);
+
+		file.close();
+		return buffer;
+	}
+
+
+};
+
+int main(int argc, char** argv) {
+	HelloTriangleApplication app;
+	// note
+	app.meshImportPaths.assign(argv + 1, argv + argc);
+
+	try {
+		app.run();
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
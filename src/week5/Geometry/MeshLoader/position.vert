@@ -0,0 +1,12 @@
+#version 450
+
+// note
+// Reads nothing but positions, like a depth prepass or a shadow pass.
+layout(location = 0) in vec3 inPosition;
+
+layout(location = 0) out vec3 fragColor;
+
+void main(){
+	gl_Position = vec4(inPosition, 1.0);
+	fragColor = vec3(1.0);
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 450
+
+// note
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(location = 0) out vec3 fragColor;
+
+void main(){
+	gl_Position = vec4(inPosition, 1.0);
+	fragColor = (inNormal * 0.5 + 0.5) * (0.75 + 0.25 * inTexCoord.x);
+}
\ No newline at end of file
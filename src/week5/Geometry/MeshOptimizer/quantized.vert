@@ -0,0 +1,30 @@
+#version 450
+
+// note
+// Formats do the first half of the decoding: half floats and snorm/unorm attributes arrive as floats.
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec2 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(push_constant) uniform MeshDequantization {
+	vec4 positionOffset;
+	vec4 positionScale;
+	vec4 texCoordTransform;
+} dequantization;
+
+layout(location = 0) out vec3 fragColor;
+
+vec3 decodeOctahedral(vec2 encoded){
+	vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-normal.z, 0.0);
+	normal.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+	return normalize(normal);
+}
+
+void main(){
+	vec3 position = dequantization.positionOffset.xyz + inPosition.xyz * dequantization.positionScale.xyz;
+	vec3 normal = decodeOctahedral(inNormal);
+	vec2 texCoord = dequantization.texCoordTransform.xy + inTexCoord * dequantization.texCoordTransform.zw;
+	gl_Position = vec4(position, 1.0);
+	fragColor = (normal * 0.5 + 0.5) * (0.75 + 0.25 * texCoord.x);
+}
\ No newline at end of file
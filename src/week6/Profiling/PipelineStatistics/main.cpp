@@ -0,0 +1,4293 @@
+#define GLFW_INCLUDE_VULKAN
+#define VK_NO_PROTOTYPES
+#include "config.h"
+#include <GLFW/glfw3.h>
+#include <vulkan/vulkan.h>
+#include <vulkan/vulkan.hpp>
+// note
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <optional>
+#include <set>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+// note
+#include <array>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <string>
+#include <cmath>
+#include <cstring>
+#include <cstddef>
+#include <functional>
+#include <chrono>
+#include <type_traits>
+// note
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <exception>
+#include <iomanip>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback2(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+	void* pUserData) {
+
+	std::cerr << "validation layer2: " << pCallbackData->pMessage << std::endl;
+
+	return VK_FALSE;
+}
+
+inline auto findExtensionProperties(const std::vector<VkExtensionProperties>& extensionProps, const char* name) {
+	for (auto& extensionProp : extensionProps) {
+		if (strcmp(extensionProp.extensionName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findLayerProperties(const std::vector<VkLayerProperties>& layerProps, const char* name) {
+	for (auto& layerProp : layerProps) {
+		if (strcmp(layerProp.layerName, name) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+inline auto findQueueFamilyIndices(const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			indices.push_back(i);
+		}
+	}
+	return indices;
+}
+inline auto findQueueFamilyIndices(
+	VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR,
+	const std::vector<VkQueueFamilyProperties>& queueFamilyProps, VkQueueFlags requiredFlags, VkQueueFlags disallowedFlags) -> std::vector<uint32_t> {
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < queueFamilyProps.size(); i++) {
+		if ((queueFamilyProps[i].queueFlags & requiredFlags) == requiredFlags &&
+			(queueFamilyProps[i].queueFlags & disallowedFlags) == 0) {
+			if (!surface) {
+				indices.push_back(i);
+			}
+			else {
+				VkBool32 presentSupport = false;
+				vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+				if (presentSupport) {
+					indices.push_back(i);
+				}
+			}
+		}
+	}
+	return indices;
+}
+
+struct SwapChainSupportDetails {
+	VkSurfaceCapabilitiesKHR        capabilities;
+	std::vector<VkSurfaceFormatKHR> formats;
+	std::vector<VkPresentModeKHR>   presentModes;
+};
+
+struct QueueFamilyIndices {
+	std::optional<uint32_t> graphicsFamily;
+	std::optional<uint32_t> presentFamily;
+
+	bool isComplete()
+	{
+		return graphicsFamily.has_value() && presentFamily.has_value();
+	}
+};
+
+// note
+struct MeshVertex {
+	glm::vec3 position;
+	glm::vec3   normal;
+	glm::vec2 texCoord;
+};
+
+// Source geometry, one array per attribute. Uploading interleaves it into MeshVertex.
+struct MeshData {
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3>   normals;
+	std::vector<glm::vec2> texCoords;
+	std::vector<uint32_t>    indices;
+};
+
+struct VertexInputDescription {
+	std::vector<VkVertexInputBindingDescription>     bindings;
+	std::vector<VkVertexInputAttributeDescription> attributes;
+};
+
+// Locations match shader.vert: 0 position, 1 normal, 2 texCoord.
+inline VertexInputDescription describeVertexInput() {
+	VertexInputDescription description;
+	description.bindings.push_back({ 0, sizeof(MeshVertex), VK_VERTEX_INPUT_RATE_VERTEX });
+	description.attributes.push_back({ 0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(MeshVertex, position) });
+	description.attributes.push_back({ 1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(MeshVertex, normal) });
+	description.attributes.push_back({ 2, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(MeshVertex, texCoord) });
+	return description;
+}
+
+// note
+// Per-instance data, read by shader.vert from the frame's instance buffer at the pushed transform index. std430 layout.
+struct InstanceData {
+	// xy offset in clip space, z uniform scale
+	glm::vec4 offsetScale;
+	glm::vec4       color;
+};
+
+// Where a mesh lives inside the shared vertex and index buffers.
+struct MeshRange {
+	uint32_t   firstIndex = 0;
+	uint32_t   indexCount = 0;
+	int32_t  vertexOffset = 0;
+};
+
+// note
+// Every device offers at least this much push constant space, the minimum of maxPushConstantsSize.
+const uint32_t GUARANTEED_PUSH_CONSTANTS_SIZE = 128;
+
+// A block of push constants of type T at a fixed offset, visible to the given stages. Its size and placement are
+// checked at compile time against the guaranteed limit, so it fits on any device without a runtime fallback.
+template <typename T, uint32_t Offset, VkShaderStageFlags Stages>
+struct PushConstantBlock {
+	static_assert(std::is_trivially_copyable_v<T>, "push constants are copied as raw bytes");
+	static_assert(Offset % 4 == 0 && sizeof(T) % 4 == 0, "push constant offsets and sizes are multiples of 4");
+	static_assert(Offset + sizeof(T) <= GUARANTEED_PUSH_CONSTANTS_SIZE, "push constant block exceeds the guaranteed maxPushConstantsSize");
+
+	static constexpr uint32_t end = Offset + static_cast<uint32_t>(sizeof(T));
+
+	static constexpr VkPushConstantRange range() {
+		return { Stages, Offset, static_cast<uint32_t>(sizeof(T)) };
+	}
+
+	static void push(PFN_vkCmdPushConstants vkCmdPushConstants, VkCommandBuffer commandBuffer, VkPipelineLayout layout, const T& value) {
+		vkCmdPushConstants(commandBuffer, layout, Stages, Offset, sizeof(T), &value);
+	}
+};
+
+// note
+// Bits of DrawConstants::flags, the same values are defined in the shaders.
+enum class DrawFlag : uint32_t {
+	Untextured = 1 << 0,
+	Unlit = 1 << 1
+};
+
+// Everything that changes from one draw to the next. Matches the DrawConstants push constant block in the shaders.
+struct DrawConstants {
+	uint32_t transformIndex;
+	uint32_t  materialIndex;
+	uint32_t          flags;
+};
+
+using DrawPushConstants = PushConstantBlock<DrawConstants, 0, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT>;
+
+// One object the application wants drawn this frame.
+struct DrawItem {
+	uint32_t         mesh = 0;
+	uint32_t     material = 0;
+	uint32_t        flags = 0;
+	InstanceData instance = {};
+};
+
+// alignment has to be a power of two, as every Vulkan offset alignment is
+inline VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// note
+// A size x size RGBA8 checkerboard, cells of the given color alternating with a darker copy of it.
+inline std::vector<uint32_t> generateCheckerTexture(uint32_t size, uint32_t cells, glm::vec3 color) {
+	auto pack = [](glm::vec3 c) {
+		auto r = static_cast<uint32_t>(std::clamp(c.r, 0.0f, 1.0f) * 255.0f + 0.5f);
+		auto g = static_cast<uint32_t>(std::clamp(c.g, 0.0f, 1.0f) * 255.0f + 0.5f);
+		auto b = static_cast<uint32_t>(std::clamp(c.b, 0.0f, 1.0f) * 255.0f + 0.5f);
+		return r | g << 8 | b << 16 | 0xff000000u;
+	};
+	auto light = pack(color);
+	auto dark = pack(color * 0.35f);
+	auto cellSize = std::max(size / cells, 1u);
+	std::vector<uint32_t> texels(size_t(size) * size);
+	for (uint32_t y = 0; y < size; y++) {
+		for (uint32_t x = 0; x < size; x++) {
+			texels[size_t(y) * size + x] = (x / cellSize + y / cellSize) % 2 == 0 ? light : dark;
+		}
+	}
+	return texels;
+}
+
+// note
+// A UV sphere squeezed into clip space: xy around center, z inside [0.1, 0.9] so nothing is clipped.
+// Triangles are wound clockwise on screen for the front half, matching the rasterizer state.
+inline MeshData generateSphere(glm::vec2 center, float radius, uint32_t rings, uint32_t segments) {
+	MeshData mesh;
+	auto vertexCount = size_t(rings + 1) * (segments + 1);
+	mesh.positions.reserve(vertexCount);
+	mesh.normals.reserve(vertexCount);
+	mesh.texCoords.reserve(vertexCount);
+	for (uint32_t ring = 0; ring <= rings; ring++) {
+		float theta = glm::pi<float>() * ring / rings;
+		for (uint32_t segment = 0; segment <= segments; segment++) {
+			float phi = glm::two_pi<float>() * segment / segments;
+			glm::vec3 normal = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+			mesh.positions.push_back({ center.x + radius * normal.x, center.y + radius * normal.y, 0.5f + 0.4f * normal.z });
+			mesh.normals.push_back(normal);
+			mesh.texCoords.push_back({ float(segment) / segments, float(ring) / rings });
+		}
+	}
+	mesh.indices.reserve(size_t(rings) * segments * 6);
+	for (uint32_t ring = 0; ring < rings; ring++) {
+		for (uint32_t segment = 0; segment < segments; segment++) {
+			uint32_t a = ring * (segments + 1) + segment;
+			uint32_t b = a + segments + 1;
+			uint32_t c = a + 1;
+			uint32_t d = b + 1;
+			mesh.indices.insert(mesh.indices.end(), { a, b, c, b, d, c });
+		}
+	}
+	return mesh;
+}
+
+// note
+// Read-only view of a whole file through the page cache, no copy into process memory.
+struct MappedFile {
+	const char* data = nullptr;
+	size_t      size = 0;
+#ifdef _WIN32
+	HANDLE      file = INVALID_HANDLE_VALUE;
+	HANDLE   mapping = nullptr;
+#else
+	int           fd = -1;
+#endif
+
+	explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER fileSize{};
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+			throw std::runtime_error("failed to open " + path);
+		}
+		size = static_cast<size_t>(fileSize.QuadPart);
+		if (size > 0) {
+			mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			data = mapping ? static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+			if (!data) {
+				unmap();
+				throw std::runtime_error("failed to map " + path);
+			}
+		}
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		struct stat fileStat{};
+		if (fd < 0 || fstat(fd, &fileStat) != 0) {
+			unmap();
+			throw std::runtime_error("failed to open " + path);
+		}
+		size = static_cast<size_t>(fileStat.st_size);
+		if (size > 0) {
+			void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (view == MAP_FAILED) {
+				unmap();
+				throw std::runtime_error("failed to map " + path);
+			}
+			data = static_cast<const char*>(view);
+		}
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile() {
+		unmap();
+	}
+
+	void unmap() {
+#ifdef _WIN32
+		if (data) {
+			UnmapViewOfFile(data);
+		}
+		if (mapping) {
+			CloseHandle(mapping);
+		}
+		if (file != INVALID_HANDLE_VALUE) {
+			CloseHandle(file);
+		}
+		file = INVALID_HANDLE_VALUE;
+		mapping = nullptr;
+#else
+		if (data) {
+			munmap(const_cast<char*>(data), size);
+		}
+		if (fd >= 0) {
+			close(fd);
+		}
+		fd = -1;
+#endif
+		data = nullptr;
+	}
+};
+
+// note
+// Profiling macros. Built with ENABLE_PROFILING set to 0 they all expand to nothing and their arguments are never
+// evaluated, so the instrumentation costs nothing in that build. Names are kept as pointers, pass string literals.
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING 1
+#endif
+
+#if ENABLE_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_COUNTER(name, value) profileCounter(name, static_cast<int64_t>(value))
+#define PROFILE_THREAD_NAME(name) profileThreadName(name)
+#define PROFILE_FLOW_START(name, id) profileFlowStart(name, id)
+#define PROFILE_WRITE_TRACE(path) writeProfileTrace(path)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#define PROFILE_FLOW_START(name, id) ((void)0)
+#define PROFILE_WRITE_TRACE(path) ((void)0)
+#endif
+
+const char* PROFILE_TRACE_PATH = "profile-trace.json";
+
+// note
+// events a thread records before it has to hand them to the profiler under its lock, a power of two
+const uint64_t PROFILE_RING_CAPACITY = 1 << 12;
+// note
+// events the profiler keeps for the trace, about 40 MB. Past that the earliest collected ones are dropped, so a
+// long session keeps its most recent events instead of growing without bound.
+const size_t PROFILE_MAX_EVENTS = 1 << 20;
+
+enum class ProfileEventType : uint32_t {
+	Scope,
+	Counter,
+	FlowStart,
+	FlowEnd,
+};
+
+// note
+// Times are nanoseconds since the profiler started. A scope has a duration, a counter a value, and the two ends
+// of a flow share their value as id.
+struct ProfileEvent {
+	const char*             name = nullptr;
+	uint64_t               start = 0;
+	uint64_t            duration = 0;
+	int64_t                value = 0;
+	uint32_t            threadId = 0;
+	ProfileEventType        type = ProfileEventType::Scope;
+};
+
+// note
+// The events one thread recorded that nobody has collected yet. Only the owning thread pushes, and head and tail
+// only ever grow, so recording is a store and a release without a lock. Draining happens under the profiler's
+// mutex, by the collector or by the owner itself when its ring is full.
+struct ProfileRing {
+	std::array<ProfileEvent, PROFILE_RING_CAPACITY> events;
+	std::atomic<uint64_t>                             head = 0;
+	std::atomic<uint64_t>                             tail = 0;
+
+	bool push(const ProfileEvent& event) {
+		auto write = head.load(std::memory_order_relaxed);
+		if (write - tail.load(std::memory_order_acquire) == PROFILE_RING_CAPACITY) {
+			return false;
+		}
+		events[write % PROFILE_RING_CAPACITY] = event;
+		head.store(write + 1, std::memory_order_release);
+		return true;
+	}
+
+	void drain(std::deque<ProfileEvent>& collected) {
+		auto read = tail.load(std::memory_order_relaxed);
+		auto end = head.load(std::memory_order_acquire);
+		for (; read < end; read++) {
+			collected.push_back(events[read % PROFILE_RING_CAPACITY]);
+		}
+		tail.store(end, std::memory_order_release);
+	}
+};
+
+// note
+// Owns the rings of all threads that recorded something. A thread takes a ring on its first event and gives it
+// back drained when it exits, so pools that come and go reuse rings and their events stay in the trace.
+struct Profiler {
+	std::chrono::steady_clock::time_point          epoch = std::chrono::steady_clock::now();
+	std::mutex                                     mutex;
+	std::vector<std::unique_ptr<ProfileRing>>      rings;
+	std::vector<std::unique_ptr<ProfileRing>>  freeRings;
+	std::deque<ProfileEvent>                   collected;
+	uint64_t                                     dropped = 0;
+	std::unordered_map<uint32_t, std::string> threadNames;
+	uint32_t                                nextThreadId = 1;
+
+	uint64_t now() const {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	ProfileRing* acquireRing(uint32_t& threadId) {
+		std::lock_guard<std::mutex> lock(mutex);
+		threadId = nextThreadId++;
+		if (freeRings.empty()) {
+			rings.push_back(std::make_unique<ProfileRing>());
+		}
+		else {
+			rings.push_back(std::move(freeRings.back()));
+			freeRings.pop_back();
+		}
+		return rings.back().get();
+	}
+
+	void releaseRing(ProfileRing* ring) {
+		std::lock_guard<std::mutex> lock(mutex);
+		ring->drain(collected);
+		trim();
+		auto it = std::find_if(rings.begin(), rings.end(), [ring](const auto& owned) { return owned.get() == ring; });
+		freeRings.push_back(std::move(*it));
+		rings.erase(it);
+	}
+
+	void flush(ProfileRing& ring) {
+		std::lock_guard<std::mutex> lock(mutex);
+		ring.drain(collected);
+		trim();
+	}
+
+	// called with the lock held
+	void trim() {
+		if (collected.size() > PROFILE_MAX_EVENTS) {
+			auto excess = collected.size() - PROFILE_MAX_EVENTS;
+			collected.erase(collected.begin(), collected.begin() + excess);
+			dropped += excess;
+		}
+	}
+
+	uint64_t droppedEvents() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return dropped;
+	}
+
+	void nameThread(uint32_t threadId, const std::string& name) {
+		std::lock_guard<std::mutex> lock(mutex);
+		threadNames[threadId] = name;
+	}
+
+	// note
+	// A row for events no thread records itself, like GPU work timed after the fact. addEvent takes the lock, it
+	// is meant for a few events a frame.
+	uint32_t addTrack(const std::string& name) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto track = nextThreadId++;
+		threadNames[track] = name;
+		return track;
+	}
+
+	void addEvent(const ProfileEvent& event) {
+		std::lock_guard<std::mutex> lock(mutex);
+		collected.push_back(event);
+		trim();
+	}
+
+	// Collects every ring and writes the events kept so far as Chrome Trace Event JSON, which chrome://tracing and
+	// ui.perfetto.dev open. Returns the number of events written.
+	size_t writeChromeTrace(const std::string& path) {
+		std::lock_guard<std::mutex> lock(mutex);
+		for (auto& ring : rings) {
+			ring->drain(collected);
+		}
+		trim();
+
+		std::ofstream file(path);
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to open trace file");
+		}
+		// the trace counts in microseconds
+		file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		const char* separator = "";
+		for (auto& [threadId, name] : threadNames) {
+			file << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId << ",\"args\":{\"name\":\"" << name << "\"}}";
+			separator = ",\n";
+		}
+		for (auto& event : collected) {
+			file << separator << "{\"name\":\"" << event.name << "\",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":" << event.start / 1e3;
+			if (event.type == ProfileEventType::Scope) {
+				file << ",\"ph\":\"X\",\"dur\":" << event.duration / 1e3 << "}";
+			}
+			else if (event.type == ProfileEventType::Counter) {
+				file << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+			}
+			else {
+				// an arrow from the slice around the start to the slice around the end
+				file << ",\"ph\":\"" << (event.type == ProfileEventType::FlowStart ? "s" : "f") << "\",\"bp\":\"e\",\"cat\":\"flow\",\"id\":" << event.value << "}";
+			}
+			separator = ",\n";
+		}
+		file << "\n]}\n";
+		return collected.size();
+	}
+};
+
+inline Profiler& profiler() {
+	static Profiler instance;
+	return instance;
+}
+
+// note
+// The calling thread's ring and trace row. A full ring is flushed by its owner, which is the only time recording
+// takes a lock.
+struct ProfileThread {
+	ProfileRing*      ring = nullptr;
+	uint32_t      threadId = 0;
+
+	ProfileThread() {
+		ring = profiler().acquireRing(threadId);
+	}
+
+	ProfileThread(const ProfileThread&) = delete;
+	ProfileThread& operator=(const ProfileThread&) = delete;
+
+	~ProfileThread() {
+		profiler().releaseRing(ring);
+	}
+
+	void record(ProfileEvent event) {
+		event.threadId = threadId;
+		if (!ring->push(event)) {
+			profiler().flush(*ring);
+			ring->push(event);
+		}
+	}
+};
+
+inline ProfileThread& profileThread() {
+	thread_local ProfileThread thread;
+	return thread;
+}
+
+// note
+// Times from construction to destruction.
+struct ProfileScope {
+	const char*     name;
+	uint64_t       start;
+
+	explicit ProfileScope(const char* name) : name(name), start(profiler().now()) {}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+	~ProfileScope() {
+		auto end = profiler().now();
+		profileThread().record({ name, start, end - start, 0, 0, ProfileEventType::Scope });
+	}
+};
+
+inline void profileCounter(const char* name, int64_t value) {
+	profileThread().record({ name, profiler().now(), 0, value, 0, ProfileEventType::Counter });
+}
+
+inline void profileFlowStart(const char* name, uint64_t id) {
+	profileThread().record({ name, profiler().now(), 0, static_cast<int64_t>(id), 0, ProfileEventType::FlowStart });
+}
+
+inline void profileThreadName(const std::string& name) {
+	profiler().nameThread(profileThread().threadId, name);
+}
+
+inline void writeProfileTrace(const std::string& path) {
+	auto events = profiler().writeChromeTrace(path);
+	std::cout << "Profile trace: " << events << " events written to " << path;
+	if (auto dropped = profiler().droppedEvents()) {
+		std::cout << ", " << dropped << " earlier ones dropped";
+	}
+	std::cout << std::endl;
+}
+
+// note
+// Fixed set of worker threads. parallelFor hands out task indices from an atomic counter, the calling thread
+// works along, and the first exception thrown by a task is rethrown to the caller once every task has finished.
+struct WorkerPool {
+	std::vector<std::thread>                 workers;
+	std::mutex                                 mutex;
+	std::condition_variable                     wake;
+	std::condition_variable                     idle;
+	const std::function<void(uint32_t)>*         job = nullptr;
+	uint32_t                               taskCount = 0;
+	std::atomic<uint32_t>                   nextTask = 0;
+	uint32_t                           activeWorkers = 0;
+	uint64_t                              generation = 0;
+	bool                                    stopping = false;
+	std::exception_ptr                  firstFailure;
+
+	// threadCount includes the thread calling parallelFor
+	explicit WorkerPool(uint32_t threadCount) {
+		for (uint32_t i = 1; i < threadCount; i++) {
+			workers.emplace_back([this]([[maybe_unused]] uint32_t index) {
+				PROFILE_THREAD_NAME("worker " + std::to_string(index));
+				workerLoop();
+			}, i);
+		}
+	}
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	~WorkerPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+
+	uint32_t threadCount() const {
+		return static_cast<uint32_t>(workers.size()) + 1;
+	}
+
+	void parallelFor(uint32_t count, const std::function<void(uint32_t)>& task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &task;
+			taskCount = count;
+			nextTask = 0;
+			activeWorkers = static_cast<uint32_t>(workers.size());
+			firstFailure = nullptr;
+			generation++;
+		}
+		wake.notify_all();
+		drain();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		idle.wait(lock, [this] { return activeWorkers == 0; });
+		job = nullptr;
+		if (firstFailure) {
+			std::rethrow_exception(firstFailure);
+		}
+	}
+
+	void drain() {
+		for (uint32_t task = nextTask++; task < taskCount; task = nextTask++) {
+			try {
+				(*job)(task);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!firstFailure) {
+					firstFailure = std::current_exception();
+				}
+			}
+		}
+	}
+
+	void workerLoop() {
+		uint64_t seenGeneration = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+				if (stopping) {
+					return;
+				}
+				seenGeneration = generation;
+			}
+			drain();
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				activeWorkers--;
+			}
+			idle.notify_one();
+		}
+	}
+};
+
+// note
+// KTX2 container, only what a 2D texture with a mip chain needs: the format, the extent and where each level is.
+// Key/value data and the data format descriptor are skipped, the format comes from vkFormat alone.
+const std::array<uint8_t, 12> KTX2_IDENTIFIER = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+const size_t KTX2_HEADER_SIZE = 80;
+const size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+const uint32_t KTX2_SUPERCOMPRESSION_NONE = 0;
+
+inline uint32_t readLittleEndian32(const char* data) {
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+inline uint64_t readLittleEndian64(const char* data) {
+	uint64_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+struct Ktx2Level {
+	const uint8_t* data = nullptr;
+	size_t         size = 0;
+	uint32_t      width = 0;
+	uint32_t     height = 0;
+};
+
+// generateMips is set for files with a level count of 0, which store level 0 alone and leave the rest to the loader
+struct Ktx2Texture {
+	VkFormat               format = VK_FORMAT_UNDEFINED;
+	uint32_t                width = 0;
+	uint32_t               height = 0;
+	bool             generateMips = false;
+	std::vector<Ktx2Level> levels;
+};
+
+// Bytes a level of the given extent takes: 4 per texel for RGBA8, 8 or 16 per 4x4 block for the BC and ETC2
+// formats. Zero for formats the loader can't size, those are rejected.
+inline size_t ktx2LevelSize(VkFormat format, uint32_t width, uint32_t height) {
+	size_t blocks = size_t((width + 3) / 4) * ((height + 3) / 4);
+	switch (format) {
+	case VK_FORMAT_R8G8B8A8_UNORM:
+	case VK_FORMAT_R8G8B8A8_SRGB:
+	case VK_FORMAT_B8G8R8A8_UNORM:
+	case VK_FORMAT_B8G8R8A8_SRGB:
+		return size_t(width) * height * 4;
+	case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+	case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+	case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+	case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+	case VK_FORMAT_BC4_UNORM_BLOCK:
+	case VK_FORMAT_BC4_SNORM_BLOCK:
+	case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+	case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+	case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+	case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+	case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+	case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+		return blocks * 8;
+	case VK_FORMAT_BC2_UNORM_BLOCK:
+	case VK_FORMAT_BC2_SRGB_BLOCK:
+	case VK_FORMAT_BC3_UNORM_BLOCK:
+	case VK_FORMAT_BC3_SRGB_BLOCK:
+	case VK_FORMAT_BC5_UNORM_BLOCK:
+	case VK_FORMAT_BC5_SNORM_BLOCK:
+	case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+	case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+	case VK_FORMAT_BC7_UNORM_BLOCK:
+	case VK_FORMAT_BC7_SRGB_BLOCK:
+	case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+	case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+	case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+	case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+		return blocks * 16;
+	default:
+		return 0;
+	}
+}
+
+inline Ktx2Texture parseKtx2(const MappedFile& file) {
+	if (file.size < KTX2_HEADER_SIZE || memcmp(file.data, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) != 0) {
+		throw std::runtime_error("not a KTX2 file");
+	}
+	Ktx2Texture texture;
+	texture.format = static_cast<VkFormat>(readLittleEndian32(file.data + 12));
+	texture.width = readLittleEndian32(file.data + 20);
+	texture.height = readLittleEndian32(file.data + 24);
+	uint32_t depth = readLittleEndian32(file.data + 28);
+	uint32_t layerCount = readLittleEndian32(file.data + 32);
+	uint32_t faceCount = readLittleEndian32(file.data + 36);
+	// zero asks the loader to generate the chain, the level index still has the entry of level 0
+	uint32_t levelCount = readLittleEndian32(file.data + 40);
+	texture.generateMips = levelCount == 0;
+	levelCount = std::max(levelCount, 1u);
+	uint32_t supercompression = readLittleEndian32(file.data + 44);
+	if (texture.format == VK_FORMAT_UNDEFINED) {
+		throw std::runtime_error("KTX2 file holds a Basis Universal payload, which needs the basisu transcoder");
+	}
+	if (supercompression != KTX2_SUPERCOMPRESSION_NONE) {
+		throw std::runtime_error("unsupported KTX2 supercompression scheme");
+	}
+	if (texture.width == 0 || texture.height == 0 || depth != 0 || layerCount > 1 || faceCount != 1) {
+		throw std::runtime_error("KTX2 file is not a single 2D texture");
+	}
+	if (ktx2LevelSize(texture.format, 1, 1) == 0) {
+		throw std::runtime_error("unsupported KTX2 format " + std::to_string(texture.format));
+	}
+	if (levelCount > 32 || KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE * levelCount > file.size) {
+		throw std::runtime_error("truncated KTX2 level index");
+	}
+
+	for (uint32_t level = 0; level < levelCount; level++) {
+		const char* entry = file.data + KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE * level;
+		uint64_t offset = readLittleEndian64(entry);
+		uint64_t length = readLittleEndian64(entry + 8);
+		if (length == 0 || offset > file.size || length > file.size - offset) {
+			throw std::runtime_error("KTX2 level runs past the end of the file");
+		}
+		Ktx2Level resolved;
+		resolved.data = reinterpret_cast<const uint8_t*>(file.data + offset);
+		resolved.size = static_cast<size_t>(length);
+		resolved.width = std::max(texture.width >> level, 1u);
+		resolved.height = std::max(texture.height >> level, 1u);
+		// the upload copies exactly what the extent implies, a shorter level would be read past its end
+		if (resolved.size != ktx2LevelSize(texture.format, resolved.width, resolved.height)) {
+			throw std::runtime_error("KTX2 level " + std::to_string(level) + " has the wrong size for its extent");
+		}
+		texture.levels.push_back(resolved);
+	}
+	return texture;
+}
+
+// note
+// How a level gets from the file into the staging buffer. Copy is for data that already is in the format of the
+// image, the others encode RGBA8 into 4x4 blocks of 8 bytes each, an eighth of the source size.
+enum class TextureEncoding {
+	Copy,
+	Bc1,
+	Etc2
+};
+
+const size_t COMPRESSED_BLOCK_BYTES = 8;
+
+inline const char* textureEncodingName(TextureEncoding encoding) {
+	switch (encoding) {
+	case TextureEncoding::Bc1:
+		return "BC1";
+	case TextureEncoding::Etc2:
+		return "ETC2";
+	default:
+		return "copy";
+	}
+}
+
+inline uint32_t blockCount(uint32_t texels) {
+	return (texels + 3) / 4;
+}
+
+// Texels of the 4x4 block at (blockX, blockY) in RGBA8, row by row. Blocks hanging over the edge of small mip levels
+// repeat the last row and column, those texels are never sampled.
+inline void gatherBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* texels) {
+	for (uint32_t y = 0; y < 4; y++) {
+		uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+		for (uint32_t x = 0; x < 4; x++) {
+			uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+			memcpy(texels + (y * 4 + x) * 4, rgba + (size_t(sourceY) * width + sourceX) * 4, 4);
+		}
+	}
+}
+
+inline uint16_t packRgb565(const float* color) {
+	auto r = static_cast<uint32_t>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	auto g = static_cast<uint32_t>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+	auto b = static_cast<uint32_t>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	return static_cast<uint16_t>(r << 11 | g << 5 | b);
+}
+
+inline void unpackRgb565(uint16_t packed, int* color) {
+	int r = packed >> 11, g = (packed >> 5) & 63, b = packed & 31;
+	color[0] = r << 3 | r >> 2;
+	color[1] = g << 2 | g >> 4;
+	color[2] = b << 3 | b >> 2;
+}
+
+// note
+// BC1 without alpha: two RGB565 endpoints and a 2 bit index per texel choosing an endpoint or one of the two
+// colors between them. The endpoints are the outermost texels along the principal axis of the block's colors,
+// found with a few rounds of power iteration on their covariance.
+inline void encodeBc1Block(const uint8_t* texels, uint8_t* block) {
+	float mean[3] = {};
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < 3; c++) {
+			mean[c] += texels[i * 4 + c] / 16.0f;
+		}
+	}
+	float covariance[3][3] = {};
+	for (int i = 0; i < 16; i++) {
+		float d[3] = { texels[i * 4] - mean[0], texels[i * 4 + 1] - mean[1], texels[i * 4 + 2] - mean[2] };
+		for (int r = 0; r < 3; r++) {
+			for (int c = 0; c < 3; c++) {
+				covariance[r][c] += d[r] * d[c];
+			}
+		}
+	}
+	float axis[3] = { 1.0f, 1.0f, 1.0f };
+	for (int iteration = 0; iteration < 8; iteration++) {
+		float next[3] = {};
+		for (int r = 0; r < 3; r++) {
+			next[r] = covariance[r][0] * axis[0] + covariance[r][1] * axis[1] + covariance[r][2] * axis[2];
+		}
+		float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+		if (length < 1e-6f) {
+			break;
+		}
+		for (int c = 0; c < 3; c++) {
+			axis[c] = next[c] / length;
+		}
+	}
+	float minT = std::numeric_limits<float>::max(), maxT = std::numeric_limits<float>::lowest();
+	for (int i = 0; i < 16; i++) {
+		float t = (texels[i * 4] - mean[0]) * axis[0] + (texels[i * 4 + 1] - mean[1]) * axis[1] + (texels[i * 4 + 2] - mean[2]) * axis[2];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	float high[3], low[3];
+	for (int c = 0; c < 3; c++) {
+		high[c] = mean[c] + axis[c] * maxT;
+		low[c] = mean[c] + axis[c] * minT;
+	}
+	uint16_t color0 = packRgb565(high);
+	uint16_t color1 = packRgb565(low);
+	// color0 > color1 selects the four color mode, equal endpoints leave every index at 0
+	if (color0 < color1) {
+		std::swap(color0, color1);
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1) {
+		int palette[4][3];
+		unpackRgb565(color0, palette[0]);
+		unpackRgb565(color1, palette[1]);
+		for (int c = 0; c < 3; c++) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		for (int i = 0; i < 16; i++) {
+			int bestError = std::numeric_limits<int>::max();
+			uint32_t best = 0;
+			for (uint32_t p = 0; p < 4; p++) {
+				int error = 0;
+				for (int c = 0; c < 3; c++) {
+					int d = texels[i * 4 + c] - palette[p][c];
+					error += d * d;
+				}
+				if (error < bestError) {
+					bestError = error;
+					best = p;
+				}
+			}
+			indices |= best << (i * 2);
+		}
+	}
+	block[0] = static_cast<uint8_t>(color0);
+	block[1] = static_cast<uint8_t>(color0 >> 8);
+	block[2] = static_cast<uint8_t>(color1);
+	block[3] = static_cast<uint8_t>(color1 >> 8);
+	memcpy(block + 4, &indices, sizeof(indices));
+}
+
+// note
+// The intensity modifier tables shared by ETC1 and ETC2, per table the small and the large step.
+const int ETC_MODIFIER_TABLES[8][2] = { { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+// Picks the modifier table and per texel modifiers that fit the 8 texels of one half block best around base.
+// Index values follow the format: 0 small step up, 1 large step up, 2 small step down, 3 large step down.
+inline int fitEtcHalf(const uint8_t* texels, const int* members, const int* base, uint32_t& table, uint32_t* indices) {
+	int bestTableError = std::numeric_limits<int>::max();
+	for (uint32_t t = 0; t < 8; t++) {
+		int modifiers[4] = { ETC_MODIFIER_TABLES[t][0], ETC_MODIFIER_TABLES[t][1], -ETC_MODIFIER_TABLES[t][0], -ETC_MODIFIER_TABLES[t][1] };
+		int tableError = 0;
+		uint32_t tableIndices[8];
+		for (int i = 0; i < 8; i++) {
+			const uint8_t* texel = texels + members[i] * 4;
+			int bestError = std::numeric_limits<int>::max();
+			for (uint32_t m = 0; m < 4; m++) {
+				int error = 0;
+				for (int c = 0; c < 3; c++) {
+					int d = texel[c] - std::clamp(base[c] + modifiers[m], 0, 255);
+					error += d * d;
+				}
+				if (error < bestError) {
+					bestError = error;
+					tableIndices[i] = m;
+				}
+			}
+			tableError += bestError;
+		}
+		if (tableError < bestTableError) {
+			bestTableError = tableError;
+			table = t;
+			std::copy(tableIndices, tableIndices + 8, indices);
+		}
+	}
+	return bestTableError;
+}
+
+// note
+// ETC2 RGB restricted to the modes it inherits from ETC1: the block splits into two halves, side by side or one
+// above the other, each with a base color and a modifier table. Base colors are 5 bits each with a 3 bit
+// difference when they are close enough, 4 bits each otherwise. Both splits are tried and the better one kept.
+// Differential blocks are only written with sums inside 0..31, so no decoder reads them as the T, H or planar modes.
+inline void encodeEtc2Block(const uint8_t* texels, uint8_t* block) {
+	uint64_t bestBits = 0;
+	int bestError = std::numeric_limits<int>::max();
+	for (uint32_t flip = 0; flip < 2; flip++) {
+		// texels are stored row by row, flip 0 splits into left and right halves, flip 1 into top and bottom
+		int members[2][8];
+		int counts[2] = {};
+		for (int y = 0; y < 4; y++) {
+			for (int x = 0; x < 4; x++) {
+				int half = flip ? y / 2 : x / 2;
+				members[half][counts[half]++] = y * 4 + x;
+			}
+		}
+		float average[2][3] = {};
+		for (int half = 0; half < 2; half++) {
+			for (int i = 0; i < 8; i++) {
+				for (int c = 0; c < 3; c++) {
+					average[half][c] += texels[members[half][i] * 4 + c] / 8.0f;
+				}
+			}
+		}
+
+		int quantized[2][3];
+		bool differential = true;
+		for (int c = 0; c < 3; c++) {
+			quantized[0][c] = static_cast<int>(average[0][c] * 31.0f / 255.0f + 0.5f);
+			quantized[1][c] = static_cast<int>(average[1][c] * 31.0f / 255.0f + 0.5f);
+			int difference = quantized[1][c] - quantized[0][c];
+			differential = differential && difference >= -4 && difference <= 3;
+		}
+		int base[2][3];
+		for (int half = 0; half < 2; half++) {
+			for (int c = 0; c < 3; c++) {
+				if (differential) {
+					base[half][c] = quantized[half][c] << 3 | quantized[half][c] >> 2;
+				}
+				else {
+					quantized[half][c] = static_cast<int>(average[half][c] * 15.0f / 255.0f + 0.5f);
+					base[half][c] = quantized[half][c] * 17;
+				}
+			}
+		}
+
+		uint32_t tables[2] = {};
+		uint32_t indices[2][8] = {};
+		int error = fitEtcHalf(texels, members[0], base[0], tables[0], indices[0]) + fitEtcHalf(texels, members[1], base[1], tables[1], indices[1]);
+		if (error >= bestError) {
+			continue;
+		}
+		bestError = error;
+
+		uint64_t bits = 0;
+		for (int c = 0; c < 3; c++) {
+			int shift = 59 - c * 8;
+			if (differential) {
+				bits |= uint64_t(quantized[0][c]) << shift;
+				bits |= uint64_t((quantized[1][c] - quantized[0][c]) & 7) << (shift - 3);
+			}
+			else {
+				bits |= uint64_t(quantized[0][c]) << (shift + 1);
+				bits |= uint64_t(quantized[1][c]) << (shift - 3);
+			}
+		}
+		bits |= uint64_t(tables[0]) << 37 | uint64_t(tables[1]) << 34 | uint64_t(differential) << 33 | uint64_t(flip) << 32;
+		// pixel indices are numbered column by column, their high bits fill 31..16 and their low bits 15..0
+		for (int half = 0; half < 2; half++) {
+			for (int i = 0; i < 8; i++) {
+				int texel = members[half][i];
+				int pixel = (texel % 4) * 4 + texel / 4;
+				bits |= uint64_t(indices[half][i] >> 1) << (16 + pixel) | uint64_t(indices[half][i] & 1) << pixel;
+			}
+		}
+		bestBits = bits;
+	}
+	// ETC blocks are stored big endian
+	for (int i = 0; i < 8; i++) {
+		block[i] = static_cast<uint8_t>(bestBits >> (56 - i * 8));
+	}
+}
+
+// note
+// A texture on its way to the GPU: the format its image is created with and, per mip level, the source texels
+// in the mapped file and where the encoded level goes in the staging buffer.
+struct TextureUploadLevel {
+	const uint8_t*  source = nullptr;
+	size_t      sourceSize = 0;
+	VkDeviceSize    offset = 0;
+	VkDeviceSize      size = 0;
+	uint32_t         width = 0;
+	uint32_t        height = 0;
+};
+
+// The image has mipLevels levels, with generateMips only the first of them is uploaded.
+struct TextureUploadPlan {
+	VkFormat                         format = VK_FORMAT_UNDEFINED;
+	TextureEncoding                encoding = TextureEncoding::Copy;
+	uint32_t                          width = 0;
+	uint32_t                         height = 0;
+	uint32_t                      mipLevels = 0;
+	bool                       generateMips = false;
+	std::vector<TextureUploadLevel>  levels;
+};
+
+// One unit of work for the pool, a run of block rows of one level. Small levels are one task each.
+struct TranscodeTask {
+	uint32_t       texture = 0;
+	uint32_t         level = 0;
+	uint32_t firstBlockRow = 0;
+	uint32_t     blockRows = 0;
+};
+
+const uint32_t TRANSCODE_TASK_BLOCK_ROWS = 8;
+
+// Lays the levels of every plan out one after another from offset, each level aligned for vkCmdCopyBufferToImage,
+// and cuts them into tasks. Returns the end of the last level.
+inline VkDeviceSize planTranscode(std::vector<TextureUploadPlan>& plans, VkDeviceSize offset, std::vector<TranscodeTask>& tasks) {
+	for (uint32_t t = 0; t < plans.size(); t++) {
+		auto& plan = plans[t];
+		for (uint32_t l = 0; l < plan.levels.size(); l++) {
+			auto& level = plan.levels[l];
+			uint32_t blockRows = blockCount(level.height);
+			level.size = plan.encoding == TextureEncoding::Copy ? level.sourceSize : VkDeviceSize(blockCount(level.width)) * blockRows * COMPRESSED_BLOCK_BYTES;
+			// a multiple of the 8 and 16 byte compressed blocks and of 4 byte texels, as vkCmdCopyBufferToImage needs
+			level.offset = (offset + 15) & ~VkDeviceSize(15);
+			offset = level.offset + level.size;
+			if (plan.encoding == TextureEncoding::Copy) {
+				tasks.push_back({ t, l, 0, blockRows });
+				continue;
+			}
+			for (uint32_t row = 0; row < blockRows; row += TRANSCODE_TASK_BLOCK_ROWS) {
+				tasks.push_back({ t, l, row, std::min(TRANSCODE_TASK_BLOCK_ROWS, blockRows - row) });
+			}
+		}
+	}
+	return offset;
+}
+
+inline void runTranscodeTask(const std::vector<TextureUploadPlan>& plans, const TranscodeTask& task, uint8_t* staging) {
+	auto& plan = plans[task.texture];
+	auto& level = plan.levels[task.level];
+	uint8_t* destination = staging + level.offset;
+	if (plan.encoding == TextureEncoding::Copy) {
+		memcpy(destination, level.source, level.sourceSize);
+		return;
+	}
+	uint32_t blocksX = blockCount(level.width);
+	uint8_t texels[64];
+	for (uint32_t blockY = task.firstBlockRow; blockY < task.firstBlockRow + task.blockRows; blockY++) {
+		for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+			gatherBlock(level.source, level.width, level.height, blockX, blockY, texels);
+			uint8_t* block = destination + (size_t(blockY) * blocksX + blockX) * COMPRESSED_BLOCK_BYTES;
+			if (plan.encoding == TextureEncoding::Bc1) {
+				encodeBc1Block(texels, block);
+			}
+			else {
+				encodeEtc2Block(texels, block);
+			}
+		}
+	}
+}
+
+// note
+// Halves an RGBA8 image with a 2x2 box filter, odd edges reuse their last texel.
+inline std::vector<uint32_t> downsampleRgba8(const std::vector<uint32_t>& texels, uint32_t width, uint32_t height) {
+	uint32_t halfWidth = std::max(width / 2, 1u), halfHeight = std::max(height / 2, 1u);
+	std::vector<uint32_t> result(size_t(halfWidth) * halfHeight);
+	for (uint32_t y = 0; y < halfHeight; y++) {
+		for (uint32_t x = 0; x < halfWidth; x++) {
+			uint32_t sum[4] = {};
+			for (uint32_t i = 0; i < 4; i++) {
+				uint32_t sourceX = std::min(x * 2 + i % 2, width - 1), sourceY = std::min(y * 2 + i / 2, height - 1);
+				uint32_t texel = texels[size_t(sourceY) * width + sourceX];
+				for (uint32_t c = 0; c < 4; c++) {
+					sum[c] += (texel >> (c * 8)) & 0xff;
+				}
+			}
+			uint32_t packed = 0;
+			for (uint32_t c = 0; c < 4; c++) {
+				packed |= ((sum[c] + 2) / 4) << (c * 8);
+			}
+			result[size_t(y) * halfWidth + x] = packed;
+		}
+	}
+	return result;
+}
+
+// note
+// GPU mip generation. The compute path writes every level below level 0 in one dispatch of mipgen.comp, images it
+// can't take get one vkCmdBlitImage per level instead, each waiting on the one before.
+enum class MipGenerationPath {
+	Compute,
+	Blit
+};
+
+inline const char* mipGenerationPathName(MipGenerationPath path) {
+	switch (path) {
+	case MipGenerationPath::Compute:
+		return "single pass compute";
+	case MipGenerationPath::Blit:
+		return "blit per level";
+	}
+	return "unknown";
+}
+
+// A workgroup reduces a 64x64 tile of its source level, six levels down to one texel.
+const uint32_t MIP_GENERATION_TILE_SIZE = 64;
+const uint32_t MIP_GENERATION_TILE_LEVELS = 6;
+// The last workgroup reduces one tile of level 6 on top, so a dispatch goes up to 4096x4096 and its 13 levels.
+// Also the size of the mips array in mipgen.comp.
+const uint32_t MAX_COMPUTE_MIP_LEVELS = 2 * MIP_GENERATION_TILE_LEVELS + 1;
+// Anything larger has a level 6 wider than that one tile, 4097 to 8191 still fits in 13 levels.
+const uint32_t MAX_COMPUTE_MIP_EXTENT = MIP_GENERATION_TILE_SIZE << MIP_GENERATION_TILE_LEVELS;
+
+// Matches the MipParams push constant block in mipgen.comp.
+struct MipGenerationConstants {
+	uint32_t levelCount;
+	uint32_t groupCount;
+};
+
+using MipPushConstants = PushConstantBlock<MipGenerationConstants, 0, VK_SHADER_STAGE_COMPUTE_BIT>;
+
+// levels down to 1x1 along the longer side
+inline uint32_t mipLevelCount(uint32_t width, uint32_t height) {
+	uint32_t levels = 1;
+	for (uint32_t size = std::max(width, height); size > 1; size /= 2) {
+		levels++;
+	}
+	return levels;
+}
+
+// An image whose levels below 0 are generated, with the storage views and the set the compute path binds.
+struct MipChainImage {
+	VkImage                       image = nullptr;
+	VkFormat                     format = VK_FORMAT_UNDEFINED;
+	uint32_t                      width = 0;
+	uint32_t                     height = 0;
+	uint32_t                 levelCount = 0;
+	MipGenerationPath              path = MipGenerationPath::Blit;
+	std::vector<VkImageView> levelViews;
+	VkDescriptorSet       descriptorSet = nullptr;
+};
+
+// note
+inline void hashCombine(size_t& seed, size_t value) {
+	seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+// Everything that tells two image views apart: the image, how it is viewed and which part of it.
+struct ImageViewKey {
+	VkImage                    image = nullptr;
+	VkImageViewType         viewType = VK_IMAGE_VIEW_TYPE_2D;
+	VkFormat                  format = VK_FORMAT_UNDEFINED;
+	VkComponentSwizzle             r = VK_COMPONENT_SWIZZLE_IDENTITY;
+	VkComponentSwizzle             g = VK_COMPONENT_SWIZZLE_IDENTITY;
+	VkComponentSwizzle             b = VK_COMPONENT_SWIZZLE_IDENTITY;
+	VkComponentSwizzle             a = VK_COMPONENT_SWIZZLE_IDENTITY;
+	VkImageAspectFlags    aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	uint32_t            baseMipLevel = 0;
+	uint32_t              levelCount = VK_REMAINING_MIP_LEVELS;
+	uint32_t          baseArrayLayer = 0;
+	uint32_t              layerCount = 1;
+
+	bool operator==(const ImageViewKey&) const = default;
+};
+
+struct ImageViewKeyHash {
+	size_t operator()(const ImageViewKey& key) const {
+		size_t seed = std::hash<VkImage>()(key.image);
+		hashCombine(seed, std::hash<uint64_t>()((uint64_t(key.viewType) << 32) | key.format));
+		hashCombine(seed, std::hash<uint32_t>()((key.r << 24) | (key.g << 16) | (key.b << 8) | key.a));
+		hashCombine(seed, std::hash<uint64_t>()((uint64_t(key.aspectMask) << 32) | key.baseMipLevel));
+		hashCombine(seed, std::hash<uint64_t>()((uint64_t(key.levelCount) << 32) | key.baseArrayLayer));
+		hashCombine(seed, std::hash<uint32_t>()(key.layerCount));
+		return seed;
+	}
+};
+
+// Sampler state, VkSamplerCreateInfo without flags and extension structs. The defaults are the material
+// textures' sampler: linear, repeating, every mip level.
+struct SamplerKey {
+	VkFilter                     magFilter = VK_FILTER_LINEAR;
+	VkFilter                     minFilter = VK_FILTER_LINEAR;
+	VkSamplerMipmapMode         mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	VkSamplerAddressMode      addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	VkSamplerAddressMode      addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	VkSamplerAddressMode      addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	float                       mipLodBias = 0.0f;
+	VkBool32              anisotropyEnable = VK_FALSE;
+	float                    maxAnisotropy = 1.0f;
+	VkBool32                 compareEnable = VK_FALSE;
+	VkCompareOp                  compareOp = VK_COMPARE_OP_NEVER;
+	float                           minLod = 0.0f;
+	float                           maxLod = VK_LOD_CLAMP_NONE;
+	VkBorderColor              borderColor = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+	VkBool32       unnormalizedCoordinates = VK_FALSE;
+
+	bool operator==(const SamplerKey&) const = default;
+};
+
+struct SamplerKeyHash {
+	size_t operator()(const SamplerKey& key) const {
+		size_t seed = std::hash<uint32_t>()((key.magFilter << 24) | (key.minFilter << 16) | (key.mipmapMode << 8) | key.borderColor);
+		hashCombine(seed, std::hash<uint32_t>()((key.addressModeU << 16) | (key.addressModeV << 8) | key.addressModeW));
+		hashCombine(seed, std::hash<uint32_t>()((key.anisotropyEnable << 16) | (key.compareEnable << 8) | key.compareOp));
+		hashCombine(seed, std::hash<uint32_t>()(key.unnormalizedCoordinates));
+		for (float value : { key.mipLodBias, key.maxAnisotropy, key.minLod, key.maxLod }) {
+			hashCombine(seed, std::hash<float>()(value));
+		}
+		return seed;
+	}
+};
+
+struct ObjectCacheStats {
+	uint64_t   hits = 0;
+	uint64_t misses = 0;
+};
+
+// note
+// Vulkan objects created on the first lookup of their key and shared from then on, callers never destroy them.
+// Lookups share the lock, so recording threads only wait on each other when one of them misses. A miss creates
+// under the exclusive lock, another thread missing on the same key finds the object once it gets the lock.
+template <typename Key, typename Object, typename Hash>
+struct SharedObjectCache {
+	mutable std::shared_mutex               mutex;
+	std::unordered_map<Key, Object, Hash> objects;
+	std::atomic<uint64_t>                    hits = 0;
+	std::atomic<uint64_t>                  misses = 0;
+
+	template <typename Create>
+	Object acquire(const Key& key, Create&& create) {
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			auto cached = objects.find(key);
+			if (cached != objects.end()) {
+				hits.fetch_add(1, std::memory_order_relaxed);
+				return cached->second;
+			}
+		}
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		auto cached = objects.find(key);
+		if (cached != objects.end()) {
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return cached->second;
+		}
+		misses.fetch_add(1, std::memory_order_relaxed);
+		Object created = create(key);
+		objects.emplace(key, created);
+		return created;
+	}
+
+	// Hands every object the predicate picks to destroy and forgets it, none of them may be in use any more.
+	template <typename Retired, typename Destroy>
+	void evict(Retired&& retired, Destroy&& destroy) {
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		for (auto it = objects.begin(); it != objects.end();) {
+			if (retired(it->first)) {
+				destroy(it->second);
+				it = objects.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+	}
+
+	size_t size() const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return objects.size();
+	}
+
+	ObjectCacheStats stats() const {
+		return { hits.load(std::memory_order_relaxed), misses.load(std::memory_order_relaxed) };
+	}
+};
+
+inline VkImageViewCreateInfo imageViewCreateInfo(const ImageViewKey& key) {
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = key.image;
+	viewInfo.viewType = key.viewType;
+	viewInfo.format = key.format;
+	viewInfo.components = { key.r, key.g, key.b, key.a };
+	viewInfo.subresourceRange = { key.aspectMask, key.baseMipLevel, key.levelCount, key.baseArrayLayer, key.layerCount };
+	return viewInfo;
+}
+
+inline VkSamplerCreateInfo samplerCreateInfo(const SamplerKey& key) {
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = key.magFilter;
+	samplerInfo.minFilter = key.minFilter;
+	samplerInfo.mipmapMode = key.mipmapMode;
+	samplerInfo.addressModeU = key.addressModeU;
+	samplerInfo.addressModeV = key.addressModeV;
+	samplerInfo.addressModeW = key.addressModeW;
+	samplerInfo.mipLodBias = key.mipLodBias;
+	samplerInfo.anisotropyEnable = key.anisotropyEnable;
+	samplerInfo.maxAnisotropy = key.maxAnisotropy;
+	samplerInfo.compareEnable = key.compareEnable;
+	samplerInfo.compareOp = key.compareOp;
+	samplerInfo.minLod = key.minLod;
+	samplerInfo.maxLod = key.maxLod;
+	samplerInfo.borderColor = key.borderColor;
+	samplerInfo.unnormalizedCoordinates = key.unnormalizedCoordinates;
+	return samplerInfo;
+}
+
+// note
+// Timestamps are written in pairs around a pass, this many passes fit into one query pool.
+const uint32_t GPU_PROFILER_MAX_PASSES = 16;
+// frames the rolling per-pass statistics cover
+const uint32_t GPU_PROFILER_HISTORY = 120;
+// frames between two printed reports
+const uint32_t GPU_PROFILER_REPORT_INTERVAL = 1000;
+// what beginGpuPass returns when the pass is not timed
+const uint32_t GPU_PASS_NONE = std::numeric_limits<uint32_t>::max();
+
+// note
+// A query pool and the passes the command buffer using it wrote, pass i owns queries 2i and 2i + 1.
+struct GpuQuerySlot {
+	VkQueryPool                  pool = nullptr;
+	std::vector<const char*>   passes;
+	// which submission last ran the slot and when it was handed to the queue, for the trace
+	uint64_t               submission = 0;
+	uint64_t               submitTime = 0;
+};
+
+// note
+// Durations in milliseconds of the last GPU_PROFILER_HISTORY times a pass ran.
+struct GpuPassStats {
+	std::string                                   name;
+	std::array<double, GPU_PROFILER_HISTORY>  samples{};
+	uint64_t                                     total = 0;
+
+	void add(double milliseconds) {
+		samples[total % GPU_PROFILER_HISTORY] = milliseconds;
+		total++;
+	}
+
+	uint32_t count() const {
+		return static_cast<uint32_t>(std::min<uint64_t>(total, GPU_PROFILER_HISTORY));
+	}
+
+	double average() const {
+		double sum = 0.0;
+		for (uint32_t i = 0; i < count(); i++) {
+			sum += samples[i];
+		}
+		return count() ? sum / count() : 0.0;
+	}
+
+	double minimum() const {
+		return count() ? *std::min_element(samples.begin(), samples.begin() + count()) : 0.0;
+	}
+
+	double maximum() const {
+		return count() ? *std::max_element(samples.begin(), samples.begin() + count()) : 0.0;
+	}
+};
+
+// note
+// A device timestamp and the profiler time it was taken at, maxDeviation in nanoseconds bounds the error.
+struct GpuClockCalibration {
+	uint64_t           gpuTicks = 0;
+	uint64_t            cpuTime = 0;
+	uint64_t       maxDeviation = 0;
+};
+
+// note
+// steady_clock reads QueryPerformanceCounter on Windows and CLOCK_MONOTONIC elsewhere, so those are the host
+// domains to calibrate against. hostTimeToProfiler turns a value in that domain into profiler nanoseconds.
+#ifdef _WIN32
+const VkTimeDomainKHR HOST_TIME_DOMAIN = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_KHR;
+#else
+const VkTimeDomainKHR HOST_TIME_DOMAIN = VK_TIME_DOMAIN_CLOCK_MONOTONIC_KHR;
+#endif
+
+inline uint64_t hostTimeToProfiler(uint64_t hostTime) {
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	uint64_t ticksPerSecond = frequency.QuadPart;
+	uint64_t nanoseconds = hostTime / ticksPerSecond * 1000000000 + hostTime % ticksPerSecond * 1000000000 / ticksPerSecond;
+#else
+	uint64_t nanoseconds = hostTime;
+#endif
+	uint64_t epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(profiler().epoch.time_since_epoch()).count();
+	return nanoseconds > epoch ? nanoseconds - epoch : 0;
+}
+
+// note
+// Commands one frame recorded. Only the main thread records, so plain integers do.
+struct CommandCounters {
+	uint64_t                 draws = 0;
+	uint64_t            dispatches = 0;
+	uint64_t         pipelineBinds = 0;
+	uint64_t       descriptorBinds = 0;
+	uint64_t           bufferBinds = 0;
+	uint64_t              barriers = 0;
+	uint64_t     descriptorUpdates = 0;
+};
+
+// note
+// A device function pointer that counts its calls. It is assigned the loaded pointer and called like the bare
+// PFN, so call sites stay as they are while every call adds one to its counter.
+template <typename Function>
+struct CountedCommand;
+
+template <typename... Args>
+struct CountedCommand<void (VKAPI_PTR*)(Args...)> {
+	void (VKAPI_PTR* function)(Args...) = nullptr;
+	uint64_t*                            counter = nullptr;
+
+	explicit CountedCommand(uint64_t* counter) : counter(counter) {}
+
+	CountedCommand& operator=(void (VKAPI_PTR* loaded)(Args...)) {
+		function = loaded;
+		return *this;
+	}
+
+	void operator()(Args... args) const {
+		(*counter)++;
+		function(args...);
+	}
+};
+
+// note
+// What the scene pass's statistics query counts. The query returns the values in the order of their flag bits,
+// which is the order of the members below.
+const VkQueryPipelineStatisticFlags PIPELINE_STATISTICS = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+	VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+	VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+struct PipelineStatistics {
+	uint64_t       inputAssemblyVertices = 0;
+	uint64_t     vertexShaderInvocations = 0;
+	uint64_t         clippingInvocations = 0;
+	uint64_t          clippingPrimitives = 0;
+	uint64_t   fragmentShaderInvocations = 0;
+};
+static_assert(sizeof(PipelineStatistics) == 5 * sizeof(uint64_t));
+
+// note
+// One frame's numbers. pipeline stays empty where statistics queries are off or the result never came.
+struct FrameStats {
+	uint64_t                             frame = 0;
+	CommandCounters                   commands;
+	std::optional<PipelineStatistics> pipeline;
+};
+
+const uint32_t WIDTH = 800;
+const uint32_t HEIGHT = 600;
+
+// note
+const int MAX_FRAMES_IN_FLIGHT = 2;
+const uint32_t SCENE_GRID_SIZE = 8;
+// spheres of 8x16 up to 64x128 quads, all in one vertex and one index buffer
+const uint32_t MESH_POOL_LODS = 4;
+const uint32_t MAX_DRAW_INSTANCES = 1 << 17;
+// note
+// also the size of the materialTextures array in the shaders
+const uint32_t MATERIAL_TEXTURE_COUNT = 64;
+// note
+// written to the temp directory when no .ktx2 files are given on the command line
+const uint32_t SYNTHETIC_TEXTURE_COUNT = 4;
+const uint32_t SYNTHETIC_TEXTURE_SIZE = 1024;
+// note
+// scopes timed back to back on the main thread to measure what one costs
+const uint32_t PROFILE_BENCHMARK_SCOPES = 4096;
+// note
+// the texture upload times its passes in the query pool after the frame slots'
+const uint32_t GPU_UPLOAD_QUERY_SLOT = MAX_FRAMES_IN_FLIGHT;
+// note
+// pipeline statistics queries around the scene pass, where the device supports them
+const bool ENABLE_PIPELINE_STATISTICS = true;
+// frames of stats kept for the report and the dump
+const uint32_t FRAME_STATS_HISTORY = 1000;
+const char* FRAME_STATS_PATH = "frame-stats.csv";
+
+class HelloTriangleApplication {
+public:
+	// note
+	// .ktx2 files for the material textures, taken from the command line
+	std::vector<std::string> texturePaths;
+
+	void run() {
+		PROFILE_THREAD_NAME("main");
+		initWindow();
+		initVulkan();
+		mainLoop();
+		cleanup();
+		PROFILE_WRITE_TRACE(PROFILE_TRACE_PATH);
+	}
+
+private:
+	GLFWwindow* window = nullptr;
+	VkInstance                             instance = nullptr;
+	VkPhysicalDevice                 physicalDevice = nullptr;
+	VkDevice                                 device = nullptr;
+	VkSurfaceKHR                            surface = nullptr;
+	VkQueue                           graphicsQueue = nullptr;
+	VkQueue                            presentQueue = nullptr;
+	VkSwapchainKHR                        swapChain = nullptr;
+	std::vector<VkImage>            swapChainImages;
+	VkFormat                   swapChainImageFormat;
+	VkExtent2D                      swapChainExtent;
+	std::vector<VkImageView>    swapChainImageViews;
+
+	VkShaderModule                 vertShaderModule = nullptr;
+	VkShaderModule                 fragShaderModule = nullptr;
+
+	VkPipelineLayout                 pipelineLayout = nullptr;
+
+	PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = nullptr;
+	PFN_vkGetDeviceProcAddr     vkGetDeviceProcAddr = nullptr;
+	PFN_vkDestroyInstance         vkDestroyInstance = nullptr;
+	PFN_vkDestroyDevice             vkDestroyDevice = nullptr;
+	PFN_vkDestroySurfaceKHR	    vkDestroySurfaceKHR = nullptr;
+	PFN_vkDestroySwapchainKHR vkDestroySwapchainKHR = nullptr;
+	PFN_vkDestroyImageView	     vkDestroyImageView = nullptr;
+	PFN_vkDestroyShaderModule vkDestroyShaderModule = nullptr;
+	PFN_vkDestroyPipelineLayout vkDestroyPipelineLayout;
+
+	// note
+	VkRenderPass                         renderPass = nullptr;
+	PFN_vkDestroyRenderPass     vkDestroyRenderPass;
+	VkPipeline                     graphicsPipeline = nullptr;
+	PFN_vkDestroyPipeline         vkDestroyPipeline;
+
+	// note
+	// Set 0 holds the frame's instances (binding 0) and all material textures (binding 1), one set per frame in
+	// flight. Draws pick from both through DrawConstants.
+	VkDescriptorSetLayout            frameSetLayout = nullptr;
+	VkDescriptorPool            frameDescriptorPool = nullptr;
+	std::vector<VkDescriptorSet> frameDescriptorSets;
+	std::vector<VkBuffer>               instanceBuffers;
+	std::vector<VkDeviceMemory>        instanceMemories;
+	std::vector<InstanceData*>          mappedInstances;
+	std::vector<VkImage>                  textureImages;
+	std::vector<VkDeviceMemory>         textureMemories;
+	std::vector<VkImageView>               textureViews;
+	std::vector<VkSampler>                     samplers;
+	// note
+	// Every image view and sampler comes from these, each distinct one is created once however often it is asked
+	// for. Cleanup destroys the cached objects, nothing else does.
+	SharedObjectCache<ImageViewKey, VkImageView, ImageViewKeyHash> imageViewCache;
+	SharedObjectCache<SamplerKey, VkSampler, SamplerKeyHash>          samplerCache;
+	PFN_vkCreateImageView                 vkCreateImageView = nullptr;
+	PFN_vkCreateSampler                     vkCreateSampler = nullptr;
+	// note
+	// mipgen.comp and what it binds: a set per image naming a storage view of each level, and the counter its
+	// workgroups check in on. computeMips is off where the device can't run it, every image blits then.
+	VkShaderModule                  mipShaderModule = nullptr;
+	VkDescriptorSetLayout              mipSetLayout = nullptr;
+	VkPipelineLayout              mipPipelineLayout = nullptr;
+	VkPipeline                          mipPipeline = nullptr;
+	VkDescriptorPool              mipDescriptorPool = nullptr;
+	VkBuffer                       mipCounterBuffer = nullptr;
+	VkDeviceMemory                 mipCounterMemory = nullptr;
+	bool                                computeMips = false;
+	// note
+	// GPU timestamps around passes. A frame slot's pool is read after its fence, when the slot comes around
+	// again, so the results are in and reading never stalls. Without synchronization2 vkCmdWriteTimestamp2 stays
+	// null and vkCmdWriteTimestamp writes them.
+	std::vector<GpuQuerySlot>         gpuQuerySlots;
+	std::vector<GpuPassStats>          gpuPassStats;
+	uint32_t                     timestampValidBits = 0;
+	float                           timestampPeriod = 0.0f;
+	uint64_t                             frameCount = 0;
+	PFN_vkCmdWriteTimestamp2   vkCmdWriteTimestamp2 = nullptr;
+	PFN_vkCmdWriteTimestamp     vkCmdWriteTimestamp = nullptr;
+	PFN_vkCmdResetQueryPool     vkCmdResetQueryPool = nullptr;
+	PFN_vkGetQueryPoolResults vkGetQueryPoolResults = nullptr;
+	PFN_vkDestroyQueryPool       vkDestroyQueryPool = nullptr;
+	// note
+	// Puts collected passes on the profiler's clock, so they land in the CPU trace. vkGetCalibratedTimestamps
+	// stays null without VK_KHR_calibrated_timestamps or VK_EXT_calibrated_timestamps, the GPU stays out then.
+	PFN_vkGetCalibratedTimestampsKHR vkGetCalibratedTimestamps = nullptr;
+	std::string       calibratedTimestampsExtension;
+	GpuClockCalibration              gpuCalibration;
+	uint64_t                        submissionCount = 0;
+	uint64_t                           gpuIdleSince = 0;
+	uint32_t                               gpuTrack = 0;
+	uint32_t                        submissionTrack = 0;
+	// note
+	// The frame statistics. The recording functions below count into commandCounters, a frame's counts then wait
+	// in its slot until the slot's statistics query can be read.
+	CommandCounters                 commandCounters;
+	std::vector<VkQueryPool>        statisticsPools;
+	std::vector<FrameStats>         frameStatsSlots;
+	std::deque<FrameStats>        frameStatsHistory;
+	PFN_vkCmdBeginQuery             vkCmdBeginQuery = nullptr;
+	PFN_vkCmdEndQuery                 vkCmdEndQuery = nullptr;
+	CountedCommand<PFN_vkCmdBindPipeline>             vkCmdBindPipeline{ &commandCounters.pipelineBinds };
+	CountedCommand<PFN_vkCmdBindVertexBuffers>   vkCmdBindVertexBuffers{ &commandCounters.bufferBinds };
+	CountedCommand<PFN_vkCmdBindIndexBuffer>       vkCmdBindIndexBuffer{ &commandCounters.bufferBinds };
+	CountedCommand<PFN_vkCmdBindDescriptorSets> vkCmdBindDescriptorSets{ &commandCounters.descriptorBinds };
+	CountedCommand<PFN_vkCmdDrawIndexed>               vkCmdDrawIndexed{ &commandCounters.draws };
+	CountedCommand<PFN_vkCmdDispatch>                     vkCmdDispatch{ &commandCounters.dispatches };
+	CountedCommand<PFN_vkCmdPipelineBarrier>       vkCmdPipelineBarrier{ &commandCounters.barriers };
+	CountedCommand<PFN_vkUpdateDescriptorSets>   vkUpdateDescriptorSets{ &commandCounters.descriptorUpdates };
+	VkBuffer                   meshPoolVertexBuffer = nullptr;
+	VkDeviceMemory             meshPoolVertexMemory = nullptr;
+	VkBuffer                    meshPoolIndexBuffer = nullptr;
+	VkDeviceMemory              meshPoolIndexMemory = nullptr;
+	std::vector<MeshRange>               meshRanges;
+	std::vector<DrawItem>                sceneDraws;
+
+	// note
+	QueueFamilyIndices           queueFamilyIndices;
+	std::vector<VkFramebuffer>  swapChainFramebuffers;
+	VkCommandPool                       commandPool = nullptr;
+	std::vector<VkCommandBuffer>       commandBuffers;
+	std::vector<VkSemaphore> imageAvailableSemaphores;
+	std::vector<VkSemaphore> renderFinishedSemaphores;
+	std::vector<VkFence>               inFlightFences;
+	uint32_t                           currentFrame = 0;
+
+	PFN_vkDestroyFramebuffer     vkDestroyFramebuffer = nullptr;
+	PFN_vkDestroyCommandPool     vkDestroyCommandPool = nullptr;
+	PFN_vkDestroySemaphore         vkDestroySemaphore = nullptr;
+	PFN_vkDestroyFence                 vkDestroyFence = nullptr;
+	PFN_vkDestroyBuffer               vkDestroyBuffer = nullptr;
+	PFN_vkFreeMemory                     vkFreeMemory = nullptr;
+	PFN_vkDeviceWaitIdle             vkDeviceWaitIdle = nullptr;
+	PFN_vkWaitForFences               vkWaitForFences = nullptr;
+	PFN_vkResetFences                   vkResetFences = nullptr;
+	PFN_vkAcquireNextImageKHR   vkAcquireNextImageKHR = nullptr;
+	PFN_vkQueueSubmit                   vkQueueSubmit = nullptr;
+	PFN_vkQueuePresentKHR           vkQueuePresentKHR = nullptr;
+	PFN_vkBeginCommandBuffer     vkBeginCommandBuffer = nullptr;
+	PFN_vkEndCommandBuffer         vkEndCommandBuffer = nullptr;
+	PFN_vkResetCommandBuffer     vkResetCommandBuffer = nullptr;
+	PFN_vkCmdBeginRenderPass     vkCmdBeginRenderPass = nullptr;
+	PFN_vkCmdEndRenderPass         vkCmdEndRenderPass = nullptr;
+	PFN_vkCmdCopyBuffer               vkCmdCopyBuffer = nullptr;
+	PFN_vkCmdPushConstants           vkCmdPushConstants = nullptr;
+	PFN_vkCmdBlitImage                   vkCmdBlitImage = nullptr;
+	PFN_vkDestroyDescriptorSetLayout vkDestroyDescriptorSetLayout = nullptr;
+	PFN_vkDestroyDescriptorPool vkDestroyDescriptorPool = nullptr;
+	PFN_vkDestroyImage                   vkDestroyImage = nullptr;
+	PFN_vkDestroySampler               vkDestroySampler = nullptr;
+
+#ifndef NDEBUG
+	VkDebugUtilsMessengerEXT         debugMessenger = nullptr;
+	PFN_vkDestroyDebugUtilsMessengerEXT vkDestroyDebugUtilsMessengerEXT = nullptr;
+#endif
+
+	void initWindow() {
+		PROFILE_FUNCTION();
+		glfwInit();
+
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+
+		window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan", nullptr, nullptr);
+	}
+
+	void initVulkan() {
+		PROFILE_FUNCTION();
+		initInstance();
+		createSurface();
+		selectPhysicalDevice();
+		initDevice();
+		createSwapChain();
+		createImageViews();
+		// note
+		createRenderPass();
+		createGraphicsPipeline();
+		// note
+		createFramebuffers();
+		createCommandPool();
+		createCommandBuffers();
+		createSyncObjects();
+		createGpuProfiler();
+		createFrameStats();
+		createMeshPool();
+		createMipGenerator();
+		loadMaterialTextures();
+		reportGpuPasses("texture upload");
+		createFrameDrawBuffers();
+		createFrameDescriptorSets();
+		createScene();
+		reportResourceCaches("startup");
+		benchmarkProfiler();
+	}
+
+	void mainLoop() {
+		while (!glfwWindowShouldClose(window)) {
+			PROFILE_SCOPE("frame");
+			{
+				PROFILE_SCOPE("glfwPollEvents");
+				glfwPollEvents();
+			}
+			drawFrame();
+		}
+
+		vkDeviceWaitIdle(device);
+		// the slots in the order their frames went out, the oldest is the one up next
+		for (uint32_t i = 0; i < GPU_UPLOAD_QUERY_SLOT; i++) {
+			auto slot = (currentFrame + i) % GPU_UPLOAD_QUERY_SLOT;
+			collectGpuPasses(slot);
+			collectFrameStats(slot);
+		}
+		reportGpuPasses(std::to_string(frameCount) + " frames");
+		reportFrameStats(std::to_string(frameCount) + " frames");
+		dumpFrameStats(FRAME_STATS_PATH);
+	}
+
+	void cleanup() {
+		PROFILE_FUNCTION();
+
+		// note
+		for (size_t i = 0; i < instanceBuffers.size(); i++) {
+			vkDestroyBuffer(device, instanceBuffers[i], nullptr);
+			vkFreeMemory(device, instanceMemories[i], nullptr);
+		}
+		// every view and sampler, the swap chain's and the textures' among them
+		imageViewCache.evict([](const ImageViewKey&) { return true; }, [&](VkImageView view) {
+			vkDestroyImageView(device, view, nullptr);
+		});
+		samplerCache.evict([](const SamplerKey&) { return true; }, [&](VkSampler sampler) {
+			vkDestroySampler(device, sampler, nullptr);
+		});
+		for (size_t i = 0; i < textureImages.size(); i++) {
+			vkDestroyImage(device, textureImages[i], nullptr);
+			vkFreeMemory(device, textureMemories[i], nullptr);
+		}
+		if (mipPipeline) {
+			vkDestroyPipeline(device, mipPipeline, nullptr);
+			vkDestroyPipelineLayout(device, mipPipelineLayout, nullptr);
+			vkDestroyDescriptorPool(device, mipDescriptorPool, nullptr);
+			vkDestroyDescriptorSetLayout(device, mipSetLayout, nullptr);
+			vkDestroyShaderModule(device, mipShaderModule, nullptr);
+			vkDestroyBuffer(device, mipCounterBuffer, nullptr);
+			vkFreeMemory(device, mipCounterMemory, nullptr);
+		}
+		for (auto& slot : gpuQuerySlots) {
+			vkDestroyQueryPool(device, slot.pool, nullptr);
+		}
+		for (auto pool : statisticsPools) {
+			vkDestroyQueryPool(device, pool, nullptr);
+		}
+		if (meshPoolVertexBuffer) {
+			vkDestroyBuffer(device, meshPoolVertexBuffer, nullptr);
+			vkFreeMemory(device, meshPoolVertexMemory, nullptr);
+			vkDestroyBuffer(device, meshPoolIndexBuffer, nullptr);
+			vkFreeMemory(device, meshPoolIndexMemory, nullptr);
+		}
+		if (vkDestroyDescriptorPool) {
+			vkDestroyDescriptorPool(device, frameDescriptorPool, nullptr);
+		}
+		for (auto semaphore : imageAvailableSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto semaphore : renderFinishedSemaphores) {
+			vkDestroySemaphore(device, semaphore, nullptr);
+		}
+		for (auto fence : inFlightFences) {
+			vkDestroyFence(device, fence, nullptr);
+		}
+		if (vkDestroyCommandPool) {
+			vkDestroyCommandPool(device, commandPool, nullptr);
+		}
+		for (auto framebuffer : swapChainFramebuffers) {
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+		}
+
+		// note
+		if (vkDestroyPipeline) {
+			vkDestroyPipeline(device, graphicsPipeline, nullptr);
+		}
+
+		if (vkDestroyPipelineLayout) {
+			vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+		}
+		if (vkDestroyDescriptorSetLayout) {
+			vkDestroyDescriptorSetLayout(device, frameSetLayout, nullptr);
+		}
+
+		// note
+		if (vkDestroyRenderPass) {
+			vkDestroyRenderPass(device, renderPass, nullptr);
+		}
+
+		if (vkDestroyShaderModule) {
+			vkDestroyShaderModule(device, vertShaderModule, nullptr);
+			vkDestroyShaderModule(device, fragShaderModule, nullptr);
+		}
+
+		vkDestroySwapchainKHR(device, swapChain, nullptr);
+		if (vkDestroyDevice) {
+			vkDestroyDevice(device, nullptr);
+
+		}
+#ifndef NDEBUG
+		if (vkDestroyDebugUtilsMessengerEXT) {
+			vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+		}
+#endif
+		if (vkDestroyInstance) {
+			vkDestroySurfaceKHR(instance, surface, nullptr);
+			vkDestroyInstance(instance, nullptr);
+		}
+		glfwDestroyWindow(window);
+
+		glfwTerminate();
+	}
+
+	void initInstance() {
+		PROFILE_FUNCTION();
+		vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)glfwGetInstanceProcAddress(nullptr, "vkGetInstanceProcAddr");
+		auto vkEnumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+		auto vkEnumerateInstanceExtensionProperties = (PFN_vkEnumerateInstanceExtensionProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceExtensionProperties");
+		auto vkEnumerateInstanceLayerProperties = (PFN_vkEnumerateInstanceLayerProperties)vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceLayerProperties");
+		auto vkCreateInstance = (PFN_vkCreateInstance)vkGetInstanceProcAddr(nullptr, "vkCreateInstance");
+
+		uint32_t supportedVersion = 0u;
+		VkResult result = vkEnumerateInstanceVersion(&supportedVersion);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Version: " << VK_VERSION_MAJOR(supportedVersion) << "." << VK_VERSION_MINOR(supportedVersion) << "." << VK_VERSION_PATCH(supportedVersion) << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to enumerate instance version");
+		}
+
+		auto requestInstanceVersion = 0u;
+		if (supportedVersion >= VK_API_VERSION_1_3) {
+			requestInstanceVersion = VK_API_VERSION_1_3;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_2) {
+			requestInstanceVersion = VK_API_VERSION_1_2;
+		}
+		else if (supportedVersion >= VK_API_VERSION_1_1) {
+			requestInstanceVersion = VK_API_VERSION_1_1;
+		}
+		else {
+			requestInstanceVersion = VK_API_VERSION_1_0;
+		}
+
+		VkApplicationInfo  appInfo = {};
+		appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+		appInfo.pApplicationName = "Hello Triangle";
+		appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.pEngineName = "No Engine";
+		appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+		appInfo.apiVersion = requestInstanceVersion;
+		appInfo.pNext = nullptr;
+
+		uint32_t        extensionCount = 0;
+		auto ppExtensioNames = glfwGetRequiredInstanceExtensions(&extensionCount);
+
+		std::vector<const char*> requestedInstanceExtensions = std::vector<const char*>(ppExtensioNames, ppExtensioNames + extensionCount);
+#ifndef NDEBUG
+		requestedInstanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+#endif
+		std::vector<const char*> requestedInstanceLayers = {
+			//	"VK_LAYER_LUNARG_api_dump"
+		};
+#ifndef NDEBUG
+		requestedInstanceLayers.push_back("VK_LAYER_KHRONOS_validation");
+#endif		
+
+		std::vector<const char*> enabledInstanceExtensions;
+		std::vector<const char*> enabledInstanceLayers;
+
+		auto instanceExtensionPropCount = 0u;
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(instanceExtensionPropCount);
+		result = vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionPropCount, extensionProps.data());
+
+		auto instanceLayerPropCount = 0u;
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, nullptr);
+		std::vector<VkLayerProperties> layerProps(instanceLayerPropCount);
+		result = vkEnumerateInstanceLayerProperties(&instanceLayerPropCount, layerProps.data());
+
+		for (auto& requestedInstanceExtension : requestedInstanceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedInstanceExtension)) {
+				throw std::runtime_error("failed to find instance extension: " + std::string(requestedInstanceExtension));
+			}
+		}
+		for (auto& requestedInstanceLayer : requestedInstanceLayers) {
+			if (!findLayerProperties(layerProps, requestedInstanceLayer)) {
+				throw std::runtime_error("failed to find instance layer: " + std::string(requestedInstanceLayer));
+			}
+		}
+
+		enabledInstanceExtensions = requestedInstanceExtensions;
+		enabledInstanceLayers = requestedInstanceLayers;
+
+		VkInstanceCreateInfo createInfo = {};
+		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+		createInfo.pApplicationInfo = &appInfo;
+		createInfo.enabledExtensionCount = enabledInstanceExtensions.size();
+		createInfo.ppEnabledExtensionNames = enabledInstanceExtensions.data();
+		createInfo.enabledLayerCount = enabledInstanceLayers.size();
+		createInfo.ppEnabledLayerNames = enabledInstanceLayers.data();
+
+		result = vkCreateInstance(&createInfo, nullptr, &instance);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Instance created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create instance");
+		}
+		vkDestroyInstance = (PFN_vkDestroyInstance)vkGetInstanceProcAddr(instance, "vkDestroyInstance");
+
+#ifndef NDEBUG
+		auto vkCreateDebugUtilsMessengerEXT = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
+		VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo = {};
+		debugCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+		debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+		debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+		debugCreateInfo.pfnUserCallback = debugCallback;
+		result = vkCreateDebugUtilsMessengerEXT(instance, &debugCreateInfo, nullptr, &debugMessenger);
+		if (result == VK_SUCCESS) {
+			std::cout << "Debug Messenger created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create debug messenger");
+		}
+		vkDestroyDebugUtilsMessengerEXT = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+#endif
+	}
+
+	void createSurface()
+	{
+		PROFILE_FUNCTION();
+		vkDestroySurfaceKHR = (PFN_vkDestroySurfaceKHR)vkGetInstanceProcAddr(instance, "vkDestroySurfaceKHR");
+		if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create window surface!");
+		}
+	}
+
+	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails details;
+		auto vkGetPhysicalDeviceSurfaceCapabilitiesKHR = (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"); // notice that instance, not device
+		auto vkGetPhysicalDeviceSurfaceFormatsKHR = (PFN_vkGetPhysicalDeviceSurfaceFormatsKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+		auto vkGetPhysicalDeviceSurfacePresentModesKHR = (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
+
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physDev, surface, &details.capabilities);
+
+		uint32_t formatCount = 0;
+		vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, nullptr);
+		if (formatCount != 0) {
+			details.formats.resize(formatCount);
+			vkGetPhysicalDeviceSurfaceFormatsKHR(physDev, surface, &formatCount, details.formats.data());
+		}
+
+		uint32_t presentModeCount = 0;
+		vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, nullptr);
+		if (presentModeCount != 0) {
+			details.presentModes.resize(presentModeCount);
+			vkGetPhysicalDeviceSurfacePresentModesKHR(physDev, surface, &presentModeCount, details.presentModes.data());
+		}
+
+		return details;
+	}
+
+	bool isDeviceSuitable(VkPhysicalDevice physDev)
+	{
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physDev);
+		if (!swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty()) {
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	void selectPhysicalDevice() {
+		PROFILE_FUNCTION();
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		auto physicalDeviceCount = 0u;
+		auto result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, nullptr);
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+		std::vector<VkPhysicalDevice> physicalDevices(physicalDeviceCount);
+		result = vkEnumeratePhysicalDevices(instance, &physicalDeviceCount, physicalDevices.data());
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("failed to enumerate physical devices");
+		}
+
+		for (auto& physDev : physicalDevices) {
+			VkPhysicalDeviceProperties physicalDeviceProperties;
+			vkGetPhysicalDeviceProperties(physDev, &physicalDeviceProperties);
+			std::cout << "Physical Device: " << physicalDeviceProperties.deviceName << std::endl;
+			std::cout << "API Version: " << VK_VERSION_MAJOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_MINOR(physicalDeviceProperties.apiVersion) << "." << VK_VERSION_PATCH(physicalDeviceProperties.apiVersion) << std::endl;
+			std::cout << "Driver Version: " << physicalDeviceProperties.driverVersion << std::endl;
+			std::cout << "Vendor ID: " << physicalDeviceProperties.vendorID << std::endl;
+			std::cout << "Device ID: " << physicalDeviceProperties.deviceID << std::endl;
+			VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+			vkGetPhysicalDeviceFeatures(physDev, &physicalDeviceFeatures);
+			std::cout << "GeometryShader    : " << physicalDeviceFeatures.geometryShader << std::endl;
+			std::cout << "TessellationShader: " << physicalDeviceFeatures.tessellationShader << std::endl;
+			std::uint32_t extensionCount;
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, nullptr);
+			std::vector<VkExtensionProperties> extensionProps(extensionCount);
+			vkEnumerateDeviceExtensionProperties(physDev, nullptr, &extensionCount, extensionProps.data());
+			std::cout << "ExtensionCount: " << extensionProps.size() << std::endl;
+			size_t index = 0;
+			for (auto& extensionProp : extensionProps) {
+				std::cout << "Extensions[" << index << "]: " << extensionProp.extensionName << std::endl;
+				index++;
+			}
+			if (vkGetPhysicalDeviceFeatures2) {
+				// Query Vulkan Features
+				VkPhysicalDeviceFeatures2        physicalDeviceFeatures2 = {};
+				VkPhysicalDeviceVulkan11Features physicalDeviceVulkan11Features = {};
+				VkPhysicalDeviceVulkan12Features physicalDeviceVulkan12Features = {};
+				VkPhysicalDeviceVulkan13Features physicalDeviceVulkan13Features = {};
+				physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+				physicalDeviceVulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+				physicalDeviceVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				physicalDeviceVulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+				physicalDeviceFeatures2.pNext = &physicalDeviceVulkan11Features;
+				physicalDeviceVulkan11Features.pNext = &physicalDeviceVulkan12Features;
+				physicalDeviceVulkan12Features.pNext = &physicalDeviceVulkan13Features;
+				physicalDeviceVulkan13Features.pNext = nullptr;
+				vkGetPhysicalDeviceFeatures2(physDev, &physicalDeviceFeatures2);
+				std::cout << "BufferDeviceAddress: " << physicalDeviceVulkan12Features.bufferDeviceAddress << std::endl;
+				std::cout << "DynamicRendering   : " << physicalDeviceVulkan13Features.dynamicRendering << std::endl;
+			}
+			auto queueFamilyCount = 0u;
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+			std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+			vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilyProps.data());
+			std::cout << "QueueFamilyCount: " << queueFamilyProps.size() << std::endl;
+			for (auto& queueFamilyProp : queueFamilyProps) {
+				std::cout << "QueueFlags: ";
+				if (queueFamilyProp.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+					std::cout << "GRAPHICS |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_COMPUTE_BIT) {
+					std::cout << "COMPUTE |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_TRANSFER_BIT) {
+					std::cout << "TRANSFER |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) {
+					std::cout << "SPARSE_BINDING |";
+				}
+				if (queueFamilyProp.queueFlags & VK_QUEUE_PROTECTED_BIT) {
+					std::cout << "PROTECTED |";
+				}
+				std::cout << std::endl;
+				std::cout << "QueueCount: " << queueFamilyProp.queueCount << std::endl;
+				std::cout << "TimestampValidBits: " << queueFamilyProp.timestampValidBits << std::endl;
+			}
+		}
+
+		if (physicalDevices.size() > 0 && isDeviceSuitable(physicalDevices[0])) {
+			physicalDevice = physicalDevices[0];
+		}
+		else {
+			throw std::runtime_error("failed to find a physical device with Vulkan support");
+		}
+
+
+	}
+
+	QueueFamilyIndices findQueueFamilies(VkPhysicalDevice physDev)
+	{
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+
+		QueueFamilyIndices indices;
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, nullptr);
+
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physDev, &queueFamilyCount, queueFamilies.data());
+
+		int i = 0;
+		for (const auto& queueFamily : queueFamilies) {
+			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+				indices.graphicsFamily = i;
+			}
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physDev, i, surface, &presentSupport);
+
+			if (presentSupport) {
+				indices.presentFamily = i;
+			}
+
+			if (indices.isComplete()) {
+				break;
+			}
+			i++;
+		}
+
+		return indices;
+	}
+
+	void initDevice() {
+		PROFILE_FUNCTION();
+		auto vkEnumeratePhysicalDevices = (PFN_vkEnumeratePhysicalDevices)vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices");
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2");
+		auto vkEnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties");
+		auto vkGetPhysicalDeviceSurfaceSupportKHR = (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+
+		std::uint32_t extensionCount;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> extensionProps(extensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, extensionProps.data());
+
+		std::vector<const char*> requestedDeviceExtensions = std::vector<const char*>{
+			VK_KHR_SWAPCHAIN_EXTENSION_NAME
+		};
+		std::vector<const char*> enabledDeviceExtensions;
+		for (auto& requestedDeviceExtension : requestedDeviceExtensions) {
+			if (!findExtensionProperties(extensionProps, requestedDeviceExtension)) {
+				throw std::runtime_error("failed to find device extension: " + std::string(requestedDeviceExtension));
+			}
+		}
+
+		// note
+		// vkCmdWriteTimestamp2 needs synchronization2, core since 1.3 and VK_KHR_synchronization2 before
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+		bool synchronization2Extension = findExtensionProperties(extensionProps, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+		VkPhysicalDeviceSynchronization2Features synchronization2Features{};
+		synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+		if (synchronization2Extension || physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_3) {
+			VkPhysicalDeviceFeatures2 physicalDeviceFeatures2{};
+			physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			physicalDeviceFeatures2.pNext = &synchronization2Features;
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &physicalDeviceFeatures2);
+		}
+		if (synchronization2Features.synchronization2 && synchronization2Extension) {
+			requestedDeviceExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+		}
+		// either calibrated timestamps extension will do, they only differ in the suffix
+		for (auto name : { VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME }) {
+			if (calibratedTimestampsExtension.empty() && findExtensionProperties(extensionProps, name)) {
+				calibratedTimestampsExtension = name;
+				requestedDeviceExtensions.push_back(name);
+			}
+		}
+
+		enabledDeviceExtensions = requestedDeviceExtensions;
+
+		VkDeviceCreateInfo deviceCreateInfo = {};
+		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		deviceCreateInfo.enabledExtensionCount = requestedDeviceExtensions.size();
+		deviceCreateInfo.ppEnabledExtensionNames = requestedDeviceExtensions.data();
+		if (synchronization2Features.synchronization2) {
+			deviceCreateInfo.pNext = &synchronization2Features;
+		}
+
+		VkPhysicalDeviceFeatures  physicalDeviceFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &physicalDeviceFeatures);
+		deviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
+		// note
+		// the material textures are one array indexed by the pushed material index
+		if (!physicalDeviceFeatures.shaderSampledImageArrayDynamicIndexing) {
+			throw std::runtime_error("failed to find support for dynamically indexed sampled image arrays");
+		}
+		// every supported feature is enabled, the block formats among them, so textures can pick whichever is there
+		std::cout << "Texture compression: BC " << physicalDeviceFeatures.textureCompressionBC << ", ETC2 " << physicalDeviceFeatures.textureCompressionETC2
+			<< ", ASTC LDR " << physicalDeviceFeatures.textureCompressionASTC_LDR << std::endl;
+
+		// DrawConstants fit into the guaranteed 128 bytes by construction, the device usually offers more
+		std::cout << "Push constants: " << physicalDeviceProperties.limits.maxPushConstantsSize << " bytes, DrawConstants use "
+			<< DrawPushConstants::end << " bytes" << std::endl;
+
+		auto queueFamilyCount = 0u;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProps.data());
+
+		// note
+		queueFamilyIndices = findQueueFamilies(physicalDevice);
+		std::set<uint32_t> uniqueQueueFamilyIndices = { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value() };
+
+		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+		float queuePriority = 1.0f;
+		for (uint32_t uniqueQueueFamilyindex : uniqueQueueFamilyIndices) {
+			VkDeviceQueueCreateInfo queueCreateInfo = {};
+			queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+			queueCreateInfo.queueFamilyIndex = uniqueQueueFamilyindex;
+			queueCreateInfo.queueCount = 1;
+			queueCreateInfo.pQueuePriorities = &queuePriority;
+			queueCreateInfos.push_back(queueCreateInfo);
+		}
+
+		deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
+		deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+
+		auto vkCreateDevice = (PFN_vkCreateDevice)vkGetInstanceProcAddr(instance, "vkCreateDevice");
+		auto result = vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr, &device);
+		if (result == VK_SUCCESS) {
+			std::cout << "Vulkan Device created successfully" << std::endl;
+		}
+		else {
+			throw std::runtime_error("failed to create device");
+		}
+
+		vkGetDeviceProcAddr = (PFN_vkGetDeviceProcAddr)vkGetInstanceProcAddr(instance, "vkGetDeviceProcAddr");
+		auto vkGetDeviceQueue = (PFN_vkGetDeviceQueue)vkGetDeviceProcAddr(device, "vkGetDeviceQueue");
+		vkDestroyDevice = (PFN_vkDestroyDevice)vkGetDeviceProcAddr(device, "vkDestroyDevice");
+
+		vkGetDeviceQueue(device, queueFamilyIndices.graphicsFamily.value(), 0, &graphicsQueue);
+		vkGetDeviceQueue(device, queueFamilyIndices.presentFamily.value(), 0, &presentQueue);
+		if (synchronization2Features.synchronization2) {
+			vkCmdWriteTimestamp2 = (PFN_vkCmdWriteTimestamp2)vkGetDeviceProcAddr(device, synchronization2Extension ? "vkCmdWriteTimestamp2KHR" : "vkCmdWriteTimestamp2");
+		}
+	}
+
+	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
+	{
+		for (const auto& availableFormat : availableFormats) {
+			if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+				return availableFormat;
+			}
+		}
+
+		return availableFormats[0];
+	}
+
+	VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
+	{
+		for (const auto& availablePresentMode : availablePresentModes) {
+			if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
+				return availablePresentMode;
+			}
+		}
+
+		return VK_PRESENT_MODE_FIFO_KHR;
+	}
+
+	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
+	{
+		if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+			return capabilities.currentExtent;
+		}
+		else {
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+
+			VkExtent2D actualExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+
+			actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+			actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+
+			return actualExtent;
+		}
+	}
+
+	void createSwapChain()
+	{
+		PROFILE_FUNCTION();
+		auto vkCreateSwapchainKHR = (PFN_vkCreateSwapchainKHR)vkGetDeviceProcAddr(device, "vkCreateSwapchainKHR");
+		auto vkGetSwapchainImagesKHR = (PFN_vkGetSwapchainImagesKHR)vkGetDeviceProcAddr(device, "vkGetSwapchainImagesKHR");
+
+		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
+
+		VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
+		VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+		VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
+
+		uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+
+		if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount) {
+			imageCount = swapChainSupport.capabilities.maxImageCount;
+		}
+
+		VkSwapchainCreateInfoKHR createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+		createInfo.surface = surface;
+		createInfo.minImageCount = imageCount;
+		createInfo.imageFormat = surfaceFormat.format;
+		createInfo.imageColorSpace = surfaceFormat.colorSpace;
+		createInfo.imageExtent = extent;
+		createInfo.imageArrayLayers = 1;
+		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+		// note
+		QueueFamilyIndices indices = queueFamilyIndices;
+		uint32_t sharedQueueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+
+		if (indices.graphicsFamily != indices.presentFamily) {
+			createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+			createInfo.queueFamilyIndexCount = 2;
+			createInfo.pQueueFamilyIndices = sharedQueueFamilyIndices;
+		}
+		else {
+			createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			/*createInfo.queueFamilyIndexCount = 0;
+			createInfo.pQueueFamilyIndices = nullptr;*/
+		}
+
+		createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
+		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+		createInfo.presentMode = presentMode;
+		createInfo.clipped = VK_TRUE;
+
+		createInfo.oldSwapchain = VK_NULL_HANDLE;
+
+		if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create swap chain!");
+		}
+
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);
+		swapChainImages.resize(imageCount);
+		vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImages.data());
+
+		swapChainImageFormat = surfaceFormat.format;
+		swapChainExtent = extent;
+
+		vkDestroySwapchainKHR = (PFN_vkDestroySwapchainKHR)vkGetDeviceProcAddr(device, "vkDestroySwapchainKHR");
+	}
+
+	// note
+	// The swap chain's views come out of the view cache like every other view. The cache creates and destroys
+	// views and samplers from here on.
+	void createImageViews()
+	{
+		PROFILE_FUNCTION();
+		vkCreateImageView = (PFN_vkCreateImageView)vkGetDeviceProcAddr(device, "vkCreateImageView");
+		vkCreateSampler = (PFN_vkCreateSampler)vkGetDeviceProcAddr(device, "vkCreateSampler");
+		vkDestroyImageView = (PFN_vkDestroyImageView)vkGetDeviceProcAddr(device, "vkDestroyImageView");
+		vkDestroySampler = (PFN_vkDestroySampler)vkGetDeviceProcAddr(device, "vkDestroySampler");
+
+		swapChainImageViews.resize(swapChainImages.size());
+		for (size_t i = 0; i < swapChainImages.size(); i++) {
+			ImageViewKey key;
+			key.image = swapChainImages[i];
+			key.format = swapChainImageFormat;
+			key.levelCount = 1;
+			swapChainImageViews[i] = acquireImageView(key);
+		}
+	}
+
+	// note
+	void createRenderPass() {
+		PROFILE_FUNCTION();
+		VkAttachmentDescription colorAttachment{};
+		colorAttachment.format = swapChainImageFormat;
+		colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+		colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+		colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+		VkAttachmentReference colorAttachmentRef{};
+		colorAttachmentRef.attachment = 0;
+		colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+		VkSubpassDescription subpass{};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = 1;
+		subpass.pColorAttachments = &colorAttachmentRef;
+
+		// note
+		VkSubpassDependency dependency{};
+		dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependency.dstSubpass = 0;
+		dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependency.srcAccessMask = 0;
+		dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+		VkRenderPassCreateInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassInfo.attachmentCount = 1;
+		renderPassInfo.pAttachments = &colorAttachment;
+		renderPassInfo.subpassCount = 1;
+		renderPassInfo.pSubpasses = &subpass;
+		renderPassInfo.dependencyCount = 1;
+		renderPassInfo.pDependencies = &dependency;
+
+		auto vkCreateRenderPass = (PFN_vkCreateRenderPass)vkGetInstanceProcAddr(instance, "vkCreateRenderPass");
+		if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create render pass");
+		}
+
+		vkDestroyRenderPass = (PFN_vkDestroyRenderPass)vkGetDeviceProcAddr(device, "vkDestroyRenderPass");
+	}
+
+	void createGraphicsPipeline() {
+		PROFILE_FUNCTION();
+		auto vertShaderCode = readFile(SHADER_ROOT_DIR"/shader.vert.spv");
+		auto fragShaderCode = readFile(SHADER_ROOT_DIR"/shader.frag.spv");
+
+		vertShaderModule = createShaderModule(vertShaderCode);
+		fragShaderModule = createShaderModule(fragShaderCode);
+
+		// note
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+		bindings[0].binding = 0;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[0].descriptorCount = 1;
+		bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		bindings[1].binding = 1;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		bindings[1].descriptorCount = MATERIAL_TEXTURE_COUNT;
+		bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+		setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		setLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+		setLayoutInfo.pBindings = bindings.data();
+
+		auto vkCreateDescriptorSetLayout = (PFN_vkCreateDescriptorSetLayout)vkGetDeviceProcAddr(device, "vkCreateDescriptorSetLayout");
+		if (vkCreateDescriptorSetLayout(device, &setLayoutInfo, nullptr, &frameSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create frame descriptor set layout");
+		}
+		vkDestroyDescriptorSetLayout = (PFN_vkDestroyDescriptorSetLayout)vkGetDeviceProcAddr(device, "vkDestroyDescriptorSetLayout");
+
+		// note
+		// the range comes from the block type, so layout and vkCmdPushConstants cannot disagree
+		auto pushConstantRange = DrawPushConstants::range();
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &frameSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+		auto vkCreatePipelineLayout = (PFN_vkCreatePipelineLayout)vkGetInstanceProcAddr(instance, "vkCreatePipelineLayout");
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create pipeline layout");
+		}
+
+		// note
+		VkRect2D scissor{};
+		scissor.offset = { 0, 0 };
+		scissor.extent = swapChainExtent;
+		graphicsPipeline = createMeshPipeline(scissor, pipelineLayout, vertShaderModule, fragShaderModule);
+
+		vkDestroyPipeline = (PFN_vkDestroyPipeline)vkGetDeviceProcAddr(device, "vkDestroyPipeline");
+
+		vkDestroyPipelineLayout = (PFN_vkDestroyPipelineLayout)vkGetDeviceProcAddr(device, "vkDestroyPipelineLayout");
+		vkDestroyShaderModule = (PFN_vkDestroyShaderModule)vkGetDeviceProcAddr(device, "vkDestroyShaderModule");
+	}
+
+	// Everything but the scissor, layout and shaders is shared.
+	VkPipeline createMeshPipeline(VkRect2D scissor, VkPipelineLayout layout, VkShaderModule vertModule, VkShaderModule fragModule) {
+		VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+		vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+		vertShaderStageInfo.module = vertModule;
+		vertShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+		fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fragShaderStageInfo.module = fragModule;
+		fragShaderStageInfo.pName = "main";
+
+		VkPipelineShaderStageCreateInfo shaderStages[] = { vertShaderStageInfo, fragShaderStageInfo };
+
+		// note
+		auto vertexInput = describeVertexInput();
+
+		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexInput.bindings.size());
+		vertexInputInfo.pVertexBindingDescriptions = vertexInput.bindings.data();
+		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInput.attributes.size());
+		vertexInputInfo.pVertexAttributeDescriptions = vertexInput.attributes.data();
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+		VkViewport viewport{};
+		viewport.x = 0.0f;
+		viewport.y = 0.0f;
+		viewport.width = (float)swapChainExtent.width;
+		viewport.height = (float)swapChainExtent.height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkPipelineViewportStateCreateInfo viewportState{};
+		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+		viewportState.viewportCount = 1;
+		viewportState.pViewports = &viewport;
+		viewportState.scissorCount = 1;
+		viewportState.pScissors = &scissor;
+
+		VkPipelineRasterizationStateCreateInfo rasterizer{};
+		rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+		rasterizer.depthClampEnable = VK_FALSE;
+		rasterizer.rasterizerDiscardEnable = VK_FALSE;
+		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.lineWidth = 1.0f;
+		rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+		rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+		rasterizer.depthBiasEnable = VK_FALSE;
+
+		VkPipelineMultisampleStateCreateInfo multisampling{};
+		multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+		multisampling.sampleShadingEnable = VK_FALSE;
+		multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.blendEnable = VK_FALSE;
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD; // Optional
+		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+		colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD; // Optional
+
+		VkPipelineColorBlendStateCreateInfo colorBlending{};
+		colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+		colorBlending.logicOpEnable = VK_FALSE;
+		colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
+		colorBlending.attachmentCount = 1;
+		colorBlending.pAttachments = &colorBlendAttachment;
+		colorBlending.blendConstants[0] = 0.0f; // Optional
+		colorBlending.blendConstants[1] = 0.0f; // Optional
+		colorBlending.blendConstants[2] = 0.0f; // Optional
+		colorBlending.blendConstants[3] = 0.0f; // Optional
+
+		VkGraphicsPipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipelineInfo.stageCount = 2;
+		pipelineInfo.pStages = shaderStages;
+		pipelineInfo.pVertexInputState = &vertexInputInfo;
+		pipelineInfo.pInputAssemblyState = &inputAssembly;
+		pipelineInfo.pViewportState = &viewportState;
+		pipelineInfo.pRasterizationState = &rasterizer;
+		pipelineInfo.pMultisampleState = &multisampling;
+		pipelineInfo.pDepthStencilState = nullptr;
+		pipelineInfo.pColorBlendState = &colorBlending;
+		pipelineInfo.pDynamicState = nullptr;
+		pipelineInfo.layout = layout;
+		pipelineInfo.renderPass = renderPass;
+		pipelineInfo.subpass = 0;
+
+		auto vkCreateGraphicsPipelines = (PFN_vkCreateGraphicsPipelines)vkGetInstanceProcAddr(instance, "vkCreateGraphicsPipelines");
+		VkPipeline pipeline = nullptr;
+		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create graphics pipeline");
+		}
+		return pipeline;
+	}
+
+	// note
+	void createFramebuffers() {
+		PROFILE_FUNCTION();
+		auto vkCreateFramebuffer = (PFN_vkCreateFramebuffer)vkGetDeviceProcAddr(device, "vkCreateFramebuffer");
+
+		swapChainFramebuffers.resize(swapChainImageViews.size());
+		for (size_t i = 0; i < swapChainImageViews.size(); i++) {
+			VkImageView attachments[] = { swapChainImageViews[i] };
+
+			VkFramebufferCreateInfo framebufferInfo{};
+			framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			framebufferInfo.renderPass = renderPass;
+			framebufferInfo.attachmentCount = 1;
+			framebufferInfo.pAttachments = attachments;
+			framebufferInfo.width = swapChainExtent.width;
+			framebufferInfo.height = swapChainExtent.height;
+			framebufferInfo.layers = 1;
+
+			if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &swapChainFramebuffers[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create framebuffer");
+			}
+		}
+
+		vkDestroyFramebuffer = (PFN_vkDestroyFramebuffer)vkGetDeviceProcAddr(device, "vkDestroyFramebuffer");
+	}
+
+	void createCommandPool() {
+		PROFILE_FUNCTION();
+		auto vkCreateCommandPool = (PFN_vkCreateCommandPool)vkGetDeviceProcAddr(device, "vkCreateCommandPool");
+
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+		if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create command pool");
+		}
+
+		vkDestroyCommandPool = (PFN_vkDestroyCommandPool)vkGetDeviceProcAddr(device, "vkDestroyCommandPool");
+	}
+
+	void createCommandBuffers() {
+		PROFILE_FUNCTION();
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+
+		commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+		if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate command buffers");
+		}
+
+		vkBeginCommandBuffer = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(device, "vkBeginCommandBuffer");
+		vkEndCommandBuffer = (PFN_vkEndCommandBuffer)vkGetDeviceProcAddr(device, "vkEndCommandBuffer");
+		vkResetCommandBuffer = (PFN_vkResetCommandBuffer)vkGetDeviceProcAddr(device, "vkResetCommandBuffer");
+		vkCmdBeginRenderPass = (PFN_vkCmdBeginRenderPass)vkGetDeviceProcAddr(device, "vkCmdBeginRenderPass");
+		vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass)vkGetDeviceProcAddr(device, "vkCmdEndRenderPass");
+		vkCmdBindPipeline = (PFN_vkCmdBindPipeline)vkGetDeviceProcAddr(device, "vkCmdBindPipeline");
+		vkCmdBindVertexBuffers = (PFN_vkCmdBindVertexBuffers)vkGetDeviceProcAddr(device, "vkCmdBindVertexBuffers");
+		vkCmdBindIndexBuffer = (PFN_vkCmdBindIndexBuffer)vkGetDeviceProcAddr(device, "vkCmdBindIndexBuffer");
+		vkCmdDrawIndexed = (PFN_vkCmdDrawIndexed)vkGetDeviceProcAddr(device, "vkCmdDrawIndexed");
+		vkCmdCopyBuffer = (PFN_vkCmdCopyBuffer)vkGetDeviceProcAddr(device, "vkCmdCopyBuffer");
+		vkCmdPushConstants = (PFN_vkCmdPushConstants)vkGetDeviceProcAddr(device, "vkCmdPushConstants");
+		vkCmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets)vkGetDeviceProcAddr(device, "vkCmdBindDescriptorSets");
+	}
+
+	void createSyncObjects() {
+		PROFILE_FUNCTION();
+		auto vkCreateSemaphore = (PFN_vkCreateSemaphore)vkGetDeviceProcAddr(device, "vkCreateSemaphore");
+		auto vkCreateFence = (PFN_vkCreateFence)vkGetDeviceProcAddr(device, "vkCreateFence");
+
+		imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+		inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+		// presentation may hold on to the semaphore until the image is reacquired, so one per image
+		renderFinishedSemaphores.resize(swapChainImages.size());
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
+				vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a frame");
+			}
+		}
+		for (size_t i = 0; i < renderFinishedSemaphores.size(); i++) {
+			if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create synchronization objects for a swap chain image");
+			}
+		}
+
+		vkDestroySemaphore = (PFN_vkDestroySemaphore)vkGetDeviceProcAddr(device, "vkDestroySemaphore");
+		vkDestroyFence = (PFN_vkDestroyFence)vkGetDeviceProcAddr(device, "vkDestroyFence");
+		vkWaitForFences = (PFN_vkWaitForFences)vkGetDeviceProcAddr(device, "vkWaitForFences");
+		vkResetFences = (PFN_vkResetFences)vkGetDeviceProcAddr(device, "vkResetFences");
+		vkAcquireNextImageKHR = (PFN_vkAcquireNextImageKHR)vkGetDeviceProcAddr(device, "vkAcquireNextImageKHR");
+		vkQueueSubmit = (PFN_vkQueueSubmit)vkGetDeviceProcAddr(device, "vkQueueSubmit");
+		vkQueuePresentKHR = (PFN_vkQueuePresentKHR)vkGetDeviceProcAddr(device, "vkQueuePresentKHR");
+		vkDeviceWaitIdle = (PFN_vkDeviceWaitIdle)vkGetDeviceProcAddr(device, "vkDeviceWaitIdle");
+	}
+
+	uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+		auto vkGetPhysicalDeviceMemoryProperties = (PFN_vkGetPhysicalDeviceMemoryProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties");
+
+		VkPhysicalDeviceMemoryProperties memProperties;
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+			if ((typeFilter & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+
+		throw std::runtime_error("failed to find suitable memory type");
+	}
+
+	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+		auto vkCreateBuffer = (PFN_vkCreateBuffer)vkGetDeviceProcAddr(device, "vkCreateBuffer");
+		auto vkGetBufferMemoryRequirements = (PFN_vkGetBufferMemoryRequirements)vkGetDeviceProcAddr(device, "vkGetBufferMemoryRequirements");
+		auto vkAllocateMemory = (PFN_vkAllocateMemory)vkGetDeviceProcAddr(device, "vkAllocateMemory");
+		auto vkBindBufferMemory = (PFN_vkBindBufferMemory)vkGetDeviceProcAddr(device, "vkBindBufferMemory");
+
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create buffer");
+		}
+
+		VkMemoryRequirements memRequirements;
+		vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize = memRequirements.size;
+		allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+		if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate buffer memory");
+		}
+
+		vkBindBufferMemory(device, buffer, bufferMemory, 0);
+
+		vkDestroyBuffer = (PFN_vkDestroyBuffer)vkGetDeviceProcAddr(device, "vkDestroyBuffer");
+		vkFreeMemory = (PFN_vkFreeMemory)vkGetDeviceProcAddr(device, "vkFreeMemory");
+	}
+
+	// note
+	// One-off upload: fill writes straight into the mapped staging buffer, the copy into device local memory
+	// runs on the graphics queue and is waited for before returning.
+	void createDeviceLocalBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const std::function<void(char*)>& fill, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+		auto vkUnmapMemory = (PFN_vkUnmapMemory)vkGetDeviceProcAddr(device, "vkUnmapMemory");
+
+		VkBuffer stagingBuffer = nullptr;
+		VkDeviceMemory stagingMemory = nullptr;
+		createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+		void* mapped = nullptr;
+		vkMapMemory(device, stagingMemory, 0, size, 0, &mapped);
+		fill(static_cast<char*>(mapped));
+		vkUnmapMemory(device, stagingMemory);
+
+		createBuffer(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, bufferMemory);
+		copyBuffer(stagingBuffer, buffer, size);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingMemory, nullptr);
+	}
+
+	void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+		auto vkFreeCommandBuffers = (PFN_vkFreeCommandBuffers)vkGetDeviceProcAddr(device, "vkFreeCommandBuffers");
+		auto vkQueueWaitIdle = (PFN_vkQueueWaitIdle)vkGetDeviceProcAddr(device, "vkQueueWaitIdle");
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = commandPool;
+		allocInfo.commandBufferCount = 1;
+		VkCommandBuffer commandBuffer = nullptr;
+		if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate copy command buffer");
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+		VkBufferCopy copyRegion{};
+		copyRegion.size = size;
+		vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit copy command buffer");
+		}
+		vkQueueWaitIdle(graphicsQueue);
+
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	}
+
+	// note
+	// Every level of detail of the sphere goes into one vertex and one index buffer, so a single bind serves all
+	// meshes and each draw selects its own through firstIndex and vertexOffset.
+	void createMeshPool() {
+		PROFILE_FUNCTION();
+		std::vector<MeshData> lods;
+		for (uint32_t lod = 0; lod < MESH_POOL_LODS; lod++) {
+			uint32_t rings = 8 << lod;
+			lods.push_back(generateSphere({ 0.0f, 0.0f }, 1.0f, rings, rings * 2));
+		}
+
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;
+		for (auto& lod : lods) {
+			MeshRange range;
+			range.firstIndex = indexCount;
+			range.indexCount = static_cast<uint32_t>(lod.indices.size());
+			range.vertexOffset = static_cast<int32_t>(vertexCount);
+			meshRanges.push_back(range);
+			vertexCount += static_cast<uint32_t>(lod.positions.size());
+			indexCount += range.indexCount;
+		}
+
+		createDeviceLocalBuffer(sizeof(MeshVertex) * vertexCount, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, [&](char* dst) {
+			auto vertices = reinterpret_cast<MeshVertex*>(dst);
+			for (auto& lod : lods) {
+				for (size_t i = 0; i < lod.positions.size(); i++) {
+					*vertices++ = { lod.positions[i], lod.normals[i], lod.texCoords[i] };
+				}
+			}
+		}, meshPoolVertexBuffer, meshPoolVertexMemory);
+		createDeviceLocalBuffer(sizeof(uint32_t) * indexCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, [&](char* dst) {
+			for (auto& lod : lods) {
+				memcpy(dst, lod.indices.data(), lod.indices.size() * sizeof(uint32_t));
+				dst += lod.indices.size() * sizeof(uint32_t);
+			}
+		}, meshPoolIndexBuffer, meshPoolIndexMemory);
+	}
+
+	// note
+	// The image format a KTX2 source format is uploaded as. RGBA8 goes to the first block format the device samples
+	// with linear filtering, BC1 before ETC2 since desktop GPUs rarely have ETC2, and stays RGBA8 without either or
+	// without blockCompression. Anything else is uploaded as it is and has to be sampleable in its own format.
+	VkFormat chooseTextureFormat(VkFormat sourceFormat, bool blockCompression, TextureEncoding& encoding) {
+		auto vkGetPhysicalDeviceFormatProperties = (PFN_vkGetPhysicalDeviceFormatProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFormatProperties");
+
+		auto sampleable = [&](VkFormat format) {
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+			VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+			return (formatProperties.optimalTilingFeatures & required) == required;
+		};
+
+		encoding = TextureEncoding::Copy;
+		if (blockCompression && (sourceFormat == VK_FORMAT_R8G8B8A8_UNORM || sourceFormat == VK_FORMAT_R8G8B8A8_SRGB)) {
+			bool srgb = sourceFormat == VK_FORMAT_R8G8B8A8_SRGB;
+			std::array<std::pair<TextureEncoding, VkFormat>, 2> candidates = { {
+				{ TextureEncoding::Bc1, srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK },
+				{ TextureEncoding::Etc2, srgb ? VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK }
+			} };
+			for (auto& [candidateEncoding, format] : candidates) {
+				if (sampleable(format)) {
+					encoding = candidateEncoding;
+					return format;
+				}
+			}
+		}
+		if (!sampleable(sourceFormat)) {
+			throw std::runtime_error("failed to find sampling support for texture format " + std::to_string(sourceFormat));
+		}
+		return sourceFormat;
+	}
+
+	// Test input for machines without texture assets: RGBA8 KTX2 files, a checkerboard in a different hue each. Even
+	// ones carry a full mip chain the way a texture tool writes them before any block compression, odd ones only
+	// level 0 and a level count of 0, which leaves the chain to the loader.
+	static std::string writeSyntheticKtx2(uint32_t index) {
+		auto path = (std::filesystem::temp_directory_path() / ("vulkan-tutorial-texture-" + std::to_string(index) + ".ktx2")).string();
+		float hue = float(index) / SYNTHETIC_TEXTURE_COUNT;
+		glm::vec3 color = glm::clamp(glm::abs(glm::fract(glm::vec3(hue) + glm::vec3(1.0f, 2.0f / 3.0f, 1.0f / 3.0f)) * 6.0f - 3.0f) - 1.0f, 0.0f, 1.0f);
+		std::vector<std::vector<uint32_t>> levels = { generateCheckerTexture(SYNTHETIC_TEXTURE_SIZE, 4 << index, color) };
+		bool storedMips = index % 2 == 0;
+		for (uint32_t size = SYNTHETIC_TEXTURE_SIZE; storedMips && size > 1; size /= 2) {
+			levels.push_back(downsampleRgba8(levels.back(), size, size));
+		}
+		auto levelCount = static_cast<uint32_t>(levels.size());
+
+		// the data format descriptor spells out RGBA8 UNORM: one basic block, four 8 bit samples with alpha as channel 15
+		std::vector<uint32_t> dfd = { 0, 0, 0, 1 | 1 << 8 | 1 << 16, 0, 4, 0 };
+		for (uint32_t c = 0; c < 4; c++) {
+			dfd.insert(dfd.end(), { c * 8 | 7 << 16 | (c == 3 ? 15u : c) << 24, 0, 0, 255 });
+		}
+		auto dfdSize = static_cast<uint32_t>(dfd.size() * sizeof(uint32_t));
+		dfd[0] = dfdSize;
+		dfd[2] = 2 | (dfdSize - 4) << 16;
+
+		std::vector<char> header(KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE * levelCount);
+		auto put32 = [&](size_t offset, uint32_t value) { memcpy(header.data() + offset, &value, sizeof(value)); };
+		auto put64 = [&](size_t offset, uint64_t value) { memcpy(header.data() + offset, &value, sizeof(value)); };
+		memcpy(header.data(), KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size());
+		put32(12, VK_FORMAT_R8G8B8A8_UNORM);
+		put32(16, 1);
+		put32(20, SYNTHETIC_TEXTURE_SIZE);
+		put32(24, SYNTHETIC_TEXTURE_SIZE);
+		put32(36, 1);
+		put32(40, storedMips ? levelCount : 0);
+		put32(48, static_cast<uint32_t>(header.size()));
+		put32(52, dfdSize);
+		// levels are stored smallest first, every size is a multiple of 4 so no padding is needed
+		uint64_t offset = header.size() + dfdSize;
+		for (uint32_t level = levelCount; level-- > 0;) {
+			uint64_t length = levels[level].size() * sizeof(uint32_t);
+			put64(KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE * level, offset);
+			put64(KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE * level + 8, length);
+			put64(KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE * level + 16, length);
+			offset += length;
+		}
+
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to write " + path);
+		}
+		file.write(header.data(), header.size());
+		file.write(reinterpret_cast<const char*>(dfd.data()), dfdSize);
+		for (uint32_t level = levelCount; level-- > 0;) {
+			file.write(reinterpret_cast<const char*>(levels[level].data()), levels[level].size() * sizeof(uint32_t));
+		}
+		return path;
+	}
+
+	// Maps and parses every file, the plans point into the mappings, which have to outlive them.
+	std::vector<TextureUploadPlan> planTextureUploads(std::vector<std::unique_ptr<MappedFile>>& files) {
+		std::vector<TextureUploadPlan> plans;
+		for (auto& path : texturePaths) {
+			files.push_back(std::make_unique<MappedFile>(path));
+			Ktx2Texture texture;
+			try {
+				texture = parseKtx2(*files.back());
+			}
+			catch (const std::exception& e) {
+				throw std::runtime_error("failed to load " + path + ": " + e.what());
+			}
+			// generated levels are written by the GPU, which can't write block compressed formats
+			TextureUploadPlan plan;
+			plan.format = chooseTextureFormat(texture.format, !texture.generateMips, plan.encoding);
+			plan.width = texture.width;
+			plan.height = texture.height;
+			plan.generateMips = texture.generateMips;
+			plan.mipLevels = texture.generateMips ? mipLevelCount(texture.width, texture.height) : static_cast<uint32_t>(texture.levels.size());
+			for (auto& level : texture.levels) {
+				TextureUploadLevel uploadLevel;
+				uploadLevel.source = level.data;
+				uploadLevel.sourceSize = level.size;
+				uploadLevel.width = level.width;
+				uploadLevel.height = level.height;
+				plan.levels.push_back(uploadLevel);
+			}
+			plans.push_back(plan);
+		}
+		return plans;
+	}
+
+	// note
+	// KTX2 files are read in place from their mappings, the worker pool transcodes every level straight into one
+	// mapped staging buffer and one command buffer copies all levels of all textures into their images. Files that
+	// leave the chain to the loader get level 0 copied and the rest generated in the same command buffer.
+	void loadMaterialTextures() {
+		PROFILE_FUNCTION();
+		auto vkCreateImage = (PFN_vkCreateImage)vkGetDeviceProcAddr(device, "vkCreateImage");
+		auto vkGetImageMemoryRequirements = (PFN_vkGetImageMemoryRequirements)vkGetDeviceProcAddr(device, "vkGetImageMemoryRequirements");
+		auto vkAllocateMemory = (PFN_vkAllocateMemory)vkGetDeviceProcAddr(device, "vkAllocateMemory");
+		auto vkBindImageMemory = (PFN_vkBindImageMemory)vkGetDeviceProcAddr(device, "vkBindImageMemory");
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+		auto vkUnmapMemory = (PFN_vkUnmapMemory)vkGetDeviceProcAddr(device, "vkUnmapMemory");
+		auto vkAllocateCommandBuffers = (PFN_vkAllocateCommandBuffers)vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers");
+		auto vkFreeCommandBuffers = (PFN_vkFreeCommandBuffers)vkGetDeviceProcAddr(device, "vkFreeCommandBuffers");
+		auto vkQueueWaitIdle = (PFN_vkQueueWaitIdle)vkGetDeviceProcAddr(device, "vkQueueWaitIdle");
+		auto vkCmdCopyBufferToImage = (PFN_vkCmdCopyBufferToImage)vkGetDeviceProcAddr(device, "vkCmdCopyBufferToImage");
+
+		bool syntheticTextures = texturePaths.empty();
+		if (syntheticTextures) {
+			for (uint32_t i = 0; i < SYNTHETIC_TEXTURE_COUNT; i++) {
+				texturePaths.push_back(writeSyntheticKtx2(i));
+			}
+		}
+		std::vector<std::unique_ptr<MappedFile>> files;
+		auto plans = planTextureUploads(files);
+		std::vector<TranscodeTask> tasks;
+		auto stagingSize = planTranscode(plans, 0, tasks);
+
+		VkBuffer stagingBuffer = nullptr;
+		VkDeviceMemory stagingMemory = nullptr;
+		createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+		void* mapped = nullptr;
+		vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, &mapped);
+		WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()));
+		auto start = std::chrono::steady_clock::now();
+		pool.parallelFor(static_cast<uint32_t>(tasks.size()), [&](uint32_t task) {
+			PROFILE_SCOPE("runTranscodeTask");
+			runTranscodeTask(plans, tasks[task], static_cast<uint8_t*>(mapped));
+		});
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		vkUnmapMemory(device, stagingMemory);
+
+		size_t sourceBytes = 0;
+		for (size_t i = 0; i < plans.size(); i++) {
+			VkDeviceSize gpuBytes = 0;
+			for (auto& level : plans[i].levels) {
+				sourceBytes += level.sourceSize;
+				gpuBytes += level.size;
+			}
+			std::cout << "Texture " << texturePaths[i] << ": " << plans[i].width << "x" << plans[i].height << ", " << plans[i].mipLevels
+				<< (plans[i].generateMips ? " levels generated on the GPU, " : " levels, ") << textureEncodingName(plans[i].encoding) << " to format " << plans[i].format << ", " << gpuBytes / 1e6 << " MB" << std::endl;
+		}
+		std::cout << "Textures transcoded with " << pool.threadCount() << " threads in " << seconds * 1e3 << " ms, "
+			<< sourceBytes / 1e6 << " MB read, " << stagingSize / 1e6 << " MB uploaded" << std::endl;
+
+		textureImages.resize(plans.size());
+		textureMemories.resize(plans.size());
+		textureViews.resize(plans.size());
+		std::vector<MipChainImage> mipChains;
+		for (size_t i = 0; i < plans.size(); i++) {
+			MipChainImage chain;
+			VkImageCreateInfo imageInfo{};
+			imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageInfo.format = plans[i].format;
+			imageInfo.extent = { plans[i].width, plans[i].height, 1 };
+			imageInfo.mipLevels = plans[i].mipLevels;
+			imageInfo.arrayLayers = 1;
+			imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+			imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			if (plans[i].generateMips) {
+				chain.path = chooseMipGenerationPath(plans[i].format, plans[i].width, plans[i].height);
+				imageInfo.usage |= chain.path == MipGenerationPath::Compute ? VK_IMAGE_USAGE_STORAGE_BIT : VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+			}
+			if (vkCreateImage(device, &imageInfo, nullptr, &textureImages[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create texture image");
+			}
+
+			VkMemoryRequirements memoryRequirements;
+			vkGetImageMemoryRequirements(device, textureImages[i], &memoryRequirements);
+			VkMemoryAllocateInfo allocInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			allocInfo.allocationSize = memoryRequirements.size;
+			allocInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			if (vkAllocateMemory(device, &allocInfo, nullptr, &textureMemories[i]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to allocate texture image memory");
+			}
+			vkBindImageMemory(device, textureImages[i], textureMemories[i], 0);
+
+			if (plans[i].generateMips) {
+				chain.image = textureImages[i];
+				chain.format = plans[i].format;
+				chain.width = plans[i].width;
+				chain.height = plans[i].height;
+				chain.levelCount = plans[i].mipLevels;
+				prepareMipChain(chain);
+				mipChains.push_back(chain);
+			}
+		}
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = commandPool;
+		allocInfo.commandBufferCount = 1;
+		VkCommandBuffer commandBuffer = nullptr;
+		if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate texture upload command buffer");
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+		std::vector<VkImageMemoryBarrier> barriers(plans.size());
+		for (size_t i = 0; i < plans.size(); i++) {
+			auto& barrier = barriers[i];
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = textureImages[i];
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1 };
+		}
+		resetGpuQueries(commandBuffer, GPU_UPLOAD_QUERY_SLOT);
+		auto uploadPass = beginGpuPass(commandBuffer, GPU_UPLOAD_QUERY_SLOT, "texture upload");
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+			static_cast<uint32_t>(barriers.size()), barriers.data());
+		for (size_t i = 0; i < plans.size(); i++) {
+			std::vector<VkBufferImageCopy> regions;
+			for (uint32_t level = 0; level < plans[i].levels.size(); level++) {
+				// rows are tightly packed, for block formats that means whole rows of blocks
+				VkBufferImageCopy region{};
+				region.bufferOffset = plans[i].levels[level].offset;
+				region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+				region.imageExtent = { plans[i].levels[level].width, plans[i].levels[level].height, 1 };
+				regions.push_back(region);
+			}
+			vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, textureImages[i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<uint32_t>(regions.size()), regions.data());
+		}
+		// images with a generated chain are left to recordMipGeneration, which ends in the same layout
+		std::vector<VkImageMemoryBarrier> readBarriers;
+		for (size_t i = 0; i < plans.size(); i++) {
+			if (plans[i].generateMips) {
+				continue;
+			}
+			auto barrier = barriers[i];
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			readBarriers.push_back(barrier);
+		}
+		if (!readBarriers.empty()) {
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+				static_cast<uint32_t>(readBarriers.size()), readBarriers.data());
+		}
+		endGpuPass(commandBuffer, GPU_UPLOAD_QUERY_SLOT, uploadPass);
+		auto mipPass = beginGpuPass(commandBuffer, GPU_UPLOAD_QUERY_SLOT, "mip generation");
+		for (auto& chain : mipChains) {
+			recordMipGeneration(commandBuffer, chain);
+		}
+		endGpuPass(commandBuffer, GPU_UPLOAD_QUERY_SLOT, mipPass);
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		markGpuSubmission(GPU_UPLOAD_QUERY_SLOT);
+		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			throw std::runtime_error("failed to submit texture upload command buffer");
+		}
+		vkQueueWaitIdle(graphicsQueue);
+		collectGpuPasses(GPU_UPLOAD_QUERY_SLOT);
+		vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingMemory, nullptr);
+		// the plans no longer read from the mappings, the synthetic files would only pile up in the temp directory
+		files.clear();
+		if (syntheticTextures) {
+			for (auto& path : texturePaths) {
+				std::error_code error;
+				std::filesystem::remove(path, error);
+			}
+		}
+		for (auto& chain : mipChains) {
+			releaseMipChain(chain);
+		}
+
+		for (size_t i = 0; i < plans.size(); i++) {
+			ImageViewKey key;
+			key.image = textureImages[i];
+			key.format = plans[i].format;
+			key.levelCount = plans[i].mipLevels;
+			textureViews[i] = acquireImageView(key);
+		}
+
+		// note
+		// a nearest and a linear sampler, materials alternate between the two, both blend between mip levels
+		for (auto filter : { VK_FILTER_NEAREST, VK_FILTER_LINEAR }) {
+			SamplerKey key;
+			key.magFilter = filter;
+			key.minFilter = filter;
+			samplers.push_back(acquireSampler(key));
+		}
+
+		vkDestroyImage = (PFN_vkDestroyImage)vkGetDeviceProcAddr(device, "vkDestroyImage");
+	}
+
+	// note
+	// The compute path needs RGBA8 storage images and a dynamically indexed storage image array, mipgen.comp picks
+	// the level to write by index. Without either every image takes the blit path.
+	void createMipGenerator() {
+		PROFILE_FUNCTION();
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkGetPhysicalDeviceFormatProperties = (PFN_vkGetPhysicalDeviceFormatProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFormatProperties");
+		auto vkCreateDescriptorSetLayout = (PFN_vkCreateDescriptorSetLayout)vkGetDeviceProcAddr(device, "vkCreateDescriptorSetLayout");
+		auto vkCreatePipelineLayout = (PFN_vkCreatePipelineLayout)vkGetDeviceProcAddr(device, "vkCreatePipelineLayout");
+		auto vkCreateComputePipelines = (PFN_vkCreateComputePipelines)vkGetDeviceProcAddr(device, "vkCreateComputePipelines");
+		auto vkCreateDescriptorPool = (PFN_vkCreateDescriptorPool)vkGetDeviceProcAddr(device, "vkCreateDescriptorPool");
+		vkCmdPipelineBarrier = (PFN_vkCmdPipelineBarrier)vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier");
+		vkCmdBlitImage = (PFN_vkCmdBlitImage)vkGetDeviceProcAddr(device, "vkCmdBlitImage");
+		vkCmdDispatch = (PFN_vkCmdDispatch)vkGetDeviceProcAddr(device, "vkCmdDispatch");
+
+		VkPhysicalDeviceFeatures physicalDeviceFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &physicalDeviceFeatures);
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, VK_FORMAT_R8G8B8A8_UNORM, &formatProperties);
+		computeMips = physicalDeviceFeatures.shaderStorageImageArrayDynamicIndexing &&
+			(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+		std::cout << "Mip generation: " << (computeMips ? "single pass compute for RGBA8 UNORM, blits for other formats" : "blits only, no storage image support")
+			<< std::endl;
+		if (!computeMips) {
+			return;
+		}
+
+		mipShaderModule = createShaderModule(readFile(SHADER_ROOT_DIR"/mipgen.comp.spv"));
+
+		// a storage view per level, the counter of finished workgroups
+		std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+		bindings[0].binding = 0;
+		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		bindings[0].descriptorCount = MAX_COMPUTE_MIP_LEVELS;
+		bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		bindings[1].binding = 1;
+		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[1].descriptorCount = 1;
+		bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+		VkDescriptorSetLayoutCreateInfo layoutInfo{};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+		layoutInfo.pBindings = bindings.data();
+		if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &mipSetLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create mip generation descriptor set layout");
+		}
+
+		auto pushConstantRange = MipPushConstants::range();
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 1;
+		pipelineLayoutInfo.pSetLayouts = &mipSetLayout;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &mipPipelineLayout) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create mip generation pipeline layout");
+		}
+
+		VkPipelineShaderStageCreateInfo stageInfo{};
+		stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		stageInfo.module = mipShaderModule;
+		stageInfo.pName = "main";
+
+		VkComputePipelineCreateInfo pipelineInfo{};
+		pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage = stageInfo;
+		pipelineInfo.layout = mipPipelineLayout;
+		if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &mipPipeline) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create mip generation pipeline");
+		}
+
+		// sets are freed once their image is done, the loader generates at most one chain per material at once
+		std::array<VkDescriptorPoolSize, 2> poolSizes{};
+		poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		poolSizes[0].descriptorCount = MAX_COMPUTE_MIP_LEVELS * MATERIAL_TEXTURE_COUNT;
+		poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		poolSizes[1].descriptorCount = MATERIAL_TEXTURE_COUNT;
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+		poolInfo.pPoolSizes = poolSizes.data();
+		poolInfo.maxSets = MATERIAL_TEXTURE_COUNT;
+		if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &mipDescriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create mip generation descriptor pool");
+		}
+
+		// the last workgroup of every dispatch sets the counter back to zero, it starts out there
+		createDeviceLocalBuffer(sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, [](char* dst) {
+			memset(dst, 0, sizeof(uint32_t));
+		}, mipCounterBuffer, mipCounterMemory);
+		vkDestroyDescriptorPool = (PFN_vkDestroyDescriptorPool)vkGetDeviceProcAddr(device, "vkDestroyDescriptorPool");
+	}
+
+	// Compute for RGBA8 UNORM chains a single dispatch covers, blits for the rest. sRGB averages would need the
+	// texels converted by hand, storage images can't be sRGB.
+	MipGenerationPath chooseMipGenerationPath(VkFormat format, uint32_t width, uint32_t height) {
+		auto vkGetPhysicalDeviceFormatProperties = (PFN_vkGetPhysicalDeviceFormatProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFormatProperties");
+
+		if (computeMips && format == VK_FORMAT_R8G8B8A8_UNORM && std::max(width, height) <= MAX_COMPUTE_MIP_EXTENT) {
+			return MipGenerationPath::Compute;
+		}
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+		VkFormatFeatureFlags required = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+		if ((formatProperties.optimalTilingFeatures & required) != required) {
+			throw std::runtime_error("failed to find a way to generate mips for texture format " + std::to_string(format));
+		}
+		return MipGenerationPath::Blit;
+	}
+
+	// note
+	// The compute path binds a storage view of every level, cached like any other view. Levels past the image's
+	// last are never stored to, their descriptors repeat the last view so the whole array is valid.
+	void prepareMipChain(MipChainImage& chain) {
+		auto vkAllocateDescriptorSets = (PFN_vkAllocateDescriptorSets)vkGetDeviceProcAddr(device, "vkAllocateDescriptorSets");
+		vkUpdateDescriptorSets = (PFN_vkUpdateDescriptorSets)vkGetDeviceProcAddr(device, "vkUpdateDescriptorSets");
+
+		if (chain.path != MipGenerationPath::Compute) {
+			return;
+		}
+		chain.levelViews.resize(chain.levelCount);
+		for (uint32_t level = 0; level < chain.levelCount; level++) {
+			ImageViewKey key;
+			key.image = chain.image;
+			key.format = chain.format;
+			key.baseMipLevel = level;
+			key.levelCount = 1;
+			chain.levelViews[level] = acquireImageView(key);
+		}
+
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = mipDescriptorPool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &mipSetLayout;
+		if (vkAllocateDescriptorSets(device, &allocInfo, &chain.descriptorSet) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate mip generation descriptor set");
+		}
+
+		std::array<VkDescriptorImageInfo, MAX_COMPUTE_MIP_LEVELS> imageInfos{};
+		for (uint32_t level = 0; level < MAX_COMPUTE_MIP_LEVELS; level++) {
+			imageInfos[level].imageView = chain.levelViews[std::min(level, chain.levelCount - 1)];
+			imageInfos[level].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+		}
+		VkDescriptorBufferInfo counterInfo{};
+		counterInfo.buffer = mipCounterBuffer;
+		counterInfo.offset = 0;
+		counterInfo.range = VK_WHOLE_SIZE;
+
+		std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+		descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[0].dstSet = chain.descriptorSet;
+		descriptorWrites[0].dstBinding = 0;
+		descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		descriptorWrites[0].descriptorCount = MAX_COMPUTE_MIP_LEVELS;
+		descriptorWrites[0].pImageInfo = imageInfos.data();
+		descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[1].dstSet = chain.descriptorSet;
+		descriptorWrites[1].dstBinding = 1;
+		descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorWrites[1].descriptorCount = 1;
+		descriptorWrites[1].pBufferInfo = &counterInfo;
+		vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+	}
+
+	// once the command buffer that generated the chain has completed, the views stay in the cache with the image
+	void releaseMipChain(MipChainImage& chain) {
+		auto vkFreeDescriptorSets = (PFN_vkFreeDescriptorSets)vkGetDeviceProcAddr(device, "vkFreeDescriptorSets");
+
+		chain.levelViews.clear();
+		if (chain.descriptorSet) {
+			vkFreeDescriptorSets(device, mipDescriptorPool, 1, &chain.descriptorSet);
+			chain.descriptorSet = nullptr;
+		}
+	}
+
+	// note
+	// Expects every level in TRANSFER_DST_OPTIMAL with level 0 written by a transfer, and leaves every level in
+	// SHADER_READ_ONLY_OPTIMAL, visible to fragment shaders.
+	void recordMipGeneration(VkCommandBuffer commandBuffer, const MipChainImage& chain) {
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = chain.image;
+
+		if (chain.path == MipGenerationPath::Compute) {
+			// level 0 is read and the rest written through storage views, all in the general layout
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, chain.levelCount, 0, 1 };
+			// the counter was last set back by the previous dispatch
+			VkBufferMemoryBarrier counterBarrier{};
+			counterBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			counterBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			counterBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			counterBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			counterBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			counterBarrier.buffer = mipCounterBuffer;
+			counterBarrier.offset = 0;
+			counterBarrier.size = VK_WHOLE_SIZE;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				0, 0, nullptr, 1, &counterBarrier, 1, &barrier);
+
+			uint32_t groupsX = (chain.width + MIP_GENERATION_TILE_SIZE - 1) / MIP_GENERATION_TILE_SIZE;
+			uint32_t groupsY = (chain.height + MIP_GENERATION_TILE_SIZE - 1) / MIP_GENERATION_TILE_SIZE;
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mipPipeline);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mipPipelineLayout, 0, 1, &chain.descriptorSet, 0, nullptr);
+			MipPushConstants::push(vkCmdPushConstants, commandBuffer, mipPipelineLayout, { chain.levelCount, groupsX * groupsY });
+			vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+
+			barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+			return;
+		}
+
+		// each level is blitted from the one above, which turns into a transfer source once it is written
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		for (uint32_t level = 1; level < chain.levelCount; level++) {
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 1, 0, 1 };
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+			VkImageBlit blit{};
+			blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1 };
+			blit.srcOffsets[1] = { int32_t(std::max(chain.width >> (level - 1), 1u)), int32_t(std::max(chain.height >> (level - 1), 1u)), 1 };
+			blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+			blit.dstOffsets[1] = { int32_t(std::max(chain.width >> level, 1u)), int32_t(std::max(chain.height >> level, 1u)), 1 };
+			vkCmdBlitImage(commandBuffer, chain.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, chain.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+		}
+
+		// the last level is still a transfer destination, every other one a source
+		std::array<VkImageMemoryBarrier, 2> finalBarriers = { barrier, barrier };
+		finalBarriers[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		finalBarriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		finalBarriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		finalBarriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		finalBarriers[0].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, chain.levelCount - 1, 1, 0, 1 };
+		finalBarriers[1].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		finalBarriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		finalBarriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		finalBarriers[1].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		finalBarriers[1].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, chain.levelCount - 1, 0, 1 };
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+			chain.levelCount > 1 ? 2 : 1, finalBarriers.data());
+	}
+
+	// note
+	// Shared views and samplers, callers never destroy them. Safe to call from any thread once the device exists.
+	VkImageView acquireImageView(const ImageViewKey& key) {
+		return imageViewCache.acquire(key, [&](const ImageViewKey& missing) {
+			auto viewInfo = imageViewCreateInfo(missing);
+			VkImageView view = nullptr;
+			if (vkCreateImageView(device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create image view");
+			}
+			return view;
+		});
+	}
+
+	VkSampler acquireSampler(const SamplerKey& key) {
+		return samplerCache.acquire(key, [&](const SamplerKey& missing) {
+			auto samplerInfo = samplerCreateInfo(missing);
+			VkSampler sampler = nullptr;
+			if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create sampler");
+			}
+			return sampler;
+		});
+	}
+
+	// note
+	// A query pool per frame slot and one for the texture upload. A family whose timestampValidBits is zero
+	// cannot time anything, then there are no pools and every pass goes untimed.
+	void createGpuProfiler() {
+		PROFILE_FUNCTION();
+		auto vkGetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties");
+		auto vkGetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+		auto vkCreateQueryPool = (PFN_vkCreateQueryPool)vkGetDeviceProcAddr(device, "vkCreateQueryPool");
+
+		VkPhysicalDeviceProperties physicalDeviceProperties;
+		vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+		timestampPeriod = physicalDeviceProperties.limits.timestampPeriod;
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilyProps(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilyProps.data());
+		timestampValidBits = queueFamilyProps[queueFamilyIndices.graphicsFamily.value()].timestampValidBits;
+		if (timestampValidBits == 0) {
+			std::cout << "GPU profiler: the graphics queue writes no timestamps, passes are not timed" << std::endl;
+			return;
+		}
+
+		VkQueryPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		poolInfo.queryCount = 2 * GPU_PROFILER_MAX_PASSES;
+		gpuQuerySlots.resize(GPU_UPLOAD_QUERY_SLOT + 1);
+		for (auto& slot : gpuQuerySlots) {
+			if (vkCreateQueryPool(device, &poolInfo, nullptr, &slot.pool) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create timestamp query pool");
+			}
+		}
+		vkDestroyQueryPool = (PFN_vkDestroyQueryPool)vkGetDeviceProcAddr(device, "vkDestroyQueryPool");
+		vkCmdResetQueryPool = (PFN_vkCmdResetQueryPool)vkGetDeviceProcAddr(device, "vkCmdResetQueryPool");
+		vkCmdWriteTimestamp = (PFN_vkCmdWriteTimestamp)vkGetDeviceProcAddr(device, "vkCmdWriteTimestamp");
+		vkGetQueryPoolResults = (PFN_vkGetQueryPoolResults)vkGetDeviceProcAddr(device, "vkGetQueryPoolResults");
+		std::cout << "GPU profiler: " << timestampValidBits << " valid timestamp bits, " << timestampPeriod << " ns per tick, "
+			<< (vkCmdWriteTimestamp2 ? "vkCmdWriteTimestamp2" : "vkCmdWriteTimestamp") << std::endl;
+
+		// note
+		// calibration needs both the device's domain and the one steady_clock reads
+		if (!calibratedTimestampsExtension.empty()) {
+			bool khr = calibratedTimestampsExtension == VK_KHR_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+			auto vkGetPhysicalDeviceCalibrateableTimeDomains = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsKHR)vkGetInstanceProcAddr(instance,
+				khr ? "vkGetPhysicalDeviceCalibrateableTimeDomainsKHR" : "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT");
+			uint32_t domainCount = 0;
+			vkGetPhysicalDeviceCalibrateableTimeDomains(physicalDevice, &domainCount, nullptr);
+			std::vector<VkTimeDomainKHR> domains(domainCount);
+			vkGetPhysicalDeviceCalibrateableTimeDomains(physicalDevice, &domainCount, domains.data());
+			bool deviceDomain = std::find(domains.begin(), domains.end(), VK_TIME_DOMAIN_DEVICE_KHR) != domains.end();
+			bool hostDomain = std::find(domains.begin(), domains.end(), HOST_TIME_DOMAIN) != domains.end();
+			if (deviceDomain && hostDomain) {
+				vkGetCalibratedTimestamps = (PFN_vkGetCalibratedTimestampsKHR)vkGetDeviceProcAddr(device, khr ? "vkGetCalibratedTimestampsKHR" : "vkGetCalibratedTimestampsEXT");
+			}
+		}
+		if (!vkGetCalibratedTimestamps) {
+			std::cout << "GPU timeline: no calibrated timestamps against the host clock, GPU passes stay out of the trace" << std::endl;
+			return;
+		}
+		calibrateGpuClock();
+		gpuTrack = profiler().addTrack("GPU graphics queue");
+		submissionTrack = profiler().addTrack("GPU submissions");
+		std::cout << "GPU timeline: " << calibratedTimestampsExtension << ", " << gpuCalibration.maxDeviation / 1e3 << " us max deviation" << std::endl;
+	}
+
+	// note
+	// A device and a host timestamp taken as close together as the driver manages. Redone for every collected
+	// slot, so drift between the two clocks never adds up.
+	void calibrateGpuClock() {
+		std::array<VkCalibratedTimestampInfoKHR, 2> infos{};
+		infos[0].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR;
+		infos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_KHR;
+		infos[1].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR;
+		infos[1].timeDomain = HOST_TIME_DOMAIN;
+		std::array<uint64_t, 2> timestamps{};
+		uint64_t maxDeviation = 0;
+		if (vkGetCalibratedTimestamps(device, static_cast<uint32_t>(infos.size()), infos.data(), timestamps.data(), &maxDeviation) == VK_SUCCESS) {
+			gpuCalibration = { timestamps[0], hostTimeToProfiler(timestamps[1]), maxDeviation };
+		}
+	}
+
+	uint64_t timestampMask() const {
+		return timestampValidBits >= 64 ? ~0ull : (1ull << timestampValidBits) - 1;
+	}
+
+	// ticks may lie before or after the calibration, the difference is taken modulo the valid bits and read as signed
+	uint64_t gpuTimeToProfiler(uint64_t ticks) const {
+		auto mask = timestampMask();
+		auto delta = (ticks - gpuCalibration.gpuTicks) & mask;
+		auto signedDelta = delta > mask / 2 ? -static_cast<int64_t>(mask - delta) - 1 : static_cast<int64_t>(delta);
+		auto time = static_cast<int64_t>(gpuCalibration.cpuTime) + static_cast<int64_t>(std::llround(signedDelta * double(timestampPeriod)));
+		return static_cast<uint64_t>(std::max<int64_t>(time, 0));
+	}
+
+	// note
+	// Called right before a slot's command buffer goes to the queue. The flow starts inside the caller's scope.
+	void markGpuSubmission(uint32_t slot) {
+		if (gpuQuerySlots.empty()) {
+			return;
+		}
+		auto& querySlot = gpuQuerySlots[slot];
+		querySlot.submission = ++submissionCount;
+		querySlot.submitTime = profiler().now();
+		PROFILE_FLOW_START("submission", querySlot.submission);
+	}
+
+	// note
+	// Puts a collected slot on the CPU trace: every pass on the GPU track, the idle time since the GPU last
+	// finished work, and on the submissions track the wait from vkQueueSubmit to the first pass starting, with an
+	// arrow from the submit to that pass.
+	void traceGpuSlot(const GpuQuerySlot& querySlot, const std::vector<uint64_t>& results) {
+#if ENABLE_PROFILING
+		if (!vkGetCalibratedTimestamps) {
+			return;
+		}
+		calibrateGpuClock();
+		uint64_t first = std::numeric_limits<uint64_t>::max();
+		uint64_t last = 0;
+		for (size_t pass = 0; pass < querySlot.passes.size(); pass++) {
+			const uint64_t* begin = &results[4 * pass];
+			const uint64_t* end = &results[4 * pass + 2];
+			if (!begin[1] || !end[1]) {
+				continue;
+			}
+			auto beginTime = gpuTimeToProfiler(begin[0]);
+			auto endTime = std::max(gpuTimeToProfiler(end[0]), beginTime);
+			profiler().addEvent({ querySlot.passes[pass], beginTime, endTime - beginTime, 0, gpuTrack, ProfileEventType::Scope });
+			first = std::min(first, beginTime);
+			last = std::max(last, endTime);
+		}
+		if (first > last) {
+			return;
+		}
+
+		if (gpuIdleSince && first > gpuIdleSince) {
+			profiler().addEvent({ "idle", gpuIdleSince, first - gpuIdleSince, 0, gpuTrack, ProfileEventType::Scope });
+		}
+		gpuIdleSince = std::max(gpuIdleSince, last);
+		if (querySlot.submission) {
+			// the calibration may be off by maxDeviation, a gap below that shows as none
+			auto queued = first > querySlot.submitTime ? first - querySlot.submitTime : 0;
+			profiler().addEvent({ "queued", querySlot.submitTime, queued, 0, submissionTrack, ProfileEventType::Scope });
+			profiler().addEvent({ "submission", first, 0, static_cast<int64_t>(querySlot.submission), gpuTrack, ProfileEventType::FlowEnd });
+			profiler().addEvent({ "submit to execution us", first, 0, static_cast<int64_t>(queued / 1000), submissionTrack, ProfileEventType::Counter });
+		}
+#endif
+	}
+
+	// note
+	// Goes first in a slot's command buffer, outside any render pass. The slot's last results have to be collected.
+	void resetGpuQueries(VkCommandBuffer commandBuffer, uint32_t slot) {
+		if (gpuQuerySlots.empty()) {
+			return;
+		}
+		vkCmdResetQueryPool(commandBuffer, gpuQuerySlots[slot].pool, 0, 2 * GPU_PROFILER_MAX_PASSES);
+		gpuQuerySlots[slot].passes.clear();
+	}
+
+	// the begin timestamp waits for nothing, the end one for everything recorded before it
+	void writeGpuTimestamp(VkCommandBuffer commandBuffer, VkQueryPool pool, uint32_t query, bool end) {
+		if (vkCmdWriteTimestamp2) {
+			vkCmdWriteTimestamp2(commandBuffer, end ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, pool, query);
+		}
+		else {
+			vkCmdWriteTimestamp(commandBuffer, end ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pool, query);
+		}
+	}
+
+	// note
+	// name is kept as a pointer until the slot is collected, pass a string literal
+	uint32_t beginGpuPass(VkCommandBuffer commandBuffer, uint32_t slot, const char* name) {
+		if (gpuQuerySlots.empty() || gpuQuerySlots[slot].passes.size() == GPU_PROFILER_MAX_PASSES) {
+			return GPU_PASS_NONE;
+		}
+		auto& querySlot = gpuQuerySlots[slot];
+		auto pass = static_cast<uint32_t>(querySlot.passes.size());
+		querySlot.passes.push_back(name);
+		writeGpuTimestamp(commandBuffer, querySlot.pool, 2 * pass, false);
+		return pass;
+	}
+
+	void endGpuPass(VkCommandBuffer commandBuffer, uint32_t slot, uint32_t pass) {
+		if (pass == GPU_PASS_NONE) {
+			return;
+		}
+		writeGpuTimestamp(commandBuffer, gpuQuerySlots[slot].pool, 2 * pass + 1, true);
+	}
+
+	// note
+	// Reads what the slot's last submission measured, called once its fence has signalled. WITH_AVAILABILITY
+	// instead of WAIT means this never blocks, a pass whose queries are not available is skipped. Tick
+	// differences are taken modulo the valid bits so a counter that wrapped still gives the right duration.
+	void collectGpuPasses(uint32_t slot) {
+		if (gpuQuerySlots.empty() || gpuQuerySlots[slot].passes.empty()) {
+			return;
+		}
+		auto& querySlot = gpuQuerySlots[slot];
+		auto queryCount = static_cast<uint32_t>(2 * querySlot.passes.size());
+		// a value and its availability per query
+		std::vector<uint64_t> results(2 * queryCount);
+		vkGetQueryPoolResults(device, querySlot.pool, 0, queryCount, results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+		auto mask = timestampMask();
+		for (size_t pass = 0; pass < querySlot.passes.size(); pass++) {
+			const uint64_t* begin = &results[4 * pass];
+			const uint64_t* end = &results[4 * pass + 2];
+			if (!begin[1] || !end[1]) {
+				continue;
+			}
+			auto ticks = (end[0] - begin[0]) & mask;
+			gpuPassStatsFor(querySlot.passes[pass]).add(ticks * double(timestampPeriod) / 1e6);
+		}
+		traceGpuSlot(querySlot, results);
+		querySlot.passes.clear();
+	}
+
+	GpuPassStats& gpuPassStatsFor(const char* name) {
+		for (auto& stats : gpuPassStats) {
+			if (stats.name == name) {
+				return stats;
+			}
+		}
+		gpuPassStats.push_back({ name });
+		return gpuPassStats.back();
+	}
+
+	// note
+	void reportGpuPasses(const std::string& reason) {
+		if (gpuQuerySlots.empty()) {
+			return;
+		}
+		std::cout << "GPU passes after " << reason << ":" << std::endl;
+		for (auto& stats : gpuPassStats) {
+			std::cout << "  " << stats.name << ": " << stats.average() << " ms average, " << stats.minimum() << " min, " << stats.maximum()
+				<< " max over the last " << stats.count() << " of " << stats.total << " runs" << std::endl;
+		}
+	}
+
+	// note
+	// One statistics query per frame slot, around the scene pass. Optional twice over: the device needs
+	// pipelineStatisticsQuery, and ENABLE_PIPELINE_STATISTICS can turn them off. The command counters always run.
+	void createFrameStats() {
+		PROFILE_FUNCTION();
+		auto vkGetPhysicalDeviceFeatures = (PFN_vkGetPhysicalDeviceFeatures)vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures");
+		auto vkCreateQueryPool = (PFN_vkCreateQueryPool)vkGetDeviceProcAddr(device, "vkCreateQueryPool");
+
+		frameStatsSlots.resize(MAX_FRAMES_IN_FLIGHT);
+		VkPhysicalDeviceFeatures physicalDeviceFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &physicalDeviceFeatures);
+		if (!ENABLE_PIPELINE_STATISTICS || !physicalDeviceFeatures.pipelineStatisticsQuery) {
+			std::cout << "Pipeline statistics: off, " << (ENABLE_PIPELINE_STATISTICS ? "the device has no pipelineStatisticsQuery" : "disabled") << std::endl;
+			return;
+		}
+
+		VkQueryPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+		poolInfo.queryCount = 1;
+		poolInfo.pipelineStatistics = PIPELINE_STATISTICS;
+		statisticsPools.resize(MAX_FRAMES_IN_FLIGHT);
+		for (auto& pool : statisticsPools) {
+			if (vkCreateQueryPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+				throw std::runtime_error("failed to create pipeline statistics query pool");
+			}
+		}
+		vkDestroyQueryPool = (PFN_vkDestroyQueryPool)vkGetDeviceProcAddr(device, "vkDestroyQueryPool");
+		vkCmdResetQueryPool = (PFN_vkCmdResetQueryPool)vkGetDeviceProcAddr(device, "vkCmdResetQueryPool");
+		vkCmdBeginQuery = (PFN_vkCmdBeginQuery)vkGetDeviceProcAddr(device, "vkCmdBeginQuery");
+		vkCmdEndQuery = (PFN_vkCmdEndQuery)vkGetDeviceProcAddr(device, "vkCmdEndQuery");
+		vkGetQueryPoolResults = (PFN_vkGetQueryPoolResults)vkGetDeviceProcAddr(device, "vkGetQueryPoolResults");
+		std::cout << "Pipeline statistics: on" << std::endl;
+	}
+
+	// note
+	// Everything counted from here to finishFrameStats belongs to the frame, the uploads before the first frame
+	// are dropped with the reset.
+	void beginFrameStats(VkCommandBuffer commandBuffer, uint32_t slot) {
+		commandCounters = {};
+		if (!statisticsPools.empty()) {
+			vkCmdResetQueryPool(commandBuffer, statisticsPools[slot], 0, 1);
+		}
+	}
+
+	void finishFrameStats(uint32_t slot) {
+		frameStatsSlots[slot] = { frameCount, commandCounters, std::nullopt };
+		PROFILE_COUNTER("draws", commandCounters.draws);
+		PROFILE_COUNTER("binds", commandCounters.pipelineBinds + commandCounters.descriptorBinds + commandCounters.bufferBinds);
+		PROFILE_COUNTER("barriers", commandCounters.barriers);
+		PROFILE_COUNTER("descriptor updates", commandCounters.descriptorUpdates);
+	}
+
+	// note
+	// Completes the stats of the frame the slot last ran, once its fence has signalled. Like the timestamps the
+	// query is read WITH_AVAILABILITY, a frame whose result is not there keeps an empty pipeline.
+	void collectFrameStats(uint32_t slot) {
+		auto& stats = frameStatsSlots[slot];
+		if (stats.frame == 0) {
+			return;
+		}
+		if (!statisticsPools.empty()) {
+			// the five counts and the availability
+			std::array<uint64_t, 6> results{};
+			vkGetQueryPoolResults(device, statisticsPools[slot], 0, 1, sizeof(results), results.data(), sizeof(results),
+				VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+			if (results[5]) {
+				PipelineStatistics pipeline;
+				std::memcpy(&pipeline, results.data(), sizeof(pipeline));
+				stats.pipeline = pipeline;
+				PROFILE_COUNTER("fragment invocations", pipeline.fragmentShaderInvocations);
+			}
+		}
+		frameStatsHistory.push_back(stats);
+		if (frameStatsHistory.size() > FRAME_STATS_HISTORY) {
+			frameStatsHistory.pop_front();
+		}
+		stats.frame = 0;
+	}
+
+	// note
+	// The latest frame and the average over the history. Overdraw is fragment invocations per pixel of the swap
+	// chain, binds per draw shows state thrash.
+	void reportFrameStats(const std::string& reason) {
+		if (frameStatsHistory.empty()) {
+			return;
+		}
+		CommandCounters sum;
+		PipelineStatistics pipelineSum;
+		uint64_t pipelineFrames = 0;
+		for (auto& stats : frameStatsHistory) {
+			sum.draws += stats.commands.draws;
+			sum.dispatches += stats.commands.dispatches;
+			sum.pipelineBinds += stats.commands.pipelineBinds;
+			sum.descriptorBinds += stats.commands.descriptorBinds;
+			sum.bufferBinds += stats.commands.bufferBinds;
+			sum.barriers += stats.commands.barriers;
+			sum.descriptorUpdates += stats.commands.descriptorUpdates;
+			if (stats.pipeline) {
+				pipelineSum.inputAssemblyVertices += stats.pipeline->inputAssemblyVertices;
+				pipelineSum.vertexShaderInvocations += stats.pipeline->vertexShaderInvocations;
+				pipelineSum.clippingInvocations += stats.pipeline->clippingInvocations;
+				pipelineSum.clippingPrimitives += stats.pipeline->clippingPrimitives;
+				pipelineSum.fragmentShaderInvocations += stats.pipeline->fragmentShaderInvocations;
+				pipelineFrames++;
+			}
+		}
+		double frames = static_cast<double>(frameStatsHistory.size());
+		auto& latest = frameStatsHistory.back();
+		std::cout << "Frame stats after " << reason << ", frame " << latest.frame << " and the average of the last " << frameStatsHistory.size() << ":" << std::endl;
+		std::cout << "  draws " << latest.commands.draws << " (" << sum.draws / frames << "), dispatches " << latest.commands.dispatches << " (" << sum.dispatches / frames
+			<< "), barriers " << latest.commands.barriers << " (" << sum.barriers / frames << "), descriptor updates " << latest.commands.descriptorUpdates
+			<< " (" << sum.descriptorUpdates / frames << ")" << std::endl;
+		std::cout << "  binds: pipeline " << latest.commands.pipelineBinds << " (" << sum.pipelineBinds / frames << "), descriptor sets " << latest.commands.descriptorBinds
+			<< " (" << sum.descriptorBinds / frames << "), buffers " << latest.commands.bufferBinds << " (" << sum.bufferBinds / frames << "), "
+			<< double(sum.pipelineBinds + sum.descriptorBinds + sum.bufferBinds) / std::max<uint64_t>(sum.draws, 1) << " per draw" << std::endl;
+		if (pipelineFrames) {
+			auto pixels = double(swapChainExtent.width) * swapChainExtent.height;
+			std::cout << "  pipeline: " << pipelineSum.inputAssemblyVertices / pipelineFrames << " vertices, " << pipelineSum.vertexShaderInvocations / pipelineFrames
+				<< " vertex invocations, " << pipelineSum.clippingInvocations / pipelineFrames << " primitives clipped to " << pipelineSum.clippingPrimitives / pipelineFrames
+				<< ", " << pipelineSum.fragmentShaderInvocations / pipelineFrames << " fragment invocations, "
+				<< pipelineSum.fragmentShaderInvocations / pipelineFrames / pixels << "x overdraw" << std::endl;
+		}
+	}
+
+	// note
+	// The history as CSV, one frame per row, pipeline columns empty where the frame has none.
+	void dumpFrameStats(const std::string& path) {
+		std::ofstream file(path);
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to open frame stats file");
+		}
+		file << "frame,draws,dispatches,pipelineBinds,descriptorBinds,bufferBinds,barriers,descriptorUpdates,"
+			"inputAssemblyVertices,vertexShaderInvocations,clippingInvocations,clippingPrimitives,fragmentShaderInvocations\n";
+		for (auto& stats : frameStatsHistory) {
+			file << stats.frame << "," << stats.commands.draws << "," << stats.commands.dispatches << "," << stats.commands.pipelineBinds << ","
+				<< stats.commands.descriptorBinds << "," << stats.commands.bufferBinds << "," << stats.commands.barriers << "," << stats.commands.descriptorUpdates;
+			if (stats.pipeline) {
+				file << "," << stats.pipeline->inputAssemblyVertices << "," << stats.pipeline->vertexShaderInvocations << "," << stats.pipeline->clippingInvocations
+					<< "," << stats.pipeline->clippingPrimitives << "," << stats.pipeline->fragmentShaderInvocations << "\n";
+			}
+			else {
+				file << ",,,,,\n";
+			}
+		}
+		std::cout << "Frame stats: " << frameStatsHistory.size() << " frames written to " << path << std::endl;
+	}
+
+	// note
+	void reportResourceCaches(const char* reason) {
+		auto viewStats = imageViewCache.stats();
+		auto samplerStats = samplerCache.stats();
+		std::cout << "Resource caches after " << reason << ": "
+			<< imageViewCache.size() << " image views (" << viewStats.hits << " hits, " << viewStats.misses << " misses), "
+			<< samplerCache.size() << " samplers (" << samplerStats.hits << " hits, " << samplerStats.misses << " misses)" << std::endl;
+	}
+
+	// note
+	// What one scope costs with profiling on: two clock reads and a push into the thread's ring, plus a flush under
+	// the profiler's lock whenever the ring fills. The baseline is the same loop without the scope.
+	void benchmarkProfiler() {
+#if ENABLE_PROFILING
+		volatile uint32_t sink = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < PROFILE_BENCHMARK_SCOPES; i++) {
+			sink = sink + i;
+		}
+		auto baselineSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < PROFILE_BENCHMARK_SCOPES; i++) {
+			PROFILE_SCOPE("benchmark scope");
+			sink = sink + i;
+		}
+		auto scopeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "Profiler benchmark (" << PROFILE_BENCHMARK_SCOPES << " scopes): "
+			<< (scopeSeconds - baselineSeconds) / PROFILE_BENCHMARK_SCOPES * 1e9 << " ns per scope" << std::endl;
+#else
+		std::cout << "Profiler benchmark skipped, profiling is compiled out" << std::endl;
+#endif
+	}
+
+	// note
+	// Instance data is rewritten by the CPU every frame, so each frame in flight owns a persistently mapped copy.
+	void createFrameDrawBuffers() {
+		PROFILE_FUNCTION();
+		auto vkMapMemory = (PFN_vkMapMemory)vkGetDeviceProcAddr(device, "vkMapMemory");
+
+		instanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+		instanceMemories.resize(MAX_FRAMES_IN_FLIGHT);
+		mappedInstances.resize(MAX_FRAMES_IN_FLIGHT);
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			void* mapped = nullptr;
+			createBuffer(sizeof(InstanceData) * MAX_DRAW_INSTANCES, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, instanceBuffers[i], instanceMemories[i]);
+			vkMapMemory(device, instanceMemories[i], 0, VK_WHOLE_SIZE, 0, &mapped);
+			mappedInstances[i] = static_cast<InstanceData*>(mapped);
+		}
+	}
+
+	// note
+	// One set per frame in flight naming that frame's instance buffer and every material texture. It is written
+	// once here and bound once per command buffer, draws only push their indices.
+	void createFrameDescriptorSets() {
+		PROFILE_FUNCTION();
+		auto vkCreateDescriptorPool = (PFN_vkCreateDescriptorPool)vkGetDeviceProcAddr(device, "vkCreateDescriptorPool");
+		auto vkAllocateDescriptorSets = (PFN_vkAllocateDescriptorSets)vkGetDeviceProcAddr(device, "vkAllocateDescriptorSets");
+		vkUpdateDescriptorSets = (PFN_vkUpdateDescriptorSets)vkGetDeviceProcAddr(device, "vkUpdateDescriptorSets");
+
+		std::array<VkDescriptorPoolSize, 2> poolSizes{};
+		poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		poolSizes[0].descriptorCount = MAX_FRAMES_IN_FLIGHT;
+		poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		poolSizes[1].descriptorCount = MATERIAL_TEXTURE_COUNT * MAX_FRAMES_IN_FLIGHT;
+
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+		poolInfo.pPoolSizes = poolSizes.data();
+		poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+		if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &frameDescriptorPool) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create frame descriptor pool");
+		}
+
+		std::vector<VkDescriptorSetLayout> setLayouts(MAX_FRAMES_IN_FLIGHT, frameSetLayout);
+		frameDescriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = frameDescriptorPool;
+		allocInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+		allocInfo.pSetLayouts = setLayouts.data();
+		if (vkAllocateDescriptorSets(device, &allocInfo, frameDescriptorSets.data()) != VK_SUCCESS) {
+			throw std::runtime_error("failed to allocate frame descriptor sets");
+		}
+
+		// material i is loaded texture i modulo their count, read with the nearest and linear sampler in turn
+		std::vector<VkDescriptorImageInfo> imageInfos(MATERIAL_TEXTURE_COUNT);
+		for (uint32_t i = 0; i < MATERIAL_TEXTURE_COUNT; i++) {
+			imageInfos[i].sampler = samplers[i % samplers.size()];
+			imageInfos[i].imageView = textureViews[i % textureViews.size()];
+			imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		}
+		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+			VkDescriptorBufferInfo bufferInfo{};
+			bufferInfo.buffer = instanceBuffers[i];
+			bufferInfo.offset = 0;
+			bufferInfo.range = VK_WHOLE_SIZE;
+
+			std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+			descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[0].dstSet = frameDescriptorSets[i];
+			descriptorWrites[0].dstBinding = 0;
+			descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			descriptorWrites[0].descriptorCount = 1;
+			descriptorWrites[0].pBufferInfo = &bufferInfo;
+			descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[1].dstSet = frameDescriptorSets[i];
+			descriptorWrites[1].dstBinding = 1;
+			descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			descriptorWrites[1].descriptorCount = MATERIAL_TEXTURE_COUNT;
+			descriptorWrites[1].pImageInfo = imageInfos.data();
+			vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+		}
+
+		vkDestroyDescriptorPool = (PFN_vkDestroyDescriptorPool)vkGetDeviceProcAddr(device, "vkDestroyDescriptorPool");
+	}
+
+	// note
+	// A grid of spheres over the whole window, neighbouring cells alternating between the levels of detail and each
+	// with a material of its own, large enough to see the textures and their mip levels.
+	void createScene() {
+		PROFILE_FUNCTION();
+		float cellSize = 2.0f / SCENE_GRID_SIZE;
+		for (uint32_t y = 0; y < SCENE_GRID_SIZE; y++) {
+			for (uint32_t x = 0; x < SCENE_GRID_SIZE; x++) {
+				DrawItem item;
+				item.mesh = (x + y) % MESH_POOL_LODS;
+				item.material = (y * SCENE_GRID_SIZE + x) % MATERIAL_TEXTURE_COUNT;
+				item.instance.offsetScale = glm::vec4(-1.0f + (x + 0.5f) * cellSize, -1.0f + (y + 0.5f) * cellSize, cellSize * 0.45f, 0.0f);
+				item.instance.color = glm::vec4(1.0f);
+				sceneDraws.push_back(item);
+			}
+		}
+	}
+
+	// note
+	// The frame's set is bound once for the whole pass. Per draw only its constants change, pushed right before the draw.
+	void recordPushConstantDraws(VkCommandBuffer commandBuffer, VkPipeline pipeline, VkDescriptorSet frameSet, const std::vector<DrawItem>& items) {
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &frameSet, 0, nullptr);
+		VkDeviceSize offset = 0;
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &meshPoolVertexBuffer, &offset);
+		vkCmdBindIndexBuffer(commandBuffer, meshPoolIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+		for (uint32_t i = 0; i < items.size(); i++) {
+			auto& range = meshRanges[items[i].mesh];
+			DrawConstants constants = { i, items[i].material, items[i].flags };
+			DrawPushConstants::push(vkCmdPushConstants, commandBuffer, pipelineLayout, constants);
+			vkCmdDrawIndexed(commandBuffer, range.indexCount, 1, range.firstIndex, range.vertexOffset, 0);
+		}
+	}
+
+	void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("failed to begin recording command buffer");
+		}
+		resetGpuQueries(commandBuffer, currentFrame);
+		beginFrameStats(commandBuffer, currentFrame);
+
+		VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
+
+		VkRenderPassBeginInfo renderPassInfo{};
+		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassInfo.renderPass = renderPass;
+		renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+		renderPassInfo.renderArea.offset = { 0, 0 };
+		renderPassInfo.renderArea.extent = swapChainExtent;
+		renderPassInfo.clearValueCount = 1;
+		renderPassInfo.pClearValues = &clearColor;
+
+		auto scenePass = beginGpuPass(commandBuffer, currentFrame, "scene pass");
+		if (!statisticsPools.empty()) {
+			vkCmdBeginQuery(commandBuffer, statisticsPools[currentFrame], 0, 0);
+		}
+		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		// note
+		recordPushConstantDraws(commandBuffer, graphicsPipeline, frameDescriptorSets[currentFrame], sceneDraws);
+		vkCmdEndRenderPass(commandBuffer);
+		if (!statisticsPools.empty()) {
+			vkCmdEndQuery(commandBuffer, statisticsPools[currentFrame], 0);
+		}
+		endGpuPass(commandBuffer, currentFrame, scenePass);
+		finishFrameStats(currentFrame);
+
+		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("failed to record command buffer");
+		}
+	}
+
+	void drawFrame() {
+		PROFILE_FUNCTION();
+		{
+			PROFILE_SCOPE("vkWaitForFences");
+			vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+		}
+		// note
+		// the slot's last frame is done, its queries with it
+		collectGpuPasses(currentFrame);
+		collectFrameStats(currentFrame);
+		if (++frameCount % GPU_PROFILER_REPORT_INTERVAL == 0) {
+			reportGpuPasses(std::to_string(frameCount) + " frames");
+			reportFrameStats(std::to_string(frameCount) + " frames");
+		}
+
+		uint32_t imageIndex = 0;
+		VkResult result;
+		{
+			PROFILE_SCOPE("vkAcquireNextImageKHR");
+			result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		}
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to acquire swap chain image");
+		}
+		vkResetFences(device, 1, &inFlightFences[currentFrame]);
+
+		// note
+		{
+			PROFILE_SCOPE("recordCommandBuffer");
+			for (size_t i = 0; i < sceneDraws.size(); i++) {
+				mappedInstances[currentFrame][i] = sceneDraws[i].instance;
+			}
+
+			vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+			recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+		}
+
+		VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &imageAvailableSemaphores[currentFrame];
+		submitInfo.pWaitDstStageMask = &waitStage;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &renderFinishedSemaphores[imageIndex];
+		{
+			PROFILE_SCOPE("vkQueueSubmit");
+			markGpuSubmission(currentFrame);
+			if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
+				throw std::runtime_error("failed to submit draw command buffer");
+			}
+		}
+
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinishedSemaphores[imageIndex];
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &swapChain;
+		presentInfo.pImageIndices = &imageIndex;
+		{
+			PROFILE_SCOPE("vkQueuePresentKHR");
+			result = vkQueuePresentKHR(presentQueue, &presentInfo);
+		}
+		if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+			throw std::runtime_error("failed to present swap chain image");
+		}
+
+		currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	}
+
+	VkShaderModule createShaderModule(const std::vector<char>& code) {
+		VkShaderModuleCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		createInfo.codeSize = code.size();
+		createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+		auto vkCreateShaderModule = (PFN_vkCreateShaderModule)vkGetInstanceProcAddr(instance, "vkCreateShaderModule");
+		VkShaderModule shaderModule;
+		if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create shader module");
+		}
+
+		return shaderModule;
+	}
+
+
+	static std::vector<char> readFile(const std::string& filename) {
+		std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+		if (!file.is_open()) {
+			throw std::runtime_error("failed to open file");
+		}
+
+		size_t fileSize = (size_t)file.tellg();
+		std::vector<char> buffer(fileSize);
+
+		file.seekg(0);
+		file.read(buffer.data(), fileSize);
+
+		file.close();
+		return buffer;
+	}
+
+
+};
+
+int main(int argc, char** argv) {
+	HelloTriangleApplication app;
+	// note
+	app.texturePaths.assign(argv + 1, argv + argc);
+
+	try {
+		app.run();
+	}
+	catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file